@@ -5,77 +5,174 @@
 #pragma once
 
 #include <GameSparks/gsstl.h>
+#include <GameSparks/GSProfiler.h>
 
-#undef GS_USE_LEAK_DETECTOR
+//! define GS_USE_LEAK_DETECTOR (for the SDK and everything that includes it, it changes System::Bytes) to count the
+//! instances of the SDK classes, the cJSON allocations and the System::Bytes buffers, see AllocationProfiler below.
 //#define GS_USE_LEAK_DETECTOR 1
 
 #if defined(GS_USE_LEAK_DETECTOR) && !defined(DOXYGEN)
+#if !GS_USE_PROFILER
+#	error "GS_USE_LEAK_DETECTOR attributes allocations to GSProfiler scopes and needs GS_USE_PROFILER"
+#endif
+#include <atomic>
+#include <cstdint>
+#include <GameSparks/GSLinking.h>
+
 namespace GameSparks {
-    namespace Util
-    {
-        /*!
-         * Helper class that uses RIIA to detect leaks. this can be enabled by setting GS_USE_LEAK_DETECTOR to 1
-         * (see above)
-         */
-        namespace LeakDetector
-        {
-            struct LeakedObjectDetectorBase
-            {
-                LeakedObjectDetectorBase()
-                {
-                    getAliveObjects().insert(this);
-                }
-                
-                virtual ~LeakedObjectDetectorBase()
-                {
-                    getAliveObjects().erase(this);
-                }
-                
-                virtual const char* getLeakedObjectClassName() const = 0;
-                
-                typedef gsstl::set<LeakedObjectDetectorBase*> AliveObjects;
-                static AliveObjects& getAliveObjects()
-                {
-                    static AliveObjects aliveObjects;
-                    return aliveObjects;
-                }
-                
-                static gsstl::string getLeakedClasses()
-                {
-                    gsstl::string ret;
-                    
-                    for(AliveObjects::iterator i=getAliveObjects().begin(); i!=getAliveObjects().end(); ++i)
-                    {
-                        ret += gsstl::string("Leaked: ") + (*i)->getLeakedObjectClassName() + "\n";
-                    }
-                    
-                    return ret;
-                }
-                
-                static void Cleanup()
-                {
-                    getAliveObjects().clear();
-                }
-            };
-            
-            template <typename OwnerClass>
-            struct LeakedObjectDetector : public LeakedObjectDetectorBase
-            {
-                virtual const char* getLeakedObjectClassName() const
-                {
-                    return OwnerClass::getLeakedObjectClassName();
-                }
-            };
-        }
-    }
+	namespace Util
+	{
+		/*!
+		 * Per type allocation counters: allocations, frees and bytes since the last Reset(), the live count and its peak.
+		 * Every class that declares GS_LEAK_DETECTOR is a type, so are the cJSON nodes and strings ("cJSON") and the
+		 * System::Bytes buffers ("System::Bytes").
+		 *
+		 * Every allocation is also attributed to the innermost GSProfiler scope (GS_CODE_TIMING_ASSERT() or
+		 * GS_PROFILE_SCOPE) active on the allocating thread. GetCallSites() lists the scopes that allocate the most,
+		 * i.e. where GSData copies or RT packet buffers are made.
+		 *
+		 * All counters are atomics updated without a lock, so the profiler can stay on in soak tests. Call Reset() when
+		 * a session starts and Report() or WriteJSON() when it ends.
+		 */
+		class GS_API AllocationProfiler
+		{
+			public:
+				/// the counters of one type. Registered on first use and never freed.
+				struct Type
+				{
+					Type(const char* name);
+
+					const char* name;
+					int index;
+					std::atomic<uint64_t> allocations;
+					std::atomic<uint64_t> frees;
+					std::atomic<uint64_t> bytes;
+					std::atomic<int64_t> live;
+					std::atomic<int64_t> liveBytes;
+					std::atomic<int64_t> peak;
+					Type* next;
+				};
+
+				struct TypeStats
+				{
+					gsstl::string name;
+					uint64_t allocations;
+					uint64_t frees;
+					uint64_t bytes;
+					double allocationsPerSecond; ///< since the last Reset()
+					int64_t live;
+					int64_t liveBytes;
+					int64_t peak;
+				};
+
+				struct CallSiteStats
+				{
+					gsstl::string scope; ///< the GSProfiler scope or "(no scope)"
+					gsstl::string type;
+					uint64_t allocations;
+					uint64_t bytes;
+				};
+
+				static void OnAllocate(Type& type, size_t bytes);
+				static void OnFree(Type& type, size_t bytes);
+
+				/// clears the allocation, free and byte counters and the call sites. Live counts are kept, peaks restart from them.
+				static void Reset();
+
+				/// all types that allocated since the last Reset() or still have live instances, most allocations first
+				static gsstl::vector<TypeStats> GetTypes();
+
+				/// the scope and type pairs with the most allocations since the last Reset()
+				static gsstl::vector<CallSiteStats> GetCallSites(size_t count = 20);
+
+				/// one "Leaked: <class> (<count>)" line for every type with live instances
+				static gsstl::string GetLeakedClasses();
+
+				/// GetTypes() and GetCallSites() as a text table
+				static gsstl::string Report(size_t callSites = 20);
+
+				/// GetTypes() and GetCallSites() as a json object: {"seconds", "types": [...], "callSites": [...]}
+				static gsstl::string ToJSON(size_t callSites = 20);
+				static bool WriteJSON(const gsstl::string& path, size_t callSites = 20);
+		};
+
+		/// an std allocator that counts into the AllocationProfiler type named Tag::Name()
+		template <typename T, typename Tag>
+		struct CountingAllocator
+		{
+			typedef T value_type;
+
+			CountingAllocator() {}
+			template <typename U> CountingAllocator(const CountingAllocator<U, Tag>&) {}
+			template <typename U> struct rebind { typedef CountingAllocator<U, Tag> other; };
+
+			T* allocate(size_t n)
+			{
+				AllocationProfiler::OnAllocate(GetType(), n * sizeof(T));
+				return static_cast<T*>(::operator new(n * sizeof(T)));
+			}
+
+			void deallocate(T* p, size_t n)
+			{
+				AllocationProfiler::OnFree(GetType(), n * sizeof(T));
+				::operator delete(p);
+			}
+
+			static AllocationProfiler::Type& GetType()
+			{
+				static AllocationProfiler::Type type(Tag::Name());
+				return type;
+			}
+		};
+
+		template <typename T, typename U, typename Tag>
+		inline bool operator == (const CountingAllocator<T, Tag>&, const CountingAllocator<U, Tag>&) { return true; }
+
+		template <typename T, typename U, typename Tag>
+		inline bool operator != (const CountingAllocator<T, Tag>&, const CountingAllocator<U, Tag>&) { return false; }
+
+		namespace LeakDetector
+		{
+			/// the member GS_LEAK_DETECTOR adds to OwnerClass, counts its instances
+			template <typename OwnerClass>
+			struct LeakedObjectDetector
+			{
+				LeakedObjectDetector()
+				{
+					AllocationProfiler::OnAllocate(GetType(), sizeof(OwnerClass));
+				}
+
+				LeakedObjectDetector(const LeakedObjectDetector&)
+				{
+					AllocationProfiler::OnAllocate(GetType(), sizeof(OwnerClass));
+				}
+
+				LeakedObjectDetector& operator=(const LeakedObjectDetector&)
+				{
+					return *this;
+				}
+
+				~LeakedObjectDetector()
+				{
+					AllocationProfiler::OnFree(GetType(), sizeof(OwnerClass));
+				}
+
+				static AllocationProfiler::Type& GetType()
+				{
+					static AllocationProfiler::Type type(OwnerClass::getLeakedObjectClassName());
+					return type;
+				}
+			};
+		}
+	}
 }
 
-#   define GS_LEAK_DETECTOR(OwnerClass) \
-        friend struct GameSparks::Util::LeakDetector::LeakedObjectDetector<OwnerClass>; \
-        static const char* getLeakedObjectClassName() { return #OwnerClass; } \
-        GameSparks::Util::LeakDetector::LeakedObjectDetector<OwnerClass> _gs_leak_detector_;
+#	define GS_LEAK_DETECTOR(OwnerClass) \
+		friend struct GameSparks::Util::LeakDetector::LeakedObjectDetector<OwnerClass>; \
+		static const char* getLeakedObjectClassName() { return #OwnerClass; } \
+		GameSparks::Util::LeakDetector::LeakedObjectDetector<OwnerClass> _gs_leak_detector_;
 #else
-#   define GS_LEAK_DETECTOR(OwnerClass)
+#	define GS_LEAK_DETECTOR(OwnerClass)
 #endif /* GS_USE_LEAK_DETECTOR */
 
 //#undef GS_USE_CODE_TIMING_ASSERTS
@@ -146,9 +243,10 @@ namespace GameSparks {
 		};
 	}
 }
-#	define GS_CODE_TIMING_ASSERT() ::GameSparks::Util::CodetimingAssert gsucta_##__line__(__FUNCTION__, __FILE__, __LINE__)
+#	define GS_CODE_TIMING_ASSERT() GS_PROFILE_FUNCTION(); ::GameSparks::Util::CodetimingAssert gsucta_##__line__(__FUNCTION__, __FILE__, __LINE__)
 #else
-#	define GS_CODE_TIMING_ASSERT()
+	// without the asserts, GS_CODE_TIMING_ASSERT() is still a GSProfiler scope (see GSProfiler.h)
+#	define GS_CODE_TIMING_ASSERT() GS_PROFILE_FUNCTION()
 #endif
 
 
@@ -0,0 +1,178 @@
+#ifndef GSProfiler_h__
+#define GSProfiler_h__
+
+#pragma once
+
+#include <GameSparks/gsstl.h>
+#include <GameSparks/GSLinking.h>
+
+//! set GS_USE_PROFILER to 0 to compile the scope timers out completely. They need C++11 (thread_local and atomics).
+#if !defined(GS_USE_PROFILER)
+#	if defined(GS_USE_STD_FUNCTION) && !defined(IW_SDK)
+#		define GS_USE_PROFILER 1
+#	else
+#		define GS_USE_PROFILER 0
+#	endif
+#endif
+
+#if GS_USE_PROFILER && !defined(DOXYGEN)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(GS_BUILDING_MODULE)
+#	include "Stats/Stats.h"
+#endif
+
+namespace GameSparks
+{
+	namespace Util
+	{
+		/*!
+		 * Scoped timers for the hot paths of the SDK.
+		 *
+		 * A scope is declared with GS_PROFILE_SCOPE("name"); GS_CODE_TIMING_ASSERT() declares one named after the
+		 * enclosing function. While the profiler is enabled, every scope records its call count and a latency histogram
+		 * into a buffer owned by the calling thread, so recording never takes a lock. While it is disabled (the default)
+		 * a scope costs a relaxed atomic load.
+		 *
+		 * Inside the Unreal plugin an enabled scope is also a cycle counter of the "GameSparks SDK" stat group, see
+		 * "stat GameSparksSDK" and the console command "GameSparks.Profiler 1|0|dump". Standalone, use ToJSON() for a
+		 * per scope summary and StartTrace()/ToChromeTrace() for a timeline that can be opened in chrome://tracing.
+		 */
+		class GS_API Profiler
+		{
+			public:
+				/// a GS_PROFILE_SCOPE call site. Registered on first use and never freed.
+				struct Site
+				{
+					gsstl::string name;
+					const char* file;
+					int line;
+					int id;
+					#if defined(GS_BUILDING_MODULE) && STATS
+					TStatId statId;
+					#endif
+				};
+
+				/// what Collect() returns for every scope that was entered at least once
+				struct ScopeStats
+				{
+					gsstl::string name;
+					gsstl::string file;
+					int line;
+					uint64_t calls;
+					double totalUs;
+					double meanUs;
+					double p50Us;
+					double p90Us;
+					double p99Us;
+					double maxUs;
+				};
+
+				static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+				/// starts or stops recording. Data recorded so far is kept until Reset().
+				static void SetEnabled(bool value);
+
+				/// clears the counters and the trace of all threads. Samples recorded concurrently may survive the reset.
+				static void Reset();
+
+				/// merges the buffers of all threads, sorted by total time
+				static gsstl::vector<ScopeStats> Collect();
+
+				/// Collect() as a json object: {"scopes": [{"name", "file", "line", "calls", "totalUs", "meanUs", "p50Us", ...}]}
+				static gsstl::string ToJSON();
+
+				/// additionally records every scope as an event into a ring buffer of the given size per thread. Implies SetEnabled(true).
+				static void StartTrace(size_t eventsPerThread = 65536);
+				static void StopTrace();
+
+				/// the recorded events in the chrome trace event format. Call it after StopTrace(), events written concurrently may be torn.
+				static gsstl::string ToChromeTrace();
+
+				/// writes ToJSON() or ToChromeTrace() to path. Returns false if the file could not be written.
+				static bool WriteJSON(const gsstl::string& path);
+				static bool WriteChromeTrace(const gsstl::string& path);
+
+				/// used by GS_PROFILE_SCOPE. With qualify set, the file name is prepended to name ("GS::Update" for Update in GS.cpp).
+				static const Site* RegisterSite(const char* name, const char* file, int line, bool qualify);
+
+				static int64_t Now()
+				{
+					return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				}
+
+				static void Record(const Site* site, int64_t startNs, int64_t endNs);
+
+				/// the innermost scope active on the calling thread or nullptr. Only tracked with GS_USE_LEAK_DETECTOR, where the
+				/// AllocationProfiler attributes every allocation to it (see GSLeakDetector.h).
+				static const Site* CurrentScope();
+
+				/// used by GS_PROFILE_SCOPE with GS_USE_LEAK_DETECTOR. EnterScope() returns the scope to pass to LeaveScope().
+				static const Site* EnterScope(const Site* site);
+				static void LeaveScope(const Site* outer);
+			private:
+				static std::atomic<bool> enabled;
+		};
+
+		/// RAII helper behind GS_PROFILE_SCOPE
+		class ProfileScope
+		{
+			public:
+				explicit ProfileScope(const Profiler::Site* site_)
+				:site(site_)
+				,start(Profiler::IsEnabled() ? Profiler::Now() : 0)
+				#if defined(GS_USE_LEAK_DETECTOR)
+				,outer(Profiler::EnterScope(site_))
+				#endif
+				#if defined(GS_BUILDING_MODULE) && STATS
+				,cycleCounter(start ? site_->statId : TStatId())
+				#endif
+				{
+				}
+
+				~ProfileScope()
+				{
+					if (start)
+					{
+						Profiler::Record(site, start, Profiler::Now());
+					}
+					#if defined(GS_USE_LEAK_DETECTOR)
+					Profiler::LeaveScope(outer);
+					#endif
+				}
+			private:
+				const Profiler::Site* site;
+				int64_t start;
+				#if defined(GS_USE_LEAK_DETECTOR)
+				const Profiler::Site* outer;
+				#endif
+				#if defined(GS_BUILDING_MODULE) && STATS
+				FScopeCycleCounter cycleCounter;
+				#endif
+
+				ProfileScope(const ProfileScope&);
+				ProfileScope& operator=(const ProfileScope&);
+		};
+	}
+}
+
+#	define GS_PROFILER_CAT_(a, b) a##b
+#	define GS_PROFILER_CAT(a, b) GS_PROFILER_CAT_(a, b)
+#	define GS_PROFILER_SITE_(name, qualify) \
+		static const ::GameSparks::Util::Profiler::Site* GS_PROFILER_CAT(gs_profile_site_, __LINE__) = ::GameSparks::Util::Profiler::RegisterSite(name, __FILE__, __LINE__, qualify); \
+		::GameSparks::Util::ProfileScope GS_PROFILER_CAT(gs_profile_scope_, __LINE__)(GS_PROFILER_CAT(gs_profile_site_, __LINE__))
+
+//! times the enclosing scope under the given name (a string literal)
+#	define GS_PROFILE_SCOPE(name) GS_PROFILER_SITE_(name, false)
+
+//! times the enclosing function, named after the function and the file it is defined in
+#	define GS_PROFILE_FUNCTION() GS_PROFILER_SITE_(__FUNCTION__, true)
+#else
+#	define GS_PROFILE_SCOPE(name)
+#	define GS_PROFILE_FUNCTION()
+#endif /* GS_USE_PROFILER */
+
+#endif // GSProfiler_h__
@@ -170,6 +170,8 @@ namespace GameSparks
                 }
 
                 //! set api domain to use. pass empty string to reset to the default. The default is "ws.gamesparks.net"
+                //! A domain including a scheme and port (like "ws://127.0.0.1:8080") is used verbatim as the base of the
+                //! service url, without stage and api key prefix. This is how the SDK is pointed at a local mock backend.
                 void SetApiDomain(const gsstl::string& domain)
                 {
                     m_apiDomain = domain;
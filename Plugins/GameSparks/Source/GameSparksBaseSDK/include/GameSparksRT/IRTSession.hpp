@@ -7,10 +7,32 @@
 #include "System/Bytes.hpp"
 #include "./GameSparksRT.hpp"
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace GameSparks { namespace RT {
 
+	/// Statistics of one stream of the send scheduler, see IRTSession::RegisterStream()
+	struct RTStreamStats
+	{
+		gsstl::string Name;
+		int Priority = 0;
+		float TargetRate = 0; ///< updates per second the stream asked for
+		float Rate = 0; ///< updates per second the scheduler currently allows
+		uint64_t Sent = 0; ///< updates sent
+		uint64_t Dropped = 0; ///< updates replaced by a newer one before they could be sent
+	};
+
+	/// Statistics of the send scheduler, see IRTSession::RegisterStream()
+	struct RTSendSchedulerStats
+	{
+		float RoundTripTime = 0; ///< smoothed round trip time of the pings in seconds, 0 until the first one was answered
+		float Loss = 0; ///< smoothed share of unanswered pings, 0..1
+		float SendRate = 0; ///< bytes per second the scheduler may send
+		gsstl::vector<RTStreamStats> Streams;
+	};
+
 	/*!
 	 * Sessions are created via a GameSparksRTSessionBuilder. IRTSession objects are used to send data
 	 * to the peers. Make sure to call Update() every frame. To listen for session related
@@ -98,6 +120,51 @@ namespace GameSparks { namespace RT {
 			/// </summary>
 			virtual void Update() = 0;
 
+			/// <summary>
+			/// The connection half of Update(): checks the connection and reads the reliable connection.
+			/// Does not invoke the listener callbacks, except IRTSessionListener::OnPacketReceived(), so it can be
+			/// called at a fixed rate from a network thread while DispatchCallbacks() is called from the game loop.
+			/// Stop() must not be called while it runs.
+			/// </summary>
+			virtual void UpdateConnection() = 0;
+
+			/// <summary>
+			/// The callback half of Update(): invokes the listener callbacks of everything received so far
+			/// on the calling thread.
+			/// </summary>
+			virtual void DispatchCallbacks() = 0;
+
+			/// <summary>
+			/// Registers a stream of state updates with the send scheduler. Instead of sending every update, set the
+			/// latest state with SetStreamState(). The scheduler sends it over the fast connection at up to targetRate
+			/// updates per second, paced by a token bucket whose rate follows the round trip time and loss of periodic
+			/// pings. When bandwidth runs short, streams with a higher priority keep their rate and the others are slowed
+			/// down. An update that is replaced before it could be sent is dropped, it is never queued.
+			/// The scheduler runs in Update() or UpdateConnection().
+			/// </summary>
+			/// <param name="name">Shows up in GetSendSchedulerStats()</param>
+			/// <param name="opCode">The opCode the updates are sent with</param>
+			/// <param name="priority">Higher is more important</param>
+			/// <param name="targetRate">Updates per second when bandwidth allows it</param>
+			/// <returns>The id of the stream</returns>
+			virtual int RegisterStream(const gsstl::string& name, int opCode, int priority, float targetRate) = 0;
+
+			/// <summary>
+			/// Removes the stream, a pending update is not sent.
+			/// </summary>
+			virtual void UnregisterStream(int streamId) = 0;
+
+			/// <summary>
+			/// Sets the state to send next with the stream, replacing an update that was not sent yet.
+			/// </summary>
+			/// <param name="targetPlayers">The list of players to send to (empty to send to all)</param>
+			virtual void SetStreamState(int streamId, const RTData& data, const gsstl::vector<int>& targetPlayers) = 0;
+
+			/// <summary>
+			/// Round trip time, loss, send rate and the current rate of every stream.
+			/// </summary>
+			virtual RTSendSchedulerStats GetSendSchedulerStats() const = 0;
+
 
 			virtual ~IRTSession(){}
 		protected:
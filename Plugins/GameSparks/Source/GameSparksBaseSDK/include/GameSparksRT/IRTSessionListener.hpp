@@ -42,6 +42,13 @@ namespace GameSparks { namespace RT {
 			/// <param name="length">The number of bytes in the stream that can be read</param>
 			virtual void OnPacket (const RTPacket& /*packet*/) {}
 
+			/// <summary>
+			/// Executed on the thread that received the packet, before it is queued for OnPacket. Return true to consume the
+			/// packet, OnPacket isn't called for it then. Implementations must be thread safe.
+			/// </summary>
+			/// <param name="packet">The packet, only valid during the call</param>
+			virtual bool OnPacketReceived (const RTPacket& /*packet*/) { return false; }
+
 		protected:
 			virtual ~IRTSessionListener();
 		private:
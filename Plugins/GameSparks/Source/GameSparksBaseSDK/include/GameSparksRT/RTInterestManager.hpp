@@ -0,0 +1,104 @@
+#ifndef _GAMESPARKSRT_RTINTERESTMANAGER_HPP_
+#define _GAMESPARKSRT_RTINTERESTMANAGER_HPP_
+
+#include "./GameSparksRT.hpp"
+#include "./GSLinking.hpp"
+#include "./RTData.hpp"
+#include "../GameSparks/gsstl.h"
+
+#include <cstdint>
+
+namespace GameSparks { namespace RT {
+
+	class IRTSession;
+
+	/*!
+	 * Client side area of interest filtering for state updates that would otherwise be broadcast to the whole room.
+	 *
+	 * The positions of the peers (usually taken from the updates they send) are kept in a uniform grid on the x/y plane.
+	 * An update queued with QueueUpdate() goes to the peers within Settings::NearCells grid cells of its position, and to
+	 * the peers within Settings::FarCells only on every Settings::FarInterval-th Flush(), staggered by peer id so that the
+	 * reduced rate traffic is spread over the flushes. Peers without a known position get every update, nobody disappears
+	 * before their first update arrived.
+	 *
+	 * Flush() groups the queued updates by their target set and sends every group as one packet, so each set is written
+	 * once. The updates are nested in slots 1, 2, ... of the packet RTData, use ReadUpdates() on the receiving side. A set
+	 * that contains every active peer is sent without target list, as a broadcast.
+	 *
+	 * Not thread safe, use it from the thread that sends.
+	 */
+	class GS_API RTInterestManager
+	{
+		public:
+			struct Settings
+			{
+				float CellSize = 4000; ///< edge length of a grid cell, in the units of the positions
+				int NearCells = 1; ///< peers this many cells away or closer get every update
+				int FarCells = 3; ///< peers this many cells away or closer get every FarInterval-th update, the others none
+				int FarInterval = 4;
+				int MaxUpdatesPerPacket = 8; ///< larger groups are split, a packet must stay below GameSparksRT::MAX_MESSAGE_SIZE_BYTES
+			};
+
+			/// Counters since construction
+			struct Stats
+			{
+				uint64_t Flushes = 0;
+				uint64_t Updates = 0; ///< updates queued
+				uint64_t Packets = 0; ///< packets sent by Flush()
+				uint64_t Deliveries = 0; ///< sum over the updates of the peers they were sent to
+				uint64_t Filtered = 0; ///< sum over the updates of the active peers they were not sent to
+			};
+
+			RTInterestManager();
+			explicit RTInterestManager(const Settings& settings);
+
+			/// sets the position of a peer, e.g. when an update of it was received
+			void SetPeerPosition(int peerId, float x, float y);
+
+			/// forgets the position of a peer, e.g. on IRTSessionListener::OnPlayerDisconnect()
+			void RemovePeer(int peerId);
+
+			/// queues an update about something at x/y for the next Flush()
+			void QueueUpdate(float x, float y, const RTData& data);
+
+			/// <summary>
+			/// Sends the queued updates to the active peers of the session that are interested in them and clears the queue.
+			/// </summary>
+			/// <returns>The bytes written, as returned by IRTSession::SendRTData()</returns>
+			int Flush(IRTSession& session, int opCode, GameSparksRT::DeliveryIntent intent);
+
+			const Stats& GetStats() const { return stats; }
+
+			/// appends the updates of a packet sent by Flush() to updates
+			static void ReadUpdates(const RTData& packetData, gsstl::vector<RTData>& updates);
+
+		private:
+			struct Update
+			{
+				int64_t cell;
+				RTData data;
+			};
+
+			int64_t CellOf(float x, float y) const;
+			bool IsFarDue(int peerId) const;
+			void BuildGrid(const gsstl::vector<int>& recipients);
+			void CollectTargets(int64_t cell, gsstl::vector<int>& targets) const;
+
+			Settings settings;
+			Stats stats;
+
+			//! known positions by peer id, sorted
+			gsstl::vector<gsstl::pair<int, int64_t> > peerCells;
+
+			//! (cell, peer id) of the recipients with a known position, sorted, rebuilt by every Flush()
+			gsstl::vector<gsstl::pair<int64_t, int> > grid;
+
+			//! recipients without a known position, they get every update
+			gsstl::vector<int> unplaced;
+
+			gsstl::vector<Update> queue;
+	};
+
+}} /* namespace GameSparks.RT */
+
+#endif /* _GAMESPARKSRT_RTINTERESTMANAGER_HPP_ */
@@ -3,9 +3,14 @@
 
 #include <vector>
 #include <cassert>
+#include "System/Bytes.hpp"
 
 namespace System {
 
+    /// the array type an ArraySegment<T> refers to. For bytes that is System::Bytes, which has its own allocator with GS_USE_LEAK_DETECTOR.
+    template <typename T> struct ArraySegmentArray { typedef gsstl::vector<T> type; };
+    template <> struct ArraySegmentArray<Byte> { typedef Bytes type; };
+
     /// represents a section of a one dimensional array.
     template <typename T>
 	class ArraySegment
@@ -15,7 +20,7 @@ namespace System {
 		//
 		// Properties
 		//
-	    const gsstl::vector<T>& Array() const {
+	    const typename ArraySegmentArray<T>::type& Array() const {
 			return array;
 		}
 
@@ -31,7 +36,7 @@ namespace System {
 
 		/// Construct and ArraySegment that represents the whole of the passed array.
         /// you need to make sure, that the passed array stay around as long as the ArraySegment.
-	    ArraySegment (const gsstl::vector<T>& array_)
+	    ArraySegment (const typename ArraySegmentArray<T>::type& array_)
         :array(array_)
         ,offset(0)
         ,count(int(array.size()))
@@ -39,7 +44,7 @@ namespace System {
 
         /// Construct an ArraySegment to represent a section of the passed array.
         /// you need to make sure, that the passed array stay around as long as the ArraySegment.
-	    ArraySegment (const gsstl::vector<T>& array_, int offset_, int count_)
+	    ArraySegment (const typename ArraySegmentArray<T>::type& array_, int offset_, int count_)
         :array(array_)
         ,offset(offset_)
         ,count(count_)
@@ -62,7 +67,7 @@ namespace System {
         }
 
         private:
-            const gsstl::vector<T>& array;
+            const typename ArraySegmentArray<T>::type& array;
             int offset;
             int count;
     };
@@ -3,14 +3,22 @@
 
 #include <vector>
 #include <GameSparks/gsstl.h>
+#include <GameSparks/GSLeakDetector.h>
 
 /// commonly used data types
 namespace System {
 
 	typedef unsigned char Byte;
 
+#if defined(GS_USE_LEAK_DETECTOR) && !defined(DOXYGEN)
+	struct BytesAllocationTag { static const char* Name() { return "System::Bytes"; } };
+
+	/// with GS_USE_LEAK_DETECTOR the buffers are counted by the AllocationProfiler
+	typedef gsstl::vector<Byte, GameSparks::Util::CountingAllocator<Byte, BytesAllocationTag> > Bytes;
+#else
 	/// a typedef to std::vector<unsigned char>
 	typedef gsstl::vector<Byte> Bytes;
+#endif
 
 } /* namespace System */
 
@@ -1,7 +1,8 @@
 #ifndef _SYSTEM_FAILABLE_FORWARD_HPP_INCLUDED_
 #define _SYSTEM_FAILABLE_FORWARD_HPP_INCLUDED_
 
-#if (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+// Failable is a class, gcc only supports warn_unused_result on functions and warns about it on classes
+#if defined(__clang__)
 #   if __has_attribute(warn_unused_result)
 #   	define GS_WARN_UNUSED_RESULT __attribute__((__warn_unused_result__))
 #   endif
@@ -111,6 +111,9 @@ namespace GameSparks {
 /* Render a cJSON entity to text for transfer/storage without any formatting. Free the char* when finished. */
     extern CLASS_DECLSPEC char *cJSON_PrintUnformatted(cJSON *item);
 
+/* Free a string returned by cJSON_Print or cJSON_PrintUnformatted. Goes through the hooks, unlike free(). */
+    extern CLASS_DECLSPEC void cJSON_Free(void *ptr);
+
 /* Delete a cJSON entity and all subentities. */
     extern CLASS_DECLSPEC void cJSON_Delete(cJSON *c);
 
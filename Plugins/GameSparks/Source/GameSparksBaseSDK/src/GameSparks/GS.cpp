@@ -746,7 +746,7 @@ gsstl::string GS::SerializeRequestQueue(const t_PersistentQueue& q)
 
 	char* asText = cJSON_Print(list);
 	gsstl::string result(asText);
-	free(asText);
+	cJSON_Free(asText);
 	cJSON_Delete(list);
 
 	return result;
@@ -845,6 +845,12 @@ gsstl::string GS::buildServiceUrl(const IGSPlatform* platform)
 		credential = "secure";
 	}
 
+	// a domain that already carries a scheme (e.g. "ws://127.0.0.1:8080") points at a local or mock backend and is used as is
+	if (apiDomain.find("://") != gsstl::string::npos)
+	{
+		return apiDomain + "/ws/" + credential + "/" + platform->m_apiKey;
+	}
+
 	return "wss://" + platform->m_apiStage + "-" + platform->m_apiKey + "." + apiDomain + "/ws/" + credential + "/" + platform->m_apiKey;
     #endif
 }
@@ -265,7 +265,7 @@ gsstl::string GSData::GetJSON() const
 {
 	char* asText = cJSON_Print(m_Data);
 	gsstl::string result(asText);
-	free(asText);
+	cJSON_Free(asText);
 	return result;
 }
 
@@ -0,0 +1,453 @@
+// Copyright 2015 GameSparks Ltd 2015, Inc. All Rights Reserved.
+#include <GameSparks/GSLeakDetector.h>
+
+#if defined(GS_USE_LEAK_DETECTOR)
+
+#include <cjson/cJSON.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(GS_BUILDING_MODULE)
+#	include "HAL/IConsoleManager.h"
+#endif
+
+#if defined(_MSC_VER) || defined(__linux__) || defined(__ANDROID__)
+#	include <malloc.h>
+#elif defined(__APPLE__)
+#	include <malloc/malloc.h>
+#endif
+
+using namespace GameSparks::Util;
+
+namespace GameSparks { namespace Util { namespace AllocationProfilerDetail
+{
+	// scope and type pairs. Once all slots are taken, further pairs are only counted as "(other)".
+	static const int CALL_SITES = 4096;
+
+	struct CallSite
+	{
+		std::atomic<uint64_t> key; // (scope id + 1) << 32 | (type index + 1), 0 for a free slot
+		std::atomic<const Profiler::Site*> scope;
+		std::atomic<AllocationProfiler::Type*> type;
+		std::atomic<uint64_t> allocations;
+		std::atomic<uint64_t> bytes;
+	};
+
+	// all of these are zero initialized before any dynamic initialization, so types can register from static constructors
+	static CallSite callSites[CALL_SITES];
+	static std::atomic<uint64_t> otherAllocations;
+	static std::atomic<uint64_t> otherBytes;
+	static std::atomic<AllocationProfiler::Type*> types;
+	static std::atomic<int> typeCount;
+	static std::atomic<int64_t> resetNs;
+
+	static int64_t Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static const int64_t startNs = Now();
+
+	static void RecordCallSite(AllocationProfiler::Type& type, size_t bytes)
+	{
+		const Profiler::Site* scope = Profiler::CurrentScope();
+
+		uint64_t key = (uint64_t(scope ? scope->id + 1 : 0) << 32) | uint64_t(type.index + 1);
+		uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+		for (int probe = 0; probe < CALL_SITES; ++probe)
+		{
+			CallSite& site = callSites[(hash + probe) & (CALL_SITES - 1)];
+			uint64_t current = site.key.load(std::memory_order_acquire);
+			if (current == 0)
+			{
+				if (site.key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+				{
+					site.scope.store(scope, std::memory_order_relaxed);
+					site.type.store(&type, std::memory_order_release);
+					current = key;
+				}
+			}
+			if (current == key)
+			{
+				site.allocations.fetch_add(1, std::memory_order_relaxed);
+				site.bytes.fetch_add(bytes, std::memory_order_relaxed);
+				return;
+			}
+		}
+
+		otherAllocations.fetch_add(1, std::memory_order_relaxed);
+		otherBytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	static double SecondsSinceReset()
+	{
+		int64_t since = resetNs.load(std::memory_order_relaxed);
+		return (Now() - (since ? since : startNs)) / 1e9;
+	}
+
+	static void AppendEscaped(gsstl::string& out, const gsstl::string& value)
+	{
+		for (size_t i = 0; i < value.size(); ++i)
+		{
+			char c = value[i];
+			if (c == '"' || c == '\\')
+			{
+				out += '\\';
+				out += c;
+			}
+			else if (static_cast<unsigned char>(c) < 0x20)
+			{
+				char buffer[8];
+				snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+				out += buffer;
+			}
+			else
+			{
+				out += c;
+			}
+		}
+	}
+
+	static void Appendf(gsstl::string& out, const char* format, ...)
+	{
+		char buffer[512];
+		va_list args;
+		va_start(args, format);
+		vsnprintf(buffer, sizeof(buffer), format, args);
+		va_end(args);
+		out += buffer;
+	}
+
+	// cJSON only hands the pointer to free, so the bytes are taken from the allocator where it can tell
+	static size_t UsableSize(void* p)
+	{
+		#if defined(_MSC_VER)
+		return _msize(p);
+		#elif defined(__APPLE__)
+		return malloc_size(p);
+		#elif defined(__linux__) || defined(__ANDROID__)
+		return malloc_usable_size(p);
+		#else
+		(void)p;
+		return 0;
+		#endif
+	}
+
+	static AllocationProfiler::Type& CJSONType()
+	{
+		static AllocationProfiler::Type type("cJSON");
+		return type;
+	}
+
+	static void* CountingMalloc(size_t size)
+	{
+		void* p = malloc(size);
+		if (p)
+		{
+			AllocationProfiler::OnAllocate(CJSONType(), UsableSize(p));
+		}
+		return p;
+	}
+
+	static void CountingFree(void* p)
+	{
+		if (p)
+		{
+			AllocationProfiler::OnFree(CJSONType(), UsableSize(p));
+			free(p);
+		}
+	}
+
+	// the hooks do not change the layout of the blocks, so it does not matter what cJSON allocated before
+	static struct CJSONHooksInstaller
+	{
+		CJSONHooksInstaller()
+		{
+			cJSON_Hooks hooks = { &CountingMalloc, &CountingFree };
+			cJSON_InitHooks(&hooks);
+		}
+	} cjsonHooksInstaller;
+}}} /* namespace GameSparks.Util.AllocationProfilerDetail */
+
+#if defined(GS_BUILDING_MODULE)
+static FAutoConsoleCommand GameSparksAllocationsCommand(
+	TEXT("GameSparks.Allocations"),
+	TEXT("GameSparks.Allocations [reset]: logs the GameSparks SDK allocations per type and scope since the last reset"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			AllocationProfiler::Reset();
+			return;
+		}
+
+		TArray<FString> Lines;
+		FString(UTF8_TO_TCHAR(AllocationProfiler::Report().c_str())).ParseIntoArrayLines(Lines, false);
+		for (const FString& Line : Lines)
+		{
+			UE_LOG(LogTemp, Log, TEXT("%s"), *Line);
+		}
+	})
+);
+#endif
+
+AllocationProfiler::Type::Type(const char* name_)
+:name(name_)
+,index(AllocationProfilerDetail::typeCount.fetch_add(1, std::memory_order_relaxed))
+,allocations(0)
+,frees(0)
+,bytes(0)
+,live(0)
+,liveBytes(0)
+,peak(0)
+,next(nullptr)
+{
+	Type* head = AllocationProfilerDetail::types.load(std::memory_order_relaxed);
+	do
+	{
+		next = head;
+	}
+	while (!AllocationProfilerDetail::types.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void AllocationProfiler::OnAllocate(Type& type, size_t bytes)
+{
+	type.allocations.fetch_add(1, std::memory_order_relaxed);
+	type.bytes.fetch_add(bytes, std::memory_order_relaxed);
+	type.liveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+
+	int64_t live = type.live.fetch_add(1, std::memory_order_relaxed) + 1;
+	int64_t peak = type.peak.load(std::memory_order_relaxed);
+	while (live > peak && !type.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+	{
+	}
+
+	AllocationProfilerDetail::RecordCallSite(type, bytes);
+}
+
+void AllocationProfiler::OnFree(Type& type, size_t bytes)
+{
+	type.frees.fetch_add(1, std::memory_order_relaxed);
+	type.live.fetch_sub(1, std::memory_order_relaxed);
+	type.liveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void AllocationProfiler::Reset()
+{
+	using namespace AllocationProfilerDetail;
+
+	for (Type* type = types.load(std::memory_order_acquire); type; type = type->next)
+	{
+		type->allocations.store(0, std::memory_order_relaxed);
+		type->frees.store(0, std::memory_order_relaxed);
+		type->bytes.store(0, std::memory_order_relaxed);
+		type->peak.store(type->live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	// the slots keep their keys, so that concurrent inserts never race with the reset
+	for (int i = 0; i < CALL_SITES; ++i)
+	{
+		callSites[i].allocations.store(0, std::memory_order_relaxed);
+		callSites[i].bytes.store(0, std::memory_order_relaxed);
+	}
+	otherAllocations.store(0, std::memory_order_relaxed);
+	otherBytes.store(0, std::memory_order_relaxed);
+
+	resetNs.store(Now(), std::memory_order_relaxed);
+}
+
+gsstl::vector<AllocationProfiler::TypeStats> AllocationProfiler::GetTypes()
+{
+	using namespace AllocationProfilerDetail;
+
+	double seconds = SecondsSinceReset();
+	gsstl::vector<TypeStats> ret;
+
+	// with the SDK in a dll, a template's type can be registered once per module, so types are merged by name
+	for (Type* type = types.load(std::memory_order_acquire); type; type = type->next)
+	{
+		TypeStats* stats = nullptr;
+		for (size_t i = 0; i < ret.size() && !stats; ++i)
+		{
+			if (ret[i].name == type->name)
+			{
+				stats = &ret[i];
+			}
+		}
+		if (!stats)
+		{
+			ret.push_back(TypeStats());
+			stats = &ret.back();
+			stats->name = type->name;
+			stats->allocations = stats->frees = stats->bytes = 0;
+			stats->live = stats->liveBytes = stats->peak = 0;
+		}
+
+		stats->allocations += type->allocations.load(std::memory_order_relaxed);
+		stats->frees += type->frees.load(std::memory_order_relaxed);
+		stats->bytes += type->bytes.load(std::memory_order_relaxed);
+		stats->live += type->live.load(std::memory_order_relaxed);
+		stats->liveBytes += type->liveBytes.load(std::memory_order_relaxed);
+		stats->peak += type->peak.load(std::memory_order_relaxed);
+	}
+
+	gsstl::vector<TypeStats> active;
+	for (size_t i = 0; i < ret.size(); ++i)
+	{
+		if (ret[i].allocations || ret[i].live)
+		{
+			ret[i].allocationsPerSecond = seconds > 0 ? ret[i].allocations / seconds : 0;
+			active.push_back(ret[i]);
+		}
+	}
+
+	std::sort(active.begin(), active.end(), [](const TypeStats& a, const TypeStats& b) { return a.allocations > b.allocations; });
+	return active;
+}
+
+gsstl::vector<AllocationProfiler::CallSiteStats> AllocationProfiler::GetCallSites(size_t count)
+{
+	using namespace AllocationProfilerDetail;
+
+	// scopes of the same name in different places (e.g. one per connection type) are reported as one
+	gsstl::vector<CallSiteStats> ret;
+	gsstl::map<gsstl::string, size_t> byName;
+	for (int i = 0; i < CALL_SITES; ++i)
+	{
+		const CallSite& site = callSites[i];
+		Type* type = site.type.load(std::memory_order_acquire);
+		uint64_t allocations = site.allocations.load(std::memory_order_relaxed);
+		if (!type || !allocations)
+		{
+			continue;
+		}
+
+		const Profiler::Site* scope = site.scope.load(std::memory_order_relaxed);
+		CallSiteStats stats;
+		stats.scope = scope ? scope->name : gsstl::string("(no scope)");
+		stats.type = type->name;
+		stats.allocations = allocations;
+		stats.bytes = site.bytes.load(std::memory_order_relaxed);
+
+		gsstl::string name = stats.scope + "\n" + stats.type;
+		gsstl::map<gsstl::string, size_t>::iterator existing = byName.find(name);
+		if (existing != byName.end())
+		{
+			ret[existing->second].allocations += stats.allocations;
+			ret[existing->second].bytes += stats.bytes;
+		}
+		else
+		{
+			byName[name] = ret.size();
+			ret.push_back(stats);
+		}
+	}
+
+	if (uint64_t allocations = otherAllocations.load(std::memory_order_relaxed))
+	{
+		CallSiteStats stats;
+		stats.scope = "(other)";
+		stats.type = "(other)";
+		stats.allocations = allocations;
+		stats.bytes = otherBytes.load(std::memory_order_relaxed);
+		ret.push_back(stats);
+	}
+
+	std::sort(ret.begin(), ret.end(), [](const CallSiteStats& a, const CallSiteStats& b) { return a.allocations > b.allocations; });
+	if (ret.size() > count)
+	{
+		ret.resize(count);
+	}
+	return ret;
+}
+
+gsstl::string AllocationProfiler::GetLeakedClasses()
+{
+	gsstl::vector<TypeStats> types = GetTypes();
+	gsstl::string ret;
+	for (size_t i = 0; i < types.size(); ++i)
+	{
+		if (types[i].live > 0)
+		{
+			AllocationProfilerDetail::Appendf(ret, "Leaked: %s (%lld)\n", types[i].name.c_str(), (long long)types[i].live);
+		}
+	}
+	return ret;
+}
+
+gsstl::string AllocationProfiler::Report(size_t callSites)
+{
+	using namespace AllocationProfilerDetail;
+
+	gsstl::vector<TypeStats> types = GetTypes();
+	gsstl::vector<CallSiteStats> sites = GetCallSites(callSites);
+
+	gsstl::string out;
+	Appendf(out, "allocations over %.1fs\n", SecondsSinceReset());
+	Appendf(out, "%-40s %12s %10s %10s %10s %14s %14s\n", "type", "allocations", "allocs/s", "live", "peak", "bytes", "live bytes");
+	for (size_t i = 0; i < types.size(); ++i)
+	{
+		const TypeStats& t = types[i];
+		Appendf(out, "%-40s %12llu %10.1f %10lld %10lld %14llu %14lld\n", t.name.c_str(), (unsigned long long)t.allocations,
+			t.allocationsPerSecond, (long long)t.live, (long long)t.peak, (unsigned long long)t.bytes, (long long)t.liveBytes);
+	}
+
+	Appendf(out, "\n%-48s %-32s %12s %14s\n", "scope", "type", "allocations", "bytes");
+	for (size_t i = 0; i < sites.size(); ++i)
+	{
+		const CallSiteStats& s = sites[i];
+		Appendf(out, "%-48s %-32s %12llu %14llu\n", s.scope.c_str(), s.type.c_str(), (unsigned long long)s.allocations, (unsigned long long)s.bytes);
+	}
+	return out;
+}
+
+gsstl::string AllocationProfiler::ToJSON(size_t callSites)
+{
+	using namespace AllocationProfilerDetail;
+
+	gsstl::vector<TypeStats> types = GetTypes();
+	gsstl::vector<CallSiteStats> sites = GetCallSites(callSites);
+
+	gsstl::string out;
+	Appendf(out, "{\"seconds\":%.3f,\"types\":[", SecondsSinceReset());
+	for (size_t i = 0; i < types.size(); ++i)
+	{
+		const TypeStats& t = types[i];
+		out += i ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+		AppendEscaped(out, t.name);
+		Appendf(out, "\",\"allocations\":%llu,\"frees\":%llu,\"bytes\":%llu,\"allocationsPerSecond\":%.3f,\"live\":%lld,\"liveBytes\":%lld,\"peak\":%lld}",
+			(unsigned long long)t.allocations, (unsigned long long)t.frees, (unsigned long long)t.bytes, t.allocationsPerSecond,
+			(long long)t.live, (long long)t.liveBytes, (long long)t.peak);
+	}
+	out += "\n],\"callSites\":[";
+	for (size_t i = 0; i < sites.size(); ++i)
+	{
+		const CallSiteStats& s = sites[i];
+		out += i ? ",\n{\"scope\":\"" : "\n{\"scope\":\"";
+		AppendEscaped(out, s.scope);
+		out += "\",\"type\":\"";
+		AppendEscaped(out, s.type);
+		Appendf(out, "\",\"allocations\":%llu,\"bytes\":%llu}", (unsigned long long)s.allocations, (unsigned long long)s.bytes);
+	}
+	out += "\n]}\n";
+	return out;
+}
+
+bool AllocationProfiler::WriteJSON(const gsstl::string& path, size_t callSites)
+{
+	gsstl::string contents = ToJSON(callSites);
+	FILE* file = fopen(path.c_str(), "wb");
+	if (!file)
+	{
+		return false;
+	}
+	bool ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	return fclose(file) == 0 && ok;
+}
+
+#endif /* GS_USE_LEAK_DETECTOR */
@@ -0,0 +1,678 @@
+// Copyright 2015 GameSparks Ltd 2015, Inc. All Rights Reserved.
+#include <GameSparks/GSProfiler.h>
+
+#if GS_USE_PROFILER
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#if defined(GS_BUILDING_MODULE)
+#	include "HAL/IConsoleManager.h"
+#endif
+
+using namespace GameSparks::Util;
+
+namespace GameSparks { namespace Util { namespace ProfilerDetail
+{
+	// sites with a higher id are counted as never entered. The SDK declares a few dozen.
+	static const int MAX_SITES = 1024;
+
+	// log-linear histogram: values below 8ns get a bucket each, above that every octave is split into 4 buckets.
+	// 192 buckets reach up to 2^49ns (~6.5 days), which is plenty for a scope.
+	static const int LINEAR_BUCKETS = 8;
+	static const int SUB_BUCKETS = 4;
+	static const int BUCKETS = 192;
+
+	static int MostSignificantBit(uint64_t v)
+	{
+		#if defined(__GNUC__) || defined(__clang__)
+		return 63 - __builtin_clzll(v);
+		#else
+		int r = 0;
+		while (v >>= 1) ++r;
+		return r;
+		#endif
+	}
+
+	static int BucketOf(uint64_t ns)
+	{
+		if (ns < LINEAR_BUCKETS)
+		{
+			return static_cast<int>(ns);
+		}
+
+		int octave = MostSignificantBit(ns);
+		int sub = static_cast<int>((ns >> (octave - 2)) & (SUB_BUCKETS - 1));
+		int bucket = LINEAR_BUCKETS + (octave - 3) * SUB_BUCKETS + sub;
+		return bucket < BUCKETS ? bucket : BUCKETS - 1;
+	}
+
+	// the value in the middle of the bucket, used to estimate the percentiles
+	static double BucketValue(int bucket)
+	{
+		if (bucket < LINEAR_BUCKETS)
+		{
+			return bucket;
+		}
+
+		int octave = 3 + (bucket - LINEAR_BUCKETS) / SUB_BUCKETS;
+		int sub = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+		double width = static_cast<double>(uint64_t(1) << (octave - 2));
+		return (SUB_BUCKETS + sub) * width + width / 2;
+	}
+
+	// the counters of one site in one thread. Only the owning thread writes them, so plain loads and stores are
+	// enough and the hot path has no read-modify-write instructions. Readers may see a sample half recorded.
+	struct Counters
+	{
+		std::atomic<uint64_t> calls;
+		std::atomic<uint64_t> totalNs;
+		std::atomic<uint64_t> maxNs;
+		std::atomic<uint64_t> buckets[BUCKETS];
+
+		Counters()
+		{
+			Clear();
+		}
+
+		void Clear()
+		{
+			calls.store(0, std::memory_order_relaxed);
+			totalNs.store(0, std::memory_order_relaxed);
+			maxNs.store(0, std::memory_order_relaxed);
+			for (int i = 0; i < BUCKETS; ++i)
+			{
+				buckets[i].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		void Add(uint64_t ns)
+		{
+			calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			totalNs.store(totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+			if (ns > maxNs.load(std::memory_order_relaxed))
+			{
+				maxNs.store(ns, std::memory_order_relaxed);
+			}
+			std::atomic<uint64_t>& bucket = buckets[BucketOf(ns)];
+			bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		// only used for the aggregate of exited threads and while collecting, both under the registry mutex
+		void Merge(const Counters& other)
+		{
+			calls.store(calls.load(std::memory_order_relaxed) + other.calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			totalNs.store(totalNs.load(std::memory_order_relaxed) + other.totalNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			maxNs.store(std::max(maxNs.load(std::memory_order_relaxed), other.maxNs.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+			for (int i = 0; i < BUCKETS; ++i)
+			{
+				buckets[i].store(buckets[i].load(std::memory_order_relaxed) + other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+	};
+
+	struct TraceEvent
+	{
+		const Profiler::Site* site;
+		int64_t startNs;
+		int64_t durationNs;
+	};
+
+	// events of one thread, overwritten oldest first once full
+	struct TraceRing
+	{
+		TraceRing(int threadId_, unsigned generation_, size_t capacity)
+		:threadId(threadId_)
+		,generation(generation_)
+		,events(capacity)
+		,written(0)
+		{
+		}
+
+		int threadId;
+		unsigned generation;
+		gsstl::vector<TraceEvent> events;
+		std::atomic<uint64_t> written;
+	};
+
+	struct ThreadBuffer
+	{
+		explicit ThreadBuffer(int threadId_)
+		:threadId(threadId_)
+		,ring(nullptr)
+		{
+			for (int i = 0; i < MAX_SITES; ++i)
+			{
+				counters[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		int threadId;
+		// allocated by the owning thread on first use of a site and published with release, so that readers holding
+		// the registry mutex can walk them while the owner keeps recording
+		std::atomic<Counters*> counters[MAX_SITES];
+		std::atomic<TraceRing*> ring;
+	};
+
+	struct Registry
+	{
+		Registry()
+		:nextThreadId(1)
+		,traceCapacity(0)
+		,traceGeneration(0)
+		,tracing(false)
+		{
+		}
+
+		std::mutex mutex;
+		gsstl::vector<Profiler::Site*> sites;
+		gsstl::vector<ThreadBuffer*> threads;
+		gsstl::vector<Counters*> retired; // by site id, the counters of exited threads
+		gsstl::vector<TraceRing*> retiredRings;
+		int nextThreadId;
+		size_t traceCapacity;
+		std::atomic<unsigned> traceGeneration;
+		std::atomic<bool> tracing;
+	};
+
+	// leaked on purpose: threads may exit and record after static destruction started
+	static Registry& GetRegistry()
+	{
+		static Registry* registry = new Registry();
+		return *registry;
+	}
+
+	// thread_local pointers are trivially destructible, so they can still be checked from other thread_local
+	// destructors after the holder below is gone
+	static thread_local ThreadBuffer* threadBuffer = nullptr;
+	static thread_local bool threadExited = false;
+
+	// hands the counters of an exiting thread to the registry
+	struct ThreadBufferHolder
+	{
+		~ThreadBufferHolder()
+		{
+			ThreadBuffer* buffer = threadBuffer;
+			threadBuffer = nullptr;
+			threadExited = true;
+
+			if (!buffer)
+			{
+				return;
+			}
+
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			for (int i = 0; i < MAX_SITES; ++i)
+			{
+				Counters* counters = buffer->counters[i].load(std::memory_order_relaxed);
+				if (counters)
+				{
+					if (registry.retired.size() <= static_cast<size_t>(i))
+					{
+						registry.retired.resize(i + 1, nullptr);
+					}
+					if (!registry.retired[i])
+					{
+						registry.retired[i] = new Counters();
+					}
+					registry.retired[i]->Merge(*counters);
+					delete counters;
+				}
+			}
+
+			if (TraceRing* ring = buffer->ring.load(std::memory_order_relaxed))
+			{
+				registry.retiredRings.push_back(ring);
+			}
+
+			registry.threads.erase(std::remove(registry.threads.begin(), registry.threads.end(), buffer), registry.threads.end());
+			delete buffer;
+		}
+	};
+
+	static thread_local ThreadBufferHolder threadBufferHolder;
+
+	static thread_local const Profiler::Site* currentScope = nullptr;
+
+	static ThreadBuffer* GetThreadBuffer()
+	{
+		if (threadBuffer || threadExited)
+		{
+			return threadBuffer;
+		}
+
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		threadBuffer = new ThreadBuffer(registry.nextThreadId++);
+		registry.threads.push_back(threadBuffer);
+		(void)&threadBufferHolder; // odr-use, so that the holder gets constructed and destroyed with the thread
+		return threadBuffer;
+	}
+
+	// returns the ring of the current trace for this thread, replacing one left over from an earlier trace
+	static TraceRing* GetTraceRing(ThreadBuffer* buffer)
+	{
+		Registry& registry = GetRegistry();
+		unsigned generation = registry.traceGeneration.load(std::memory_order_acquire);
+		TraceRing* ring = buffer->ring.load(std::memory_order_relaxed);
+		if (ring && ring->generation == generation)
+		{
+			return ring;
+		}
+
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		if (registry.traceCapacity == 0)
+		{
+			return nullptr;
+		}
+		TraceRing* fresh = new TraceRing(buffer->threadId, registry.traceGeneration.load(std::memory_order_relaxed), registry.traceCapacity);
+		buffer->ring.store(fresh, std::memory_order_release);
+		delete ring; // only ever read under the mutex, which is held
+		return fresh;
+	}
+
+	static void AppendEscaped(gsstl::string& out, const gsstl::string& value)
+	{
+		for (size_t i = 0; i < value.size(); ++i)
+		{
+			char c = value[i];
+			switch (c)
+			{
+				case '"': out += "\\\""; break;
+				case '\\': out += "\\\\"; break;
+				case '\n': out += "\\n"; break;
+				case '\r': out += "\\r"; break;
+				case '\t': out += "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+					{
+						char buffer[8];
+						snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+						out += buffer;
+					}
+					else
+					{
+						out += c;
+					}
+			}
+		}
+	}
+
+	static void Appendf(gsstl::string& out, const char* format, ...)
+	{
+		char buffer[256];
+		va_list args;
+		va_start(args, format);
+		vsnprintf(buffer, sizeof(buffer), format, args);
+		va_end(args);
+		out += buffer;
+	}
+
+	static bool WriteFile(const gsstl::string& path, const gsstl::string& contents)
+	{
+		FILE* file = fopen(path.c_str(), "wb");
+		if (!file)
+		{
+			return false;
+		}
+		bool ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+		return fclose(file) == 0 && ok;
+	}
+}}} /* namespace GameSparks.Util.ProfilerDetail */
+
+#if defined(GS_BUILDING_MODULE)
+DECLARE_STATS_GROUP(TEXT("GameSparks SDK"), STATGROUP_GameSparksSDK, STATCAT_Advanced);
+
+static FAutoConsoleCommand GameSparksProfilerCommand(
+	TEXT("GameSparks.Profiler"),
+	TEXT("GameSparks.Profiler 1|0|reset|dump: starts or stops the GameSparks SDK scope timers, clears them or logs a summary"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		FString Command = Args.Num() > 0 ? Args[0] : TEXT("dump");
+		if (Command == TEXT("1") || Command == TEXT("0"))
+		{
+			Profiler::SetEnabled(Command == TEXT("1"));
+		}
+		else if (Command == TEXT("reset"))
+		{
+			Profiler::Reset();
+		}
+		else
+		{
+			gsstl::vector<Profiler::ScopeStats> scopes = Profiler::Collect();
+			for (size_t i = 0; i < scopes.size(); ++i)
+			{
+				const Profiler::ScopeStats& s = scopes[i];
+				UE_LOG(LogTemp, Log, TEXT("%-48s calls %8llu total %10.1fus mean %8.2fus p50 %8.2fus p99 %8.2fus max %8.2fus"),
+					UTF8_TO_TCHAR(s.name.c_str()), (unsigned long long)s.calls, s.totalUs, s.meanUs, s.p50Us, s.p99Us, s.maxUs);
+			}
+		}
+	})
+);
+#endif
+
+std::atomic<bool> Profiler::enabled(false);
+
+void Profiler::SetEnabled(bool value)
+{
+	enabled.store(value, std::memory_order_relaxed);
+}
+
+void Profiler::Reset()
+{
+	using namespace ProfilerDetail;
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	for (size_t t = 0; t < registry.threads.size(); ++t)
+	{
+		for (int i = 0; i < MAX_SITES; ++i)
+		{
+			if (Counters* counters = registry.threads[t]->counters[i].load(std::memory_order_acquire))
+			{
+				counters->Clear();
+			}
+		}
+	}
+
+	for (size_t i = 0; i < registry.retired.size(); ++i)
+	{
+		delete registry.retired[i];
+	}
+	registry.retired.clear();
+
+	for (size_t i = 0; i < registry.retiredRings.size(); ++i)
+	{
+		delete registry.retiredRings[i];
+	}
+	registry.retiredRings.clear();
+
+	// live threads replace their rings on the next sample
+	registry.traceGeneration.fetch_add(1, std::memory_order_release);
+}
+
+gsstl::vector<Profiler::ScopeStats> Profiler::Collect()
+{
+	using namespace ProfilerDetail;
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	gsstl::vector<ScopeStats> ret;
+	Counters merged;
+
+	for (size_t id = 0; id < registry.sites.size() && id < static_cast<size_t>(MAX_SITES); ++id)
+	{
+		merged.Clear();
+		if (id < registry.retired.size() && registry.retired[id])
+		{
+			merged.Merge(*registry.retired[id]);
+		}
+		for (size_t t = 0; t < registry.threads.size(); ++t)
+		{
+			if (Counters* counters = registry.threads[t]->counters[id].load(std::memory_order_acquire))
+			{
+				merged.Merge(*counters);
+			}
+		}
+
+		uint64_t calls = merged.calls.load(std::memory_order_relaxed);
+		if (calls == 0)
+		{
+			continue;
+		}
+
+		const Site* site = registry.sites[id];
+		ScopeStats stats;
+		stats.name = site->name;
+		stats.file = site->file;
+		stats.line = site->line;
+		stats.calls = calls;
+		stats.totalUs = merged.totalNs.load(std::memory_order_relaxed) / 1000.0;
+		stats.meanUs = stats.totalUs / calls;
+		stats.maxUs = merged.maxNs.load(std::memory_order_relaxed) / 1000.0;
+
+		// the bucket counts may be a sample ahead or behind calls, so the ranks are taken from their own sum
+		uint64_t counted = 0;
+		for (int i = 0; i < BUCKETS; ++i)
+		{
+			counted += merged.buckets[i].load(std::memory_order_relaxed);
+		}
+		const double quantiles[] = { 0.5, 0.9, 0.99 };
+		double* targets[] = { &stats.p50Us, &stats.p90Us, &stats.p99Us };
+		for (int q = 0; q < 3; ++q)
+		{
+			uint64_t rank = static_cast<uint64_t>(quantiles[q] * counted);
+			uint64_t seen = 0;
+			int bucket = 0;
+			for (; bucket < BUCKETS - 1; ++bucket)
+			{
+				seen += merged.buckets[bucket].load(std::memory_order_relaxed);
+				if (seen > rank)
+				{
+					break;
+				}
+			}
+			*targets[q] = std::min(BucketValue(bucket) / 1000.0, stats.maxUs);
+		}
+
+		ret.push_back(stats);
+	}
+
+	gsstl::sort(ret.begin(), ret.end(), [](const ScopeStats& a, const ScopeStats& b) { return a.totalUs > b.totalUs; });
+	return ret;
+}
+
+gsstl::string Profiler::ToJSON()
+{
+	using namespace ProfilerDetail;
+	gsstl::vector<ScopeStats> scopes = Collect();
+
+	gsstl::string out = "{\"scopes\":[";
+	for (size_t i = 0; i < scopes.size(); ++i)
+	{
+		const ScopeStats& s = scopes[i];
+		out += i ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+		AppendEscaped(out, s.name);
+		out += "\",\"file\":\"";
+		AppendEscaped(out, s.file);
+		Appendf(out, "\",\"line\":%d,\"calls\":%llu,\"totalUs\":%.3f,\"meanUs\":%.3f,\"p50Us\":%.3f,\"p90Us\":%.3f,\"p99Us\":%.3f,\"maxUs\":%.3f}",
+			s.line, (unsigned long long)s.calls, s.totalUs, s.meanUs, s.p50Us, s.p90Us, s.p99Us, s.maxUs);
+	}
+	out += "\n]}\n";
+	return out;
+}
+
+void Profiler::StartTrace(size_t eventsPerThread)
+{
+	using namespace ProfilerDetail;
+	Registry& registry = GetRegistry();
+	{
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for (size_t i = 0; i < registry.retiredRings.size(); ++i)
+		{
+			delete registry.retiredRings[i];
+		}
+		registry.retiredRings.clear();
+		registry.traceCapacity = eventsPerThread;
+		registry.traceGeneration.fetch_add(1, std::memory_order_release);
+		registry.tracing.store(eventsPerThread > 0, std::memory_order_relaxed);
+	}
+	SetEnabled(true);
+}
+
+void Profiler::StopTrace()
+{
+	ProfilerDetail::GetRegistry().tracing.store(false, std::memory_order_relaxed);
+}
+
+gsstl::string Profiler::ToChromeTrace()
+{
+	using namespace ProfilerDetail;
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	unsigned generation = registry.traceGeneration.load(std::memory_order_relaxed);
+	gsstl::vector<TraceRing*> rings;
+	for (size_t t = 0; t < registry.threads.size(); ++t)
+	{
+		TraceRing* ring = registry.threads[t]->ring.load(std::memory_order_acquire);
+		if (ring && ring->generation == generation)
+		{
+			rings.push_back(ring);
+		}
+	}
+	for (size_t i = 0; i < registry.retiredRings.size(); ++i)
+	{
+		if (registry.retiredRings[i]->generation == generation)
+		{
+			rings.push_back(registry.retiredRings[i]);
+		}
+	}
+
+	// timestamps are made relative to the first event so that they stay readable as microseconds
+	int64_t origin = INT64_MAX;
+	for (size_t r = 0; r < rings.size(); ++r)
+	{
+		uint64_t written = rings[r]->written.load(std::memory_order_acquire);
+		uint64_t count = std::min<uint64_t>(written, rings[r]->events.size());
+		for (uint64_t i = written - count; i < written; ++i)
+		{
+			origin = std::min(origin, rings[r]->events[i % rings[r]->events.size()].startNs);
+		}
+	}
+
+	gsstl::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+	for (size_t r = 0; r < rings.size(); ++r)
+	{
+		const TraceRing& ring = *rings[r];
+		Appendf(out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+			first ? "" : ",", ring.threadId, ring.threadId);
+		first = false;
+
+		uint64_t written = ring.written.load(std::memory_order_acquire);
+		uint64_t count = std::min<uint64_t>(written, ring.events.size());
+		for (uint64_t i = written - count; i < written; ++i)
+		{
+			const TraceEvent& event = ring.events[i % ring.events.size()];
+			out += ",\n{\"name\":\"";
+			AppendEscaped(out, event.site->name);
+			Appendf(out, "\",\"cat\":\"GameSparks\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+				(event.startNs - origin) / 1000.0, event.durationNs / 1000.0, ring.threadId);
+		}
+	}
+	out += "\n]}\n";
+	return out;
+}
+
+bool Profiler::WriteJSON(const gsstl::string& path)
+{
+	return ProfilerDetail::WriteFile(path, ToJSON());
+}
+
+bool Profiler::WriteChromeTrace(const gsstl::string& path)
+{
+	return ProfilerDetail::WriteFile(path, ToChromeTrace());
+}
+
+const Profiler::Site* Profiler::RegisterSite(const char* name, const char* file, int line, bool qualify)
+{
+	using namespace ProfilerDetail;
+
+	Site* site = new Site();
+	site->name = name;
+	site->file = file;
+	site->line = line;
+
+	// __FUNCTION__ is just the function name with gcc and clang, so prefix it with the file name: "GSConnection::Update"
+	if (qualify && !strstr(name, "::"))
+	{
+		const char* stem = file;
+		for (const char* c = file; *c; ++c)
+		{
+			if (*c == '/' || *c == '\\')
+			{
+				stem = c + 1;
+			}
+		}
+		const char* dot = strchr(stem, '.');
+		site->name = gsstl::string(stem, dot ? static_cast<size_t>(dot - stem) : strlen(stem)) + "::" + name;
+	}
+
+	#if defined(GS_BUILDING_MODULE) && STATS
+	site->statId = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_GameSparksSDK>(FString(UTF8_TO_TCHAR(site->name.c_str())));
+	#endif
+
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	site->id = static_cast<int>(registry.sites.size());
+	registry.sites.push_back(site);
+	return site;
+}
+
+void Profiler::Record(const Site* site, int64_t startNs, int64_t endNs)
+{
+	using namespace ProfilerDetail;
+
+	if (site->id >= MAX_SITES)
+	{
+		return;
+	}
+
+	ThreadBuffer* buffer = GetThreadBuffer();
+	if (!buffer)
+	{
+		return;
+	}
+
+	int64_t duration = endNs - startNs;
+	if (duration < 0)
+	{
+		duration = 0;
+	}
+
+	Counters* counters = buffer->counters[site->id].load(std::memory_order_relaxed);
+	if (!counters)
+	{
+		counters = new Counters();
+		buffer->counters[site->id].store(counters, std::memory_order_release);
+	}
+	counters->Add(static_cast<uint64_t>(duration));
+
+	if (GetRegistry().tracing.load(std::memory_order_relaxed))
+	{
+		if (TraceRing* ring = GetTraceRing(buffer))
+		{
+			uint64_t written = ring->written.load(std::memory_order_relaxed);
+			TraceEvent& event = ring->events[written % ring->events.size()];
+			event.site = site;
+			event.startNs = startNs;
+			event.durationNs = duration;
+			ring->written.store(written + 1, std::memory_order_release);
+		}
+	}
+}
+
+const Profiler::Site* Profiler::CurrentScope()
+{
+	return ProfilerDetail::currentScope;
+}
+
+const Profiler::Site* Profiler::EnterScope(const Site* site)
+{
+	const Site* outer = ProfilerDetail::currentScope;
+	ProfilerDetail::currentScope = site;
+	return outer;
+}
+
+void Profiler::LeaveScope(const Site* outer)
+{
+	ProfilerDetail::currentScope = outer;
+}
+
+#endif /* GS_USE_PROFILER */
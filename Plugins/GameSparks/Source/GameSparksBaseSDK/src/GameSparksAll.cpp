@@ -14,6 +14,16 @@
 #	endif
 #endif
 
+// the vendored sources (mbedtls, easywsclient, cJSON) are compiled as they are, their warnings are not ours to fix.
+// gcc can't disable -Wall by pragma, so the warnings they trigger with it are listed.
+#if defined(__clang__)
+#	pragma clang diagnostic push
+#	pragma clang diagnostic ignored "-Wall"
+#elif defined(__GNUC__)
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Wmisleading-indentation"
+#endif
+
 #define MBEDTLS_AMALGAMATE
 #define MBEDTLS_UNREAL
 #	if !defined(_DURANGO)
@@ -175,10 +185,18 @@ extern "C"
 
 #include "cjson/cJSON.cpp"
 
+#if defined(__clang__)
+#	pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#	pragma GCC diagnostic pop
+#endif
+
 #include "GameSparks/GS.cpp"
 #include "GameSparks/GSConnection.cpp"
 #include "GameSparks/GSData.cpp"
 #include "GameSparks/GSDateTime.cpp"
+#include "GameSparks/GSLeakDetector.cpp"
+#include "GameSparks/GSProfiler.cpp"
 #if defined(__OBJC__)
 #	include "GSIosHelper.mm"
 #endif
@@ -224,6 +242,8 @@ extern "C"
 #	include "GameSparksRT/Proto/RTData.Serializer.cpp"
 #	include "GameSparksRT/Proto/RTVal.cpp"
 #	include "GameSparksRT/RTData.cpp"
+#	include "GameSparksRT/RTInterestManager.cpp"
+#	include "GameSparksRT/RTSendScheduler.cpp"
 #	include "GameSparksRT/RTSessionImpl.cpp"
 #	include "System/IO/BinaryReader.cpp"
 #	include "System/IO/BinaryWriter.cpp"
@@ -232,6 +252,7 @@ extern "C"
 #	if !defined(_DURANGO)
 #		include "System/Net/Sockets/NetworkStream.cpp"
 #		include "System/Net/Sockets/Socket.cpp"
+#		include "System/Net/Sockets/SocketReactor.cpp"
 #		include "System/Net/Sockets/TLSSocket.cpp"
 #		include "System/Net/Sockets/TcpClient.cpp"
 #		include "System/Net/Sockets/UdpClient.cpp"
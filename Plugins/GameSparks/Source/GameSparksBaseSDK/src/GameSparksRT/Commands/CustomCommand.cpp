@@ -36,4 +36,10 @@ void CustomCommand::Execute()
     }
 }
 
+
+bool CustomCommand::ExecuteOnReceive()
+{
+    return session.SessionListener && session.SessionListener->OnPacketReceived(RTPacket(opCode, sender, payload, data));
+}
+
 }} /* namespace GameSparks.RT */
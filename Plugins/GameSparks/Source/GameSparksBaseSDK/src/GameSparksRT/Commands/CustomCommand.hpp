@@ -14,6 +14,7 @@ namespace GameSparks { namespace RT {
 		public:
 			static System::Failable<CustomCommand*> Deserialize(int opCode, int sender, System::IO::Stream& lps, const RTData& data, int limit, const IRTSessionInternal& session);
 			virtual void Execute() override;
+			virtual bool ExecuteOnReceive() override;
 		private:
 			CustomCommand(int opCode, int sender, const RTData& data, int limit, const IRTSessionInternal& session);
 			const IRTSessionInternal& session;
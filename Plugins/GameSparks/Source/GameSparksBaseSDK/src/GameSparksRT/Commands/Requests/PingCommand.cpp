@@ -4,7 +4,10 @@
 
 namespace Com { namespace Gamesparks { namespace Realtime { namespace Proto {
 
-PingCommand::PingCommand() : RTRequest(-2) {}
+PingCommand::PingCommand() : RTRequest(-2)
+{
+    intent = ::GameSparks::RT::GameSparksRT::DeliveryIntent::UNRELIABLE;
+}
 
 System::Failable<void> PingCommand::Serialize(System::IO::Stream &stream) const {
     GS_CALL_OR_THROW(PingCommand::Serialize(stream, *this));
@@ -12,8 +15,7 @@ System::Failable<void> PingCommand::Serialize(System::IO::Stream &stream) const
 }
 
 System::Failable<void> PingCommand::Serialize(System::IO::Stream &/*stream*/, const PingCommand &/*instance*/) {
-    assert(false); // not yet implemented (in C# SDK)
-    GS_PROGRAMMING_ERROR("should never be called");
+    // a ping has no fields, the op code is all the server needs
     return {};
 }
 
@@ -34,6 +34,7 @@ System::Failable<PingResult*> PingResult::Deserialize(System::IO::Stream& stream
 void PingResult::Execute() {
     assert(session);
     session->Log ("PingResult", GameSparks::RT::GameSparksRT::LogLevel::LL_DEBUG, "");
+    session->OnPingResult ();
 }
 
 bool PingResult::ExecuteAsync() {
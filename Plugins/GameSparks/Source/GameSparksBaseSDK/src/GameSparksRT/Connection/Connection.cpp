@@ -2,6 +2,7 @@
 #include "../Proto/Packet.hpp"
 #include "../Commands/CustomCommand.hpp"
 #include "../Commands/Results/AbstractResult.hpp"
+#include <GameSparks/GSProfiler.h>
 
 namespace GameSparks { namespace RT { namespace Connection {
 
@@ -27,6 +28,7 @@ Connection::Connection (const gsstl::string& remoteHost, const gsstl::string& po
 
 System::Failable<void> Connection::OnPacketReceived(Proto::Packet& p)
 {
+    GS_PROFILE_SCOPE("RTSession::OnPacketReceived");
     assert(session);
 
     if (p.Command != nullptr) {
@@ -40,7 +42,7 @@ System::Failable<void> Connection::OnPacketReceived(Proto::Packet& p)
             } else {
                 p.Command->Execute ();
             }
-        } else {
+        } else if (!p.Command->ExecuteOnReceive ()) {
             session->SubmitAction (p.Command);
         }
 
@@ -50,7 +52,9 @@ System::Failable<void> Connection::OnPacketReceived(Proto::Packet& p)
             System::IO::MemoryStream emptyStream;
             GS_ASSIGN_OR_THROW(tmp, CustomCommand::Deserialize(p.OpCode, p.Sender.GetValueOrDefault(0), emptyStream, p.Data, 0, *session));
             gsstl::unique_ptr<IRTCommand> cmd(tmp);
-            session->SubmitAction ( cmd );
+            if (!cmd->ExecuteOnReceive ()) {
+                session->SubmitAction ( cmd );
+            }
         }
     }
     return {};
@@ -5,30 +5,46 @@
 #include "./FastConnection.hpp"
 #include "../../System/Threading/Thread.hpp"
 #include "../../GameSparks/GSClientConfig.h"
+#include <GameSparks/GSProfiler.h>
 
 namespace System {class IAsyncResult;}
 
 namespace GameSparks { namespace RT { namespace Connection {
 
 FastConnection::FastConnection(const gsstl::string &remotehost, const gsstl::string& port,
-                               IRTSessionInternal *session, gsstl::recursive_mutex& sessionSendMutex)
+                               IRTSessionInternal *session, gsstl::recursive_mutex& sessionSendMutex_)
     : Connection(remotehost, port, session)
+#if GS_USE_SOCKET_REACTOR
+    , sessionSendMutex(sessionSendMutex_)
+#endif
 {
     callback = [this](const System::IAsyncResult& ar){Recv(ar);};
     client.EnableBroadcast(false);
     client.ExclusiveAddressUse(false);
     client.MulticastLoopback(false);
-    client.BeginConnect (remoteEndPoint, [this, &sessionSendMutex](const System::IAsyncResult& /*ar*/){
+#if GS_USE_SOCKET_REACTOR
+    client.BeginConnect (remoteEndPoint, [this](const System::IAsyncResult& /*ar*/){
+        {
+            gsstl::lock_guard<gsstl::recursive_mutex> lock(sessionMutex);
+            if (!this->session) return;
+        }
+        // the login is retried by a reactor timer, this connect thread exits right away
+        loginTimers.Schedule(System::Net::Sockets::SocketReactor::clock::duration::zero(), [this](){ DoLogin(); });
+        client.Client().BeginReceive (buffer, callback);
+    });
+#else
+    client.BeginConnect (remoteEndPoint, [this, &sessionSendMutex_](const System::IAsyncResult& /*ar*/){
 
         // we need to lock sessionSendMutex first to avoid ABA deadlock
         {
-            gsstl::lock_guard<gsstl::recursive_mutex> lock1(sessionSendMutex);
+            gsstl::lock_guard<gsstl::recursive_mutex> lock1(sessionSendMutex_);
             gsstl::lock_guard<gsstl::recursive_mutex> lock2(sessionMutex);
             if (!this->session) return;
             DoLogin ();
         }
         client.Client().BeginReceive (buffer, callback);
     });
+#endif
     //client.Connect (remoteEndPoint);
     //session->Log("FastConnection", GameSparksRT::LogLevel::DEBUG, "UDP Address=" + client.Client().LocalEndPoint);
     //client.Client().BeginReceive (buffer, 0, GameSparksRT::MAX_MESSAGE_SIZE_BYTES, 0, callback);
@@ -61,6 +77,49 @@ void FastConnection::StopInternal() {
     session = nullptr;
 }
 
+#if GS_USE_SOCKET_REACTOR
+FastConnection::~FastConnection()
+{
+    // the receive handler might still be running until client is torn down, it must not re-arm the timer.
+    loginTimers.Shutdown();
+}
+
+void FastConnection::DoLogin() {
+    // never block the reactor thread: the game thread might hold the send lock while it waits for this connection to stop.
+    gsstl::unique_lock<gsstl::recursive_mutex> lock1(sessionSendMutex, gsstl::try_to_lock);
+    if (!lock1.owns_lock())
+    {
+        loginTimers.Schedule(gsstl::chrono::milliseconds(1), [this](){ DoLogin(); });
+        return;
+    }
+
+    GS_TRY
+    {
+        gsstl::lock_guard<gsstl::recursive_mutex> lock2(sessionMutex);
+
+        if (session == nullptr || loginDone)
+            return;
+
+        if (session->GetConnectState() >= GameSparksRT::ConnectState::ReliableAndFastSend)
+        {
+            loginDone = true;
+            session->OnReady (true);
+            return;
+        }
+
+        Com::Gamesparks::Realtime::Proto::LoginCommand loginCmd(session->ConnectToken());
+        GS_CALL_OR_CATCH(Send (loginCmd));
+
+        // Recv() re-schedules us as soon as the LoginResult arrived, so this is only the retry interval.
+        auto mustConnectIn = GameSparks::Core::GSClientConfig::instance().ComputeSleepPeriod(loginAttempts++);
+        loginTimers.Schedule(
+            gsstl::chrono::duration_cast<System::Net::Sockets::SocketReactor::clock::duration>(gsstl::chrono::duration<float>(mustConnectIn)),
+            [this](){ DoLogin(); }
+        );
+    }
+    GS_CATCH(e) {(void)e;}
+}
+#else
 void FastConnection::DoLogin() {
     int attempts = 1;
 
@@ -96,7 +155,25 @@ void FastConnection::DoLogin() {
     }
     GS_CATCH(e) {(void)e;}
 }
+#endif /* GS_USE_SOCKET_REACTOR */
 
+#if GS_USE_SOCKET_REACTOR
+void FastConnection::Recv(const System::IAsyncResult& res)
+{
+    int read = client.Client().EndReceive(res);
+    if (read <= 0)
+        return;
+
+    ReadBuffer(read);
+
+    // a UDP LoginResult moves the session to ReliableAndFastSend, finish the login without waiting for the retry timer
+    gsstl::lock_guard<gsstl::recursive_mutex> lock(sessionMutex);
+    if (!loginDone && session != nullptr && session->GetConnectState() >= GameSparksRT::ConnectState::ReliableAndFastSend)
+    {
+        loginTimers.Schedule(System::Net::Sockets::SocketReactor::clock::duration::zero(), [this](){ DoLogin(); });
+    }
+}
+#else
 void FastConnection::Recv(const System::IAsyncResult& res)
 {
     GS_TRY
@@ -123,6 +200,7 @@ void FastConnection::Recv(const System::IAsyncResult& res)
         client.Client().BeginReceive (buffer, callback);
     }
 }
+#endif /* GS_USE_SOCKET_REACTOR */
 
 #if defined(__clang__)
 #   pragma clang diagnostic push
@@ -136,6 +214,8 @@ void FastConnection::Recv(const System::IAsyncResult& res)
 
 void FastConnection::ReadBuffer(int read)
 {
+    GS_PROFILE_SCOPE("RTSession::ReadPacket");
+
     GS_TRY
     {
 		gsstl::lock_guard<gsstl::recursive_mutex> lg(sessionMutex);
@@ -15,6 +15,9 @@ namespace GameSparks { namespace RT { namespace Connection {
 	{
 		public:
 			FastConnection (const gsstl::string& remotehost, const gsstl::string& port, IRTSessionInternal* session, gsstl::recursive_mutex& sessionSendMutex);
+#if GS_USE_SOCKET_REACTOR
+			virtual ~FastConnection();
+#endif
 			virtual System::Failable<int> Send(const Commands::RTRequest &request) override;
 			virtual void StopInternal() override;
 
@@ -25,6 +28,14 @@ namespace GameSparks { namespace RT { namespace Connection {
 			void ReadBuffer(int read);
 			System::Failable<void> SyncReceive();
 
+#if GS_USE_SOCKET_REACTOR
+			// declared before client, so that it outlives the receive handler during destruction
+			System::Net::Sockets::SocketReactor::TimerGroup loginTimers;
+			gsstl::recursive_mutex& sessionSendMutex;
+			int loginAttempts = 1;
+			bool loginDone = false;
+#endif
+
 			System::Net::Sockets::UdpClient client;
 
 			System::AsyncCallback callback;
@@ -3,6 +3,12 @@
 #include "./ReliableConnection.hpp"
 #include "../Commands/Requests/LoginCommand.hpp"
 #include "../Proto/PositionStream.hpp"
+#include <GameSparks/GSProfiler.h>
+#if GS_USE_SOCKET_REACTOR
+#	include "../../System/IO/MemoryStream.hpp"
+#	include "../../System/ObjectDisposedException.hpp"
+#	include "../Proto/ProtocolBufferException.hpp"
+#endif
 
 namespace GameSparks { namespace RT { namespace Connection {
 
@@ -88,6 +94,22 @@ void ReliableConnection::ConnectCallback(IAsyncResult /*result*/)
         return;
     }
 
+#if GS_USE_SOCKET_REACTOR
+    //Each time a tcp connection is established we re-authenticate
+    GS_TRY
+    {
+        LoginCommand loginCmd(session->ConnectToken());
+        GS_CALL_OR_CATCH(Send (loginCmd));
+    }
+    GS_CATCH(e)
+    {
+        OnDisconnected(e);
+        return;
+    }
+
+    // packets are read on the reactor thread from now on, this connect thread exits.
+    client.Client().BeginReceive(buffer, [this](const IAsyncResult& ar){ Recv(ar); });
+#else
     //Each time a tcp connection is established we re-authenticate
     GS_TRY
     {
@@ -147,7 +169,107 @@ void ReliableConnection::ConnectCallback(IAsyncResult /*result*/)
             session->OnReady (false);
         }
     }
+#endif /* GS_USE_SOCKET_REACTOR */
+}
+
+#if GS_USE_SOCKET_REACTOR
+void ReliableConnection::OnDisconnected(const System::Exception& e)
+{
+    gsstl::lock_guard<gsstl::recursive_mutex> lock(sessionMutex);
+    if (session != nullptr && !stopped) {
+        session->SetConnectState(GameSparksRT::ConnectState::Disconnected);
+        session->Log ("ReliableConnection", GameSparksRT::LogLevel::LL_DEBUG, e.Format());
+        session->OnReady (false);
+    }
+}
+
+void ReliableConnection::Recv(const IAsyncResult& res)
+{
+    int read = client.Client().EndReceive(res);
+    if (read <= 0)
+    {
+        OnDisconnected(System::ObjectDisposedException("Socket has closed or read error"));
+        return;
+    }
+
+    pending.insert(pending.end(), buffer.begin(), buffer.begin() + read);
+
+    auto result = ReadPendingPackets();
+    if (!result.isOK())
+    {
+        // the stream can't be resynchronized, drop it instead of buffering behind the broken packet
+        pending.clear();
+        OnDisconnected(result.GetException());
+        GS_TRY
+        {
+            client.Close();
+        }
+        GS_CATCH(e){(void)e;}
+    }
+}
+
+// GameSparksRT::MAX_MESSAGE_SIZE_BYTES only bounds datagrams, reliable packets may be larger. A length prefix above this is
+// taken for a corrupt stream, waiting for that many bytes would let pending grow without bound.
+static const uint64_t MAX_RELIABLE_PACKET_SIZE_BYTES = 64 * 1024;
+
+// sets size to the size of the first length delimited packet in bytes, including the varint length prefix, or to 0 if
+// the packet is not complete yet. returns false if the length prefix is above MAX_RELIABLE_PACKET_SIZE_BYTES.
+static bool complete_packet_size(const System::Bytes& bytes, size_t offset, size_t& size)
+{
+    size = 0;
+    uint64_t length = 0;
+    for (size_t i = offset, shift = 0; i < bytes.size(); ++i, shift += 7)
+    {
+        // a varint has at most 10 bytes, the length is checked on every byte as it only grows with the following ones
+        if (shift > 63)
+            return false;
+        length |= uint64_t(bytes[i] & 0x7f) << shift;
+        if (length > MAX_RELIABLE_PACKET_SIZE_BYTES)
+            return false;
+
+        if ((bytes[i] & 0x80) == 0)
+        {
+            size_t total = (i - offset + 1) + size_t(length);
+            size = bytes.size() - offset >= total ? total : 0;
+            return true;
+        }
+    }
+    return true;
+}
+
+System::Failable<void> ReliableConnection::ReadPendingPackets()
+{
+    size_t offset = 0;
+    size_t size = 0;
+    while (!stopped)
+    {
+        if (!complete_packet_size(pending, offset, size))
+            return Proto::ProtocolBufferException("Reliable packet larger than " + System::String::ToString(int(MAX_RELIABLE_PACKET_SIZE_BYTES)) + " bytes");
+        if (size == 0)
+            break;
+
+        System::IO::MemoryStream ms;
+        GS_CALL_OR_THROW(ms.Write(pending, int(offset), int(size)));
+        GS_CALL_OR_THROW(ms.Position(0));
+        offset += size;
+
+        PositionStream rss(ms);
+        Packet p;
+        {
+            gsstl::lock_guard<gsstl::recursive_mutex> lock(sessionMutex);
+            if (!session) break;
+            p = Packet(*session);
+        }
+
+        GS_ASSIGN_OR_THROW(ok, read(rss, p));
+        if (!ok) break;
+        GS_CALL_OR_THROW(OnPacketReceived(p));
+    }
+
+    pending.erase(pending.begin(), pending.begin() + offset);
+    return {};
 }
+#endif /* GS_USE_SOCKET_REACTOR */
 
 
 System::Failable<bool> ReliableConnection::read(PositionStream& stream, Packet& p)
@@ -156,6 +278,7 @@ System::Failable<bool> ReliableConnection::read(PositionStream& stream, Packet&
         return false;
     }
 
+    GS_PROFILE_SCOPE("RTSession::ReadPacket");
     GS_CALL_OR_THROW(Packet::DeserializeLengthDelimited (stream, stream.BinaryReader, p));
     //p.Session = session;
     p.Reliable = p.Reliable.GetValueOrDefault(true);
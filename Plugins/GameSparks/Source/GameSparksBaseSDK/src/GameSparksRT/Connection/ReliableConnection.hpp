@@ -19,6 +19,14 @@ namespace GameSparks { namespace RT { namespace Connection {
 		private:
 			void ConnectCallback(System::IAsyncResult result);
 			System::Failable<bool> read(PositionStream& stream, Proto::Packet& p);
+#if GS_USE_SOCKET_REACTOR
+			void Recv(const System::IAsyncResult& res);
+			System::Failable<void> ReadPendingPackets();
+			void OnDisconnected(const System::Exception& e);
+
+			System::Bytes buffer = System::Bytes(GameSparksRT::MAX_MESSAGE_SIZE_BYTES);
+			System::Bytes pending; // received bytes that do not form a complete packet yet
+#endif
 
 			System::Net::Sockets::TcpClient client;
 	};
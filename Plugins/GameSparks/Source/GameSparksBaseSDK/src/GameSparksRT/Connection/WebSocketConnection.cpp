@@ -5,6 +5,7 @@
 #include "./WebSocketConnection.hpp"
 #include "../Commands/Requests/LoginCommand.hpp"
 #include "../Proto/PositionStream.hpp"
+#include <GameSparks/GSProfiler.h>
 
 
 namespace GameSparks { namespace RT { namespace Connection {
@@ -166,6 +167,7 @@ System::Failable<bool> WebSocketConnection::read(PositionStream& stream, Packet&
 		return false;
 	}
 
+	GS_PROFILE_SCOPE("RTSession::ReadPacket");
 	GS_CALL_OR_THROW(Packet::DeserializeLengthDelimited(stream, stream.BinaryReader, p));
 	//p.Session = session;
 	p.Reliable = p.Reliable.GetValueOrDefault(true);
@@ -9,6 +9,9 @@ namespace GameSparks { namespace RT {
 			virtual void Execute () =0;
 			virtual ~IRTCommand() {}
 
+			//! called on the receive thread, returns true if the command is done and doesn't need to be queued for Execute
+			virtual bool ExecuteOnReceive () { return false; }
+
 			virtual class AbstractResult* asAbstractResult() { return nullptr; }
 		private:
 	};
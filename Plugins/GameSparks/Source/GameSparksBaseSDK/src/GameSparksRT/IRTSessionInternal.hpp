@@ -60,6 +60,8 @@ namespace GameSparks { namespace RT {
 			virtual bool ShouldExecute (int peerId, System::Nullable<int> sequence) = 0;
 			virtual void SubmitAction (gsstl::unique_ptr<IRTCommand>& action) =0;
 			virtual int NextSequenceNumber() = 0;
+			//! called on the receive thread when the answer to a PingCommand arrived
+			virtual void OnPingResult () = 0;
 
 			virtual void SetConnectState(GameSparksRT::ConnectState value) = 0;
 		private:
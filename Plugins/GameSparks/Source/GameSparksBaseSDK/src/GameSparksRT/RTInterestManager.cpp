@@ -0,0 +1,188 @@
+#include "../../include/GameSparksRT/RTInterestManager.hpp"
+#include "../../include/GameSparksRT/IRTSession.hpp"
+#include <GameSparks/GSProfiler.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace GameSparks { namespace RT {
+
+namespace InterestManager {
+    int64_t MakeCell(int32_t cx, int32_t cy)
+    {
+        return (int64_t(cx) << 32) | int64_t(uint32_t(cy));
+    }
+
+    int32_t CellX(int64_t cell) { return int32_t(cell >> 32); }
+    int32_t CellY(int64_t cell) { return int32_t(uint32_t(cell)); }
+
+    struct CompareCell
+    {
+        bool operator()(const gsstl::pair<int64_t, int>& a, int64_t cell) const { return a.first < cell; }
+        bool operator()(int64_t cell, const gsstl::pair<int64_t, int>& a) const { return cell < a.first; }
+    };
+
+    struct ComparePeer
+    {
+        bool operator()(const gsstl::pair<int, int64_t>& a, int peerId) const { return a.first < peerId; }
+    };
+}
+
+RTInterestManager::RTInterestManager()
+:RTInterestManager(Settings())
+{
+}
+
+RTInterestManager::RTInterestManager(const Settings& settings_)
+:settings(settings_)
+{
+    settings.CellSize = gsstl::max(settings.CellSize, 1.0f);
+    settings.NearCells = gsstl::max(settings.NearCells, 0);
+    settings.FarCells = gsstl::max(settings.FarCells, settings.NearCells);
+    settings.FarInterval = gsstl::max(settings.FarInterval, 1);
+    settings.MaxUpdatesPerPacket = gsstl::min(gsstl::max(settings.MaxUpdatesPerPacket, 1), int(GameSparksRT::MAX_RTDATA_SLOTS) - 1);
+}
+
+int64_t RTInterestManager::CellOf(float x, float y) const
+{
+    return InterestManager::MakeCell(int32_t(std::floor(x / settings.CellSize)), int32_t(std::floor(y / settings.CellSize)));
+}
+
+bool RTInterestManager::IsFarDue(int peerId) const
+{
+    // staggered, so that every flush carries about the same share of far peers
+    return (stats.Flushes + uint64_t(uint32_t(peerId))) % uint64_t(settings.FarInterval) == 0;
+}
+
+void RTInterestManager::SetPeerPosition(int peerId, float x, float y)
+{
+    auto it = gsstl::lower_bound(peerCells.begin(), peerCells.end(), peerId, InterestManager::ComparePeer());
+    if (it != peerCells.end() && it->first == peerId)
+        it->second = CellOf(x, y);
+    else
+        peerCells.insert(it, gsstl::make_pair(peerId, CellOf(x, y)));
+}
+
+void RTInterestManager::RemovePeer(int peerId)
+{
+    auto it = gsstl::lower_bound(peerCells.begin(), peerCells.end(), peerId, InterestManager::ComparePeer());
+    if (it != peerCells.end() && it->first == peerId)
+        peerCells.erase(it);
+}
+
+void RTInterestManager::QueueUpdate(float x, float y, const RTData& data)
+{
+    Update update;
+    update.cell = CellOf(x, y);
+    update.data = data;
+    queue.push_back(gsstl::move(update));
+}
+
+void RTInterestManager::BuildGrid(const gsstl::vector<int>& recipients)
+{
+    grid.clear();
+    unplaced.clear();
+    for (int peerId : recipients)
+    {
+        auto it = gsstl::lower_bound(peerCells.begin(), peerCells.end(), peerId, InterestManager::ComparePeer());
+        if (it != peerCells.end() && it->first == peerId)
+            grid.push_back(gsstl::make_pair(it->second, peerId));
+        else
+            unplaced.push_back(peerId);
+    }
+    gsstl::sort(grid.begin(), grid.end());
+}
+
+void RTInterestManager::CollectTargets(int64_t cell, gsstl::vector<int>& targets) const
+{
+    targets.assign(unplaced.begin(), unplaced.end());
+
+    int32_t cx = InterestManager::CellX(cell);
+    int32_t cy = InterestManager::CellY(cell);
+    for (int dx = -settings.FarCells; dx <= settings.FarCells; ++dx)
+    {
+        for (int dy = -settings.FarCells; dy <= settings.FarCells; ++dy)
+        {
+            bool isNear = gsstl::max(std::abs(dx), std::abs(dy)) <= settings.NearCells;
+            auto range = gsstl::equal_range(grid.begin(), grid.end(), InterestManager::MakeCell(cx + dx, cy + dy), InterestManager::CompareCell());
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (isNear || IsFarDue(it->second))
+                    targets.push_back(it->second);
+            }
+        }
+    }
+
+    gsstl::sort(targets.begin(), targets.end());
+}
+
+int RTInterestManager::Flush(IRTSession& session, int opCode, GameSparksRT::DeliveryIntent intent)
+{
+    GS_PROFILE_SCOPE("RTInterestManager::Flush");
+
+    stats.Flushes++;
+    if (queue.empty())
+        return 0;
+
+    gsstl::vector<int> recipients;
+    int self = session.PeerId.GetValueOrDefault(0);
+    for (int peerId : session.ActivePeers)
+    {
+        if (peerId != self)
+            recipients.push_back(peerId);
+    }
+    gsstl::sort(recipients.begin(), recipients.end());
+    BuildGrid(recipients);
+
+    // updates by target set, the empty set is the broadcast
+    gsstl::map<gsstl::vector<int>, gsstl::vector<size_t> > groups;
+    gsstl::vector<int> targets;
+    for (size_t i = 0; i != queue.size(); ++i)
+    {
+        CollectTargets(queue[i].cell, targets);
+
+        stats.Updates++;
+        stats.Deliveries += targets.size();
+        stats.Filtered += recipients.size() - targets.size();
+
+        if (targets.empty())
+            continue;
+        if (targets.size() == recipients.size())
+            targets.clear();
+        groups[targets].push_back(i);
+    }
+
+    int written = 0;
+    for (const auto& group : groups)
+    {
+        const gsstl::vector<size_t>& updates = group.second;
+        for (size_t first = 0; first < updates.size(); first += size_t(settings.MaxUpdatesPerPacket))
+        {
+            size_t count = gsstl::min(updates.size() - first, size_t(settings.MaxUpdatesPerPacket));
+
+            RTData packetData;
+            for (size_t j = 0; j != count; ++j)
+                packetData.SetData(uint(j + 1), queue[updates[first + j]].data);
+
+            int result = session.SendRTData(opCode, intent, packetData, group.first);
+            if (result > 0)
+                written += result;
+            stats.Packets++;
+        }
+    }
+
+    queue.clear();
+    return written;
+}
+
+void RTInterestManager::ReadUpdates(const RTData& packetData, gsstl::vector<RTData>& updates)
+{
+    for (uint slot = 1; slot < GameSparksRT::MAX_RTDATA_SLOTS; ++slot)
+    {
+        System::Nullable<RTData> update = packetData.GetData(slot);
+        if (!update.HasValue())
+            break;
+        updates.push_back(update.Value());
+    }
+}
+
+}} /* namespace GameSparks.RT */
@@ -0,0 +1,267 @@
+#include "./RTSendScheduler.hpp"
+#include <GameSparks/GSProfiler.h>
+
+namespace GameSparks { namespace RT {
+
+namespace SendScheduler {
+    // bytes per second
+    const float InitialRate = 16 * 1024;
+    const float MinRate = 2 * 1024;
+    const float MaxRate = 256 * 1024;
+    const float RateIncrease = 1024; // per ping answered in time
+    const float RateDecreaseOnDelay = 0.85f;
+    const float RateDecreaseOnLoss = 0.7f;
+
+    // a round trip time above MinRoundTripTime * DelayFactor + DelaySlack means the link is queueing
+    const float DelayFactor = 1.5f;
+    const float DelaySlack = 0.01f;
+
+    const float BurstSeconds = 0.1f;
+    const float PingInterval = 0.5f;
+    const float PingTimeout = 1.0f;
+
+    // updates per second a stream is slowed down to at most, unless it asked for less
+    const float MinStreamRate = 1.0f;
+    // assumed update size of a new stream
+    const float InitialUpdateBytes = 64;
+
+    template <typename Duration>
+    float Seconds(Duration d) { return gsstl::chrono::duration<float>(d).count(); }
+
+    RTSendScheduler::clock::duration Interval(float seconds)
+    {
+        return gsstl::chrono::duration_cast<RTSendScheduler::clock::duration>(gsstl::chrono::duration<float>(seconds));
+    }
+}
+
+RTSendScheduler::RTSendScheduler()
+:sendRate(SendScheduler::InitialRate)
+,tokens(SendScheduler::InitialRate * SendScheduler::BurstSeconds)
+,lastRefill(clock::now())
+,nextPing(clock::now())
+{
+}
+
+int RTSendScheduler::RegisterStream(const gsstl::string& name, int opCode, int priority, float targetRate)
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+
+    Stream stream;
+    stream.id = nextStreamId++;
+    stream.name = name;
+    stream.opCode = opCode;
+    stream.priority = priority;
+    stream.targetRate = gsstl::max(targetRate, 0.01f);
+    stream.rate = stream.targetRate;
+    stream.averageBytes = SendScheduler::InitialUpdateBytes;
+    stream.nextSend = clock::now();
+
+    // after the streams of the same priority, so that the older ones keep their share
+    auto it = gsstl::upper_bound(streams.begin(), streams.end(), priority, [](int p, const Stream& s){ return p > s.priority; });
+    streams.insert(it, gsstl::move(stream));
+
+    Reallocate();
+    return nextStreamId - 1;
+}
+
+void RTSendScheduler::UnregisterStream(int streamId)
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+    streams.erase(gsstl::remove_if(streams.begin(), streams.end(), [streamId](const Stream& s){ return s.id == streamId; }), streams.end());
+    Reallocate();
+}
+
+void RTSendScheduler::SetStreamState(int streamId, const RTData& data, const gsstl::vector<int>& targetPlayers)
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+    Stream* stream = FindStream(streamId);
+    if (!stream)
+        return;
+
+    if (stream->pending)
+        stream->dropped++;
+    stream->pending = true;
+    stream->data = data;
+    stream->targetPlayers = targetPlayers;
+}
+
+RTSendSchedulerStats RTSendScheduler::GetStats() const
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+
+    RTSendSchedulerStats stats;
+    stats.RoundTripTime = roundTripTime;
+    stats.Loss = loss;
+    stats.SendRate = sendRate;
+    for (const auto& stream : streams)
+    {
+        RTStreamStats streamStats;
+        streamStats.Name = stream.name;
+        streamStats.Priority = stream.priority;
+        streamStats.TargetRate = stream.targetRate;
+        streamStats.Rate = stream.rate;
+        streamStats.Sent = stream.sent;
+        streamStats.Dropped = stream.dropped;
+        stats.Streams.push_back(streamStats);
+    }
+    return stats;
+}
+
+bool RTSendScheduler::IsPingDue(clock::time_point now) const
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+    // nothing to adapt without streams
+    return !streams.empty() && !pingInFlight && now >= nextPing;
+}
+
+void RTSendScheduler::OnPingSent(clock::time_point now)
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+    pingInFlight = true;
+    pingSentAt = now;
+    nextPing = now + SendScheduler::Interval(SendScheduler::PingInterval);
+}
+
+void RTSendScheduler::OnPingResult(clock::time_point now)
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+
+    // unsolicited, or the answer to a ping that was already counted as lost
+    if (!pingInFlight)
+        return;
+    pingInFlight = false;
+
+    float sample = SendScheduler::Seconds(now - pingSentAt);
+    if (!pingAnswered)
+    {
+        pingAnswered = true;
+        roundTripTime = sample;
+        minRoundTripTime = sample;
+    }
+    else
+    {
+        roundTripTime += (sample - roundTripTime) / 8;
+        minRoundTripTime = gsstl::min(minRoundTripTime, sample);
+    }
+    loss *= 0.9f;
+
+    if (sample > minRoundTripTime * SendScheduler::DelayFactor + SendScheduler::DelaySlack)
+        DecreaseRate(SendScheduler::RateDecreaseOnDelay);
+    else
+        sendRate = gsstl::min(sendRate + SendScheduler::RateIncrease, SendScheduler::MaxRate);
+
+    Reallocate();
+}
+
+void RTSendScheduler::OnPingLost()
+{
+    pingInFlight = false;
+    loss = loss * 0.9f + 0.1f;
+
+    // servers that never answer pings must not throttle us down to MinRate
+    if (pingAnswered)
+    {
+        DecreaseRate(SendScheduler::RateDecreaseOnLoss);
+        Reallocate();
+    }
+}
+
+void RTSendScheduler::DecreaseRate(float factor)
+{
+    sendRate = gsstl::max(sendRate * factor, SendScheduler::MinRate);
+}
+
+void RTSendScheduler::Reallocate()
+{
+    float budget = sendRate;
+    for (auto& stream : streams)
+    {
+        float bytes = gsstl::max(stream.averageBytes, 1.0f);
+        float floor = gsstl::min(stream.targetRate, SendScheduler::MinStreamRate);
+        stream.rate = gsstl::max(gsstl::min(stream.targetRate, budget / bytes), floor);
+        budget = gsstl::max(budget - stream.rate * bytes, 0.0f);
+    }
+}
+
+void RTSendScheduler::Refill(clock::time_point now)
+{
+    float burst = gsstl::max(sendRate * SendScheduler::BurstSeconds, float(GameSparksRT::MAX_MESSAGE_SIZE_BYTES));
+    tokens = gsstl::min(tokens + sendRate * SendScheduler::Seconds(now - lastRefill), burst);
+    lastRefill = now;
+}
+
+RTSendScheduler::Stream* RTSendScheduler::FindStream(int streamId)
+{
+    for (auto& stream : streams)
+    {
+        if (stream.id == streamId)
+            return &stream;
+    }
+    return nullptr;
+}
+
+void RTSendScheduler::Update(clock::time_point now, IRTSession& session)
+{
+    GS_PROFILE_SCOPE("RTSendScheduler::Update");
+
+    gsstl::vector<Outgoing> outgoing;
+    {
+        gsstl::lock_guard<gsstl::mutex> lock(mutex);
+
+        if (pingInFlight && SendScheduler::Seconds(now - pingSentAt) > gsstl::max(SendScheduler::PingTimeout, 4 * roundTripTime))
+            OnPingLost();
+
+        Refill(now);
+
+        // the bucket may go negative by one update, the next refill pays it back
+        for (auto& stream : streams)
+        {
+            if (tokens <= 0)
+                break;
+            if (!stream.pending || now < stream.nextSend)
+                continue;
+
+            Outgoing out;
+            out.streamId = stream.id;
+            out.opCode = stream.opCode;
+            out.data = gsstl::move(stream.data);
+            out.targetPlayers.swap(stream.targetPlayers);
+            out.reservedBytes = stream.averageBytes;
+            outgoing.push_back(gsstl::move(out));
+
+            tokens -= stream.averageBytes;
+            stream.pending = false;
+            stream.nextSend = now + SendScheduler::Interval(1.0f / stream.rate);
+        }
+    }
+
+    if (outgoing.empty())
+        return;
+
+    for (auto& out : outgoing)
+        out.written = session.SendRTData(out.opCode, GameSparksRT::DeliveryIntent::UNRELIABLE_SEQUENCED, out.data, out.targetPlayers);
+
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+    for (const auto& out : outgoing)
+    {
+        // settle the reservation with what was actually written
+        tokens += out.reservedBytes - float(out.written);
+
+        Stream* stream = FindStream(out.streamId);
+        if (!stream)
+            continue;
+
+        if (out.written > 0)
+        {
+            stream->sent++;
+            stream->averageBytes += (float(out.written) - stream->averageBytes) / 8;
+        }
+        else
+        {
+            stream->dropped++;
+        }
+    }
+    Reallocate();
+}
+
+}} /* namespace GameSparks.RT */
@@ -0,0 +1,96 @@
+#ifndef _GAMESPARKSRT_RTSENDSCHEDULER_HPP_
+#define _GAMESPARKSRT_RTSENDSCHEDULER_HPP_
+
+#include "../../include/GameSparksRT/IRTSession.hpp"
+#include "../../include/GameSparksRT/RTData.hpp"
+
+namespace GameSparks { namespace RT {
+
+	/*!
+	 * Paces the state streams of IRTSession::RegisterStream().
+	 *
+	 * The send rate (bytes per second) is adapted like a congestion window: it grows additively with every ping answered
+	 * in time and shrinks multiplicatively when a ping is lost or its round trip time rises well above the smallest one
+	 * seen. Sends are paced by a token bucket refilled at that rate. Whenever the rate changes, it is handed out to the
+	 * streams by priority, each stream getting up to its target rate at its average update size.
+	 *
+	 * Thread safe: streams are set from the game thread, Update() runs wherever the session is updated and
+	 * OnPingResult() on the receive thread. Nothing is sent while the internal mutex is held.
+	 */
+	class RTSendScheduler
+	{
+		public:
+			typedef gsstl::chrono::steady_clock clock;
+
+			RTSendScheduler();
+
+			int RegisterStream(const gsstl::string& name, int opCode, int priority, float targetRate);
+			void UnregisterStream(int streamId);
+			void SetStreamState(int streamId, const RTData& data, const gsstl::vector<int>& targetPlayers);
+			RTSendSchedulerStats GetStats() const;
+
+			//! true if no ping is in flight and the next one is due
+			bool IsPingDue(clock::time_point now) const;
+			void OnPingSent(clock::time_point now);
+			void OnPingResult(clock::time_point now);
+
+			//! sends the due streams through session.SendRTData(), as far as the token bucket allows
+			void Update(clock::time_point now, IRTSession& session);
+
+		private:
+			struct Stream
+			{
+				int id;
+				gsstl::string name;
+				int opCode;
+				int priority;
+				float targetRate;
+				float rate;
+				float averageBytes;
+				bool pending = false;
+				RTData data;
+				gsstl::vector<int> targetPlayers;
+				clock::time_point nextSend;
+				uint64_t sent = 0;
+				uint64_t dropped = 0;
+			};
+
+			//! an update taken out of its stream, sent without holding the mutex
+			struct Outgoing
+			{
+				int streamId;
+				int opCode;
+				RTData data;
+				gsstl::vector<int> targetPlayers;
+				float reservedBytes;
+				int written = 0;
+			};
+
+			Stream* FindStream(int streamId);
+			void Refill(clock::time_point now);
+			void OnPingLost();
+			void DecreaseRate(float factor);
+			void Reallocate();
+
+			mutable gsstl::mutex mutex;
+
+			//! sorted by priority, highest first
+			gsstl::vector<Stream> streams;
+			int nextStreamId = 1;
+
+			float sendRate;
+			float tokens;
+			clock::time_point lastRefill;
+
+			bool pingInFlight = false;
+			bool pingAnswered = false;
+			clock::time_point pingSentAt;
+			clock::time_point nextPing;
+			float roundTripTime = 0;
+			float minRoundTripTime = 0;
+			float loss = 0;
+	};
+
+}} /* namespace GameSparks.RT */
+
+#endif /* _GAMESPARKSRT_RTSENDSCHEDULER_HPP_ */
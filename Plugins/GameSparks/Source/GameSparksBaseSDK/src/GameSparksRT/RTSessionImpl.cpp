@@ -1,5 +1,6 @@
 #include "./RTSessionImpl.hpp"
 #include "Commands/Requests/CustomRequest.hpp"
+#include "Commands/Requests/PingCommand.hpp"
 #include "Connection/FastConnection.hpp"
 #include "Connection/ReliableConnection.hpp"
 #include "Commands/LogCommand.hpp"
@@ -7,6 +8,7 @@
 #include "Commands/CommandFactory.hpp"
 #include "../System/Threading/Thread.hpp"
 #include "../GameSparks/GSClientConfig.h"
+#include <GameSparks/GSProfiler.h>
 #include <iostream>
 
 #if GS_RT_OVER_WS
@@ -84,6 +86,8 @@ int RTSessionImpl::SendRTDataAndBytes(int opCode, GameSparksRT::DeliveryIntent i
                                       const System::ArraySegment<System::Byte> &payload, const RTData &data,
                                       const gsstl::vector<int> &targetPlayers)
 {
+    GS_PROFILE_SCOPE("RTSession::Send");
+
     if(opCode == 0)
     {
         Log("IRTSession", GameSparksRT::LogLevel::LL_WARN, "opCode must be greater than zero.");
@@ -203,19 +207,96 @@ void RTSessionImpl::CheckConnection(){
 }
 
 void RTSessionImpl::Update() {
+    GS_PROFILE_SCOPE("RTSession::Update");
+
+    if(running)
+        CheckConnection();
+
+    DispatchCallbacks();
+
+    {
+        gsstl::lock_guard<gsstl::recursive_mutex> lock(sendMutex);
+        if(reliableConnection)
+        {
+            reliableConnection->Poll();
+        }
+    }
+
+    UpdateSendScheduler();
+}
+
+void RTSessionImpl::UpdateConnection() {
+    GS_PROFILE_SCOPE("RTSession::UpdateConnection");
+
     if(running)
         CheckConnection();
 
+    {
+        gsstl::lock_guard<gsstl::recursive_mutex> lock(sendMutex);
+        if(reliableConnection)
+        {
+            reliableConnection->Poll();
+        }
+    }
+
+    UpdateSendScheduler();
+}
+
+void RTSessionImpl::DispatchCallbacks() {
+    GS_PROFILE_SCOPE("RTSession::DispatchCallbacks");
+
     while(gsstl::unique_ptr<IRTCommand> toExecute = GetNextAction())
     {
         toExecute->Execute ();
     }
+}
 
-    gsstl::lock_guard<gsstl::recursive_mutex> lock(sendMutex);
-    if(reliableConnection)
+void RTSessionImpl::UpdateSendScheduler() {
+    // stream updates are unreliable, they must not end up queued on the reliable connection
+	#if GS_RT_OVER_WS
+    if(!running || GetConnectState() < GameSparksRT::ConnectState::ReliableOnly)
+        return;
+	#else
+    if(!running || GetConnectState() < GameSparksRT::ConnectState::ReliableAndFastSend)
+        return;
+	#endif
+
+    auto now = RTSendScheduler::clock::now();
+    if(sendScheduler.IsPingDue(now))
     {
-        reliableConnection->Poll();
+        Com::Gamesparks::Realtime::Proto::PingCommand ping;
+        gsstl::lock_guard<gsstl::recursive_mutex> lock(sendMutex);
+		#if GS_RT_OVER_WS
+        if(reliableConnection && reliableConnection->Send(ping).isOK())
+		#else
+        if(fastConnection && fastConnection->Send(ping).isOK())
+		#endif
+        {
+            sendScheduler.OnPingSent(now);
+        }
     }
+
+    sendScheduler.Update(now, *this);
+}
+
+int RTSessionImpl::RegisterStream(const gsstl::string& name, int opCode, int priority, float targetRate) {
+    return sendScheduler.RegisterStream(name, opCode, priority, targetRate);
+}
+
+void RTSessionImpl::UnregisterStream(int streamId) {
+    sendScheduler.UnregisterStream(streamId);
+}
+
+void RTSessionImpl::SetStreamState(int streamId, const RTData& data, const gsstl::vector<int>& targetPlayers) {
+    sendScheduler.SetStreamState(streamId, data, targetPlayers);
+}
+
+RTSendSchedulerStats RTSessionImpl::GetSendSchedulerStats() const {
+    return sendScheduler.GetStats();
+}
+
+void RTSessionImpl::OnPingResult() {
+    sendScheduler.OnPingResult(RTSendScheduler::clock::now());
 }
 
 void RTSessionImpl::DoLog(const gsstl::string &tag, GameSparks::RT::GameSparksRT::LogLevel level, const gsstl::string &msg) {
@@ -9,6 +9,7 @@
 #include "../../include/GameSparksRT/Forwards.hpp"
 #include "./IRTSessionInternal.hpp"
 #include "./IRTCommand.hpp"
+#include "./RTSendScheduler.hpp"
 
 #if defined(_DURANGO)
 #	define GS_RT_OVER_WS   1
@@ -41,6 +42,12 @@ namespace GameSparks { namespace RT {
     		virtual void Stop() override;
 			virtual void Start() override;
 			virtual void Update() override;
+			virtual void UpdateConnection() override;
+			virtual void DispatchCallbacks() override;
+			virtual int RegisterStream(const gsstl::string& name, int opCode, int priority, float targetRate) override;
+			virtual void UnregisterStream(int streamId) override;
+			virtual void SetStreamState(int streamId, const RTData& data, const gsstl::vector<int>& targetPlayers) override;
+			virtual RTSendSchedulerStats GetSendSchedulerStats() const override;
 			virtual gsstl::string ConnectToken() const override;
 			virtual void ConnectToken(const gsstl::string& token) override;
 			virtual gsstl::string FastPort() const override;
@@ -55,6 +62,7 @@ namespace GameSparks { namespace RT {
 			virtual void OnPlayerDisconnect(int peerId) override;
 			virtual void OnReady(bool ready) override;
 			virtual void OnPacket(const RTPacket &packet) override;
+			virtual void OnPingResult() override;
 
 
 			virtual GameSparksRT::ConnectState GetConnectState() const override;
@@ -64,6 +72,7 @@ namespace GameSparks { namespace RT {
 			virtual void DoLog(const gsstl::string &tag, GameSparks::RT::GameSparksRT::LogLevel level, const gsstl::string &msg) override;
 			void ResetSequenceForPeer (int peerId);
 			void CheckConnection();
+			void UpdateSendScheduler();
 			gsstl::unique_ptr<IRTCommand> GetNextAction();
 
 			// note: it's important, that those two are the first members so that they are created first and destroyed last.
@@ -92,6 +101,8 @@ namespace GameSparks { namespace RT {
 			GameSparksRT::ConnectState internalState = GameSparksRT::ConnectState::Disconnected;
 
 			gsstl::recursive_mutex sendMutex;
+
+			RTSendScheduler sendScheduler;
 	};
 
 }} /* namespace GameSparks.RT */
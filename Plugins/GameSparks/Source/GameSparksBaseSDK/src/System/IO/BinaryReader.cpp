@@ -2,6 +2,7 @@
 #include "EndOfStreamException.hpp"
 #include "../ArgumentException.hpp"
 #include "../ArgumentOutOfRangeException.hpp"
+#include <cstring>
 
 namespace System { namespace IO {
 
@@ -23,7 +24,9 @@ namespace System { namespace IO {
         System::Failable<float> BinaryReader::ReadSingle() {
             GS_CALL_OR_THROW(FillBuffer(4));
             uint tmpBuffer = (uint)(_buffer[0] | _buffer[1] << 8 | _buffer[2] << 16 | _buffer[3] << 24);
-            return *((float*)&tmpBuffer);
+            float value;
+            memcpy(&value, &tmpBuffer, sizeof(value));
+            return value;
         }
 
         System::Failable<double> BinaryReader::ReadDouble() {
@@ -34,7 +37,9 @@ namespace System { namespace IO {
                              _buffer[6] << 16 | _buffer[7] << 24);
 
             uint64_t tmpBuffer = ((uint64_t)hi) << 32 | lo;
-            return *((double*)&tmpBuffer);
+            double value;
+            memcpy(&value, &tmpBuffer, sizeof(value));
+            return value;
         }
 
         System::Failable<void> BinaryReader::FillBuffer(int numBytes) {
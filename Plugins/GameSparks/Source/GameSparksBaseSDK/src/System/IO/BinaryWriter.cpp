@@ -1,6 +1,7 @@
 //#include <iostream>
 #include "./BinaryWriter.hpp"
 #include "../ArgumentException.hpp"
+#include <cstring>
 
 namespace System { namespace IO {
 
@@ -25,7 +26,8 @@ namespace System { namespace IO {
                 assert(false);
             }
 
-            uint TmpValue = *(uint*)&value;
+            uint TmpValue;
+            memcpy(&TmpValue, &value, sizeof(TmpValue));
             _buffer[0] = (byte)TmpValue;
             _buffer[1] = (byte)(TmpValue >> 8);
             _buffer[2] = (byte)(TmpValue >> 16);
@@ -41,7 +43,8 @@ namespace System { namespace IO {
                 assert(false);
             }
 
-            uint64_t TmpValue = *(uint64_t*)&value;
+            uint64_t TmpValue;
+            memcpy(&TmpValue, &value, sizeof(TmpValue));
             _buffer[0] = (byte)TmpValue;
             _buffer[1] = (byte)(TmpValue >> 8);
             _buffer[2] = (byte)(TmpValue >> 16);
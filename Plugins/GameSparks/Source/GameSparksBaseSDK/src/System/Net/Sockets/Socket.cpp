@@ -87,6 +87,10 @@ void Socket::Close()
 {
     if(state == State::CONNECTED)
     {
+#if GS_USE_SOCKET_REACTOR
+        // no receive thread to wait for, just make sure the reactor is done with the socket
+        StopWatching();
+#else
         // wait for the recv to timeout
         while(isInsideInternalRecv)
         {
@@ -96,6 +100,7 @@ void Socket::Close()
             gsstl::this_thread::sleep_for(gsstl::chrono::milliseconds(1000/60));
 #endif
         }
+#endif
         mbedtls_net_free(&netCtx);
 
         state = State::CLOSED;
@@ -133,6 +138,14 @@ void Socket::Stop()
 void Socket::teardown()
 {
 	if (isTearingDown) return;
+
+#if GS_USE_SOCKET_REACTOR
+    {
+        gsstl::lock_guard<gsstl::mutex> lock(watchMutex);
+        isTearingDown = true;
+    }
+    StopWatching();
+#else
     isTearingDown = true;
 
     // wait for the recv to timeout
@@ -144,6 +157,7 @@ void Socket::teardown()
         gsstl::this_thread::sleep_for(gsstl::chrono::milliseconds(1000/60));
 #endif
     }
+#endif
 
 
 #if ((GS_TARGET_PLATFORM == GS_PLATFORM_IOS || GS_TARGET_PLATFORM == GS_PLATFORM_MAC) && defined(__UNREAL__))
@@ -328,6 +342,76 @@ struct AsyncReceiveResult : public IAsyncResult
 };
 
 
+#if GS_USE_SOCKET_REACTOR
+void Socket::BeginReceive(System::Bytes &buffer, const AsyncCallback &callback) {
+    assert(buffer.size() > 0);
+    assert(!this->receiveCallback); // you can't call BeginReceive twice
+    assert(!this->receiveBuffer);
+
+    gsstl::lock_guard<gsstl::mutex> lock(watchMutex);
+    if(isTearingDown)
+        return;
+
+    this->receiveCallback = callback;
+    this->receiveBuffer = &buffer;
+
+    // the reactor drains the socket until it would block, so it has to be non-blocking for both, UDP and TCP
+    mbedtls_net_set_nonblock(&netCtx);
+    isWatched = SocketReactor::Instance().Watch(netCtx.fd, [this](){ OnReadable(); });
+}
+
+
+void Socket::OnReadable()
+{
+    assert(receiveBuffer);
+    assert(receiveCallback);
+
+    // the callback might close the socket, so re-check isWatched on every iteration
+    while(!isTearingDown && isWatched)
+    {
+        AsyncReceiveResult ar;
+        ar.numBytesRead = internalRecvAvailable(receiveBuffer->data(), receiveBuffer->size());
+
+        if(ar.numBytesRead == MBEDTLS_ERR_SSL_WANT_READ)
+        {
+            return; // drained
+        }
+
+        if(ar.numBytesRead <= 0)
+        {
+            if(ar.numBytesRead < 0)
+                gsstl::cerr << "INFO: Socket read error: " << mbedtls_error_to_string(ar.numBytesRead) << gsstl::endl;
+
+            // stop dispatching - with level triggered events the closed socket would be reported over and over
+            StopWatching();
+            receiveCallback(ar);
+            return;
+        }
+
+        receiveCallback(ar);
+    }
+}
+
+
+void Socket::StopWatching()
+{
+    int fd = -1;
+    {
+        gsstl::lock_guard<gsstl::mutex> lock(watchMutex);
+        if(!isWatched)
+            return;
+        isWatched = false;
+        fd = netCtx.fd;
+    }
+    SocketReactor::Instance().Unwatch(fd);
+}
+
+
+int Socket::internalRecvAvailable(unsigned char *buf, size_t len)
+{
+    return mbedtls_net_recv(&netCtx, buf, len);
+}
+#else
 void Socket::BeginReceive(System::Bytes &buffer, const AsyncCallback &callback) {
     assert(buffer.size() > 0);
     if(protocolType == ProtocolType::Udp)
@@ -357,6 +441,7 @@ void Socket::BeginReceive(System::Bytes &buffer, const AsyncCallback &callback)
         mbedtls_net_set_nonblock(&netCtx);
     }
 }
+#endif /* GS_USE_SOCKET_REACTOR */
 
 
 int Socket::EndReceive(const System::IAsyncResult &res) {
@@ -466,6 +551,10 @@ Failable<void> Socket::Send(const System::Bytes &buffer, int offset, int size) {
 
 void Socket::Poll() {
     assert(protocolType == ProtocolType::Tcp);
+#if GS_USE_SOCKET_REACTOR
+    // receives are dispatched by the reactor
+    return;
+#endif
     if(receiveCallback)
     {
         assert(receiveBuffer);
@@ -15,6 +15,9 @@
 #include "../IPEndPoint.hpp"
 #include "../../Failable.hpp"
 #include "../../../../include/System/Bytes.hpp"
+#include "./SocketReactor.hpp"
+
+#include <atomic>
 
 namespace System {class IAsyncResult;}
 
@@ -40,6 +43,8 @@ namespace System { namespace Net { namespace Sockets {
                     const AsyncCallback& requestCallback
             );
 
+            /// with GS_USE_SOCKET_REACTOR the receive stays armed until the socket is closed and callback
+            /// is called on the reactor thread for every chunk read. A result <= 0 means the socket was closed.
             void BeginReceive(
                     System::Bytes& buffer,
                     const AsyncCallback& callback
@@ -66,6 +71,15 @@ namespace System { namespace Net { namespace Sockets {
 
         protected:
             virtual int internalRecv(unsigned char *buf, size_t len);
+#if GS_USE_SOCKET_REACTOR
+            /// reads without blocking. returns MBEDTLS_ERR_SSL_WANT_READ if no data is available.
+            virtual int internalRecvAvailable(unsigned char *buf, size_t len);
+            void OnReadable();
+            void StopWatching();
+
+            gsstl::mutex watchMutex; // serializes watching with a concurrent teardown
+            std::atomic<bool> isWatched{false}; // written under watchMutex, read without it by OnReadable()
+#endif
 			virtual bool Connect(const IPEndPoint& endpoint);
 
             enum class State
@@ -76,7 +90,7 @@ namespace System { namespace Net { namespace Sockets {
             };
             State state = State::CLOSED;
 			mbedtls_net_context netCtx;
-			volatile bool isTearingDown;
+			std::atomic<bool> isTearingDown;
 			AsyncCallback receiveCallback;
 			System::Bytes* receiveBuffer = nullptr;
 
@@ -0,0 +1,285 @@
+#include "./SocketReactor.hpp"
+
+#if GS_USE_SOCKET_REACTOR
+
+#include "../../Threading/Thread.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace System { namespace Net { namespace Sockets {
+
+enum { MAX_EVENTS_PER_WAKEUP = 64 };
+
+static uint64_t pack_event(int fd, uint32_t generation)
+{
+    return (uint64_t(generation) << 32) | uint32_t(fd);
+}
+
+SocketReactor& SocketReactor::Instance()
+{
+    static SocketReactor instance;
+    return instance;
+}
+
+SocketReactor::SocketReactor()
+:epollFd(epoll_create1(EPOLL_CLOEXEC))
+,wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+,running(true)
+,nextGeneration(1)
+,nextTimerSequence(0)
+,dispatchingFd(-1)
+,dispatchingGroup(nullptr)
+{
+    assert(epollFd >= 0);
+    assert(wakeFd >= 0);
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.u64 = pack_event(wakeFd, 0);
+    int result = epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+    (void)result;
+    assert(result == 0);
+
+    thread = gsstl::thread([this](){ Run(); });
+    threadId = thread.get_id();
+}
+
+SocketReactor::~SocketReactor()
+{
+    running = false;
+    Wakeup();
+
+    if(thread.joinable())
+        thread.join();
+
+    close(wakeFd);
+    close(epollFd);
+}
+
+bool SocketReactor::Watch(int fd, const Handler& onReadable)
+{
+    assert(fd >= 0);
+    assert(onReadable);
+
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+    assert(watchers.find(fd) == watchers.end()); // you can't watch a socket twice
+
+    Watcher watcher;
+    watcher.generation = nextGeneration++;
+    watcher.handler = gsstl::make_shared<Handler>(onReadable);
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN | EPOLLRDHUP;
+    ev.data.u64 = pack_event(fd, watcher.generation);
+    if(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0)
+    {
+        gsstl::clog << "ERROR: epoll_ctl(EPOLL_CTL_ADD) failed: " << errno << gsstl::endl;
+        return false;
+    }
+
+    watchers[fd] = watcher;
+    stats.watchedSockets = watchers.size();
+    return true;
+}
+
+void SocketReactor::Unwatch(int fd)
+{
+    gsstl::unique_lock<gsstl::mutex> lock(mutex);
+
+    auto it = watchers.find(fd);
+    if(it == watchers.end())
+        return;
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    watchers.erase(it);
+    stats.watchedSockets = watchers.size();
+
+    // events for fd that are already queued in the current epoll_wait batch are discarded by the generation check.
+    // a handler that is running right now still uses the socket, so we have to wait for it to return.
+    if(!IsReactorThread())
+    {
+        handlerDone.wait(lock, [this, fd](){ return dispatchingFd != fd; });
+    }
+}
+
+bool SocketReactor::IsReactorThread() const
+{
+    return gsstl::this_thread::get_id() == threadId;
+}
+
+SocketReactor::Stats SocketReactor::GetStats() const
+{
+    gsstl::lock_guard<gsstl::mutex> lock(mutex);
+    return stats;
+}
+
+void SocketReactor::Wakeup()
+{
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+void SocketReactor::Schedule(TimerGroup* group, clock::duration delay, const Handler& handler)
+{
+    assert(group);
+    assert(handler);
+
+    bool isEarliest = false;
+    {
+        gsstl::lock_guard<gsstl::mutex> lock(mutex);
+        if(group->isShutdown)
+            return;
+
+        Timer timer;
+        timer.group = group;
+        timer.handler = handler;
+
+        TimerKey key(clock::now() + delay, nextTimerSequence++);
+        timers[key] = timer;
+        isEarliest = timers.begin()->first == key;
+        stats.pendingTimers = timers.size();
+    }
+
+    // the loop might be sleeping with a timeout computed for a later deadline
+    if(isEarliest && !IsReactorThread())
+        Wakeup();
+}
+
+void SocketReactor::Cancel(TimerGroup* group)
+{
+    gsstl::unique_lock<gsstl::mutex> lock(mutex);
+    group->isShutdown = true;
+
+    for(auto it = timers.begin(); it != timers.end();)
+    {
+        if(it->second.group == group)
+            it = timers.erase(it);
+        else
+            ++it;
+    }
+    stats.pendingTimers = timers.size();
+
+    if(!IsReactorThread())
+    {
+        handlerDone.wait(lock, [this, group](){ return dispatchingGroup != group; });
+    }
+}
+
+void SocketReactor::FireDueTimers(gsstl::unique_lock<gsstl::mutex>& lock)
+{
+    auto now = clock::now();
+    while(!timers.empty() && timers.begin()->first.first <= now)
+    {
+        Timer timer = gsstl::move(timers.begin()->second);
+        timers.erase(timers.begin());
+        stats.pendingTimers = timers.size();
+
+        dispatchingGroup = timer.group;
+        lock.unlock();
+
+        auto start = clock::now();
+        timer.handler();
+        auto busy = clock::now() - start;
+
+        lock.lock();
+        dispatchingGroup = nullptr;
+        stats.firedTimers++;
+        stats.busyTime += busy;
+        handlerDone.notify_all();
+    }
+}
+
+void SocketReactor::Run()
+{
+    System::Threading::Thread::SetName("GS Socket Reactor");
+
+    epoll_event events[MAX_EVENTS_PER_WAKEUP];
+
+    while(running)
+    {
+        int timeout = -1;
+        {
+            gsstl::lock_guard<gsstl::mutex> lock(mutex);
+            if(!timers.empty())
+            {
+                auto remaining = timers.begin()->first.first - clock::now();
+                // round up, so that we do not wake up just before the deadline and spin
+                auto ms = gsstl::chrono::duration_cast<gsstl::chrono::milliseconds>(remaining + gsstl::chrono::microseconds(999)).count();
+                timeout = ms > 0 ? int(ms) : 0;
+            }
+        }
+
+        int n = epoll_wait(epollFd, events, MAX_EVENTS_PER_WAKEUP, timeout);
+        if(n < 0 && errno != EINTR)
+        {
+            gsstl::clog << "ERROR: epoll_wait failed: " << errno << gsstl::endl;
+            break;
+        }
+
+        gsstl::unique_lock<gsstl::mutex> lock(mutex);
+        stats.wakeups++;
+
+        for(int i = 0; i < n; ++i)
+        {
+            int fd = int(uint32_t(events[i].data.u64));
+            uint32_t generation = uint32_t(events[i].data.u64 >> 32);
+
+            if(fd == wakeFd)
+            {
+                uint64_t value;
+                ssize_t read_ = read(wakeFd, &value, sizeof(value));
+                (void)read_;
+                continue;
+            }
+
+            auto it = watchers.find(fd);
+            if(it == watchers.end() || it->second.generation != generation)
+                continue; // unwatched (and maybe re-used) while this batch was pending
+
+            auto handler = it->second.handler;
+            dispatchingFd = fd;
+            lock.unlock();
+
+            auto start = clock::now();
+            (*handler)();
+            auto busy = clock::now() - start;
+
+            lock.lock();
+            dispatchingFd = -1;
+            stats.dispatchedEvents++;
+            stats.busyTime += busy;
+            handlerDone.notify_all();
+        }
+
+        FireDueTimers(lock);
+    }
+}
+
+
+SocketReactor::TimerGroup::TimerGroup()
+:isShutdown(false)
+{
+}
+
+SocketReactor::TimerGroup::~TimerGroup()
+{
+    Shutdown();
+}
+
+void SocketReactor::TimerGroup::Schedule(clock::duration delay, const Handler& handler)
+{
+    SocketReactor::Instance().Schedule(this, delay, handler);
+}
+
+void SocketReactor::TimerGroup::Shutdown()
+{
+    SocketReactor::Instance().Cancel(this);
+}
+
+}}}
+
+#endif /* GS_USE_SOCKET_REACTOR */
@@ -0,0 +1,129 @@
+#ifndef _SYSTEM_NET_SOCKETS_SOCKETREACTOR_HPP_
+#define _SYSTEM_NET_SOCKETS_SOCKETREACTOR_HPP_
+
+#include <GameSparks/gsstl.h>
+
+/// if set to 1, sockets are driven by a single epoll event loop instead of a receive thread per socket.
+/// Sockets still resolve and connect on a short lived thread, but no thread is kept alive once connected.
+/// Only available on linux.
+#if !defined(GS_USE_SOCKET_REACTOR)
+#	define GS_USE_SOCKET_REACTOR 0
+#endif
+
+#if GS_USE_SOCKET_REACTOR && !defined(__linux__)
+#	error "GS_USE_SOCKET_REACTOR=1 requires epoll and is only supported on linux."
+#endif
+
+#if GS_USE_SOCKET_REACTOR
+
+#include <condition_variable>
+#include <cstdint>
+
+namespace System { namespace Net { namespace Sockets {
+
+	/*!
+	 * A single event loop that dispatches socket readiness and timers on one thread.
+	 *
+	 * Handlers run on the reactor thread and must not block; they may Watch()/Unwatch() sockets and
+	 * schedule timers themselves. Unwatch() and TimerGroup::Shutdown() wait for a handler of the same
+	 * socket/group that is currently executing (unless called from the reactor thread), so owners can be
+	 * destroyed safely right after they return.
+	 */
+	class SocketReactor
+	{
+		public:
+			typedef gsstl::function<void()> Handler;
+			typedef gsstl::chrono::steady_clock clock;
+
+			/// counters that can be sampled to measure how many sessions a single reactor thread sustains.
+			struct Stats
+			{
+				size_t watchedSockets = 0;
+				size_t pendingTimers = 0;
+				uint64_t wakeups = 0;
+				uint64_t dispatchedEvents = 0;
+				uint64_t firedTimers = 0;
+				clock::duration busyTime = clock::duration::zero(); ///< time spent inside handlers
+			};
+
+			/// a set of timers owned by one object. Destroying (or shutting down) the group cancels all of its timers.
+			class TimerGroup
+			{
+				public:
+					TimerGroup();
+					~TimerGroup();
+
+					/// schedules handler to run on the reactor thread after delay. Ignored after Shutdown().
+					void Schedule(clock::duration delay, const Handler& handler);
+
+					/// cancels all pending timers of this group and prevents new ones from being scheduled.
+					void Shutdown();
+				private:
+					friend class SocketReactor;
+					bool isShutdown;
+
+					TimerGroup(const TimerGroup&);
+					TimerGroup& operator=(const TimerGroup&);
+			};
+
+			static SocketReactor& Instance();
+
+			/// calls onReadable on the reactor thread whenever fd has data to read (level triggered).
+			bool Watch(int fd, const Handler& onReadable);
+
+			/// stops dispatching for fd. Must be called before the socket is closed.
+			void Unwatch(int fd);
+
+			bool IsReactorThread() const;
+
+			Stats GetStats() const;
+		private:
+			SocketReactor();
+			~SocketReactor();
+
+			void Run();
+			void Wakeup();
+			void Schedule(TimerGroup* group, clock::duration delay, const Handler& handler);
+			void Cancel(TimerGroup* group);
+			void FireDueTimers(gsstl::unique_lock<gsstl::mutex>& lock);
+
+			struct Watcher
+			{
+				uint32_t generation;
+				gsstl::shared_ptr<Handler> handler;
+			};
+
+			struct Timer
+			{
+				TimerGroup* group;
+				Handler handler;
+			};
+
+			// timers are ordered by deadline, the sequence number keeps insertion order for equal deadlines
+			typedef gsstl::pair<clock::time_point, uint64_t> TimerKey;
+
+			int epollFd;
+			int wakeFd;
+			volatile bool running;
+			gsstl::thread thread;
+			gsstl::thread::id threadId;
+
+			mutable gsstl::mutex mutex;
+			gsstl::condition_variable handlerDone;
+			gsstl::map<int, Watcher> watchers;
+			gsstl::map<TimerKey, Timer> timers;
+			uint32_t nextGeneration;
+			uint64_t nextTimerSequence;
+			int dispatchingFd;
+			TimerGroup* dispatchingGroup;
+			Stats stats;
+
+			SocketReactor(const SocketReactor&);
+			SocketReactor& operator=(const SocketReactor&);
+	};
+
+}}}
+
+#endif /* GS_USE_SOCKET_REACTOR */
+
+#endif /* _SYSTEM_NET_SOCKETS_SOCKETREACTOR_HPP_ */
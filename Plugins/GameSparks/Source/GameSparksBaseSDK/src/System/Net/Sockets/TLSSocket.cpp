@@ -184,5 +184,21 @@ namespace System { namespace Net { namespace Sockets {
 		return 0;
 	}
 
+#if GS_USE_SOCKET_REACTOR
+	int TLSSocket::internalRecvAvailable(unsigned char *buf, size_t len)
+	{
+		int result = mbedtls_ssl_read(&ssl, buf, len);
+
+		// a renegotiation might want to write, but both mean "try again once the socket is readable"
+		if (result == MBEDTLS_ERR_SSL_WANT_WRITE)
+			return MBEDTLS_ERR_SSL_WANT_READ;
+
+		if (result == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY)
+			return 0;
+
+		return result;
+	}
+#endif
+
 
 }}}
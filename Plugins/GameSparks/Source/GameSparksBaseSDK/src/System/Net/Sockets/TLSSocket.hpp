@@ -19,6 +19,9 @@ namespace System { namespace Net { namespace Sockets {
 		protected:
 			virtual bool Connect(const IPEndPoint& endpoint) override;
 			virtual int internalRecv(unsigned char *buf, size_t len) override;
+#if GS_USE_SOCKET_REACTOR
+			virtual int internalRecvAvailable(unsigned char *buf, size_t len) override;
+#endif
 
 			mbedtls_ssl_context ssl;
 			mbedtls_ssl_config conf;
@@ -94,6 +94,11 @@ static cJSON *cJSON_New_Item(void)
 	return node;
 }
 
+void cJSON_Free(void *ptr)
+{
+	cJSON_free(ptr);
+}
+
 /* Delete a cJSON structure. */
 void cJSON_Delete(cJSON *c)
 {
@@ -1,7 +1,8 @@
 #include "GameSparks/GSPlatformDeduction.h"
 #include "easywsclient/easywsclient.hpp"
 
-#if (GS_TARGET_PLATFORM == GS_PLATFORM_WIN32) && !(((GS_TARGET_PLATFORM == GS_PLATFORM_WIN32) && !GS_WINDOWS_DESKTOP) || GS_TARGET_PLATFORM == GS_PLATFORM_UWP || GS_TARGET_PLATFORM == GS_PLATFORM_XBOXONE)
+// the mbedtls based implementation is also used for linux desktop/server builds
+#if ((GS_TARGET_PLATFORM == GS_PLATFORM_WIN32) && !(((GS_TARGET_PLATFORM == GS_PLATFORM_WIN32) && !GS_WINDOWS_DESKTOP) || GS_TARGET_PLATFORM == GS_PLATFORM_UWP || GS_TARGET_PLATFORM == GS_PLATFORM_XBOXONE)) || (GS_TARGET_PLATFORM == GS_PLATFORM_LINUX)
 
 #include <mbedtls/entropy.h>
 #include <mbedtls/ctr_drbg.h>
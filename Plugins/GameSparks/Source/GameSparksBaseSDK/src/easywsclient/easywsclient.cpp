@@ -217,8 +217,9 @@ namespace { // private module-only namespace
 			{
                 socket->abort();
 				threading::thread_join(dns_thread);
-				delete socket;
 			}
+			// poll() joins the dns_thread once the connection is established, the socket still has to go
+			delete socket;
 #endif
         }
 
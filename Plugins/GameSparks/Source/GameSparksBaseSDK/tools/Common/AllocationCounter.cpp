@@ -0,0 +1,41 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// every heap allocation of the process goes through these replacements.
+
+namespace {
+    std::atomic<uint64_t> allocationCount(0);
+    std::atomic<uint64_t> allocatedBytes(0);
+    thread_local bool allocationsIgnored = false;
+}
+
+namespace GameSparks { namespace Tools {
+
+uint64_t AllocationCounter::Count() { return allocationCount.load(std::memory_order_relaxed); }
+uint64_t AllocationCounter::Bytes() { return allocatedBytes.load(std::memory_order_relaxed); }
+void AllocationCounter::IgnoreCurrentThread() { allocationsIgnored = true; }
+
+}} /* namespace GameSparks.Tools */
+
+void* operator new(size_t size)
+{
+    if (!allocationsIgnored)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { try { return operator new(size); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { try { return operator new(size); } catch (...) { return nullptr; } }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
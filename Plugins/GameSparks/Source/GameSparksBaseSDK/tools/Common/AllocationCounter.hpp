@@ -0,0 +1,23 @@
+#ifndef _GAMESPARKS_TOOLS_ALLOCATIONCOUNTER_HPP_
+#define _GAMESPARKS_TOOLS_ALLOCATIONCOUNTER_HPP_
+
+#include <cstdint>
+
+namespace GameSparks { namespace Tools {
+
+	/*!
+	 * Process wide accounting of operator new, implemented by replacing the global allocation functions in
+	 * AllocationCounter.cpp. Link that file into a tool to enable it. malloc() calls (cJSON, mbedtls) are not counted.
+	 */
+	struct AllocationCounter
+	{
+		static uint64_t Count();
+		static uint64_t Bytes();
+
+		/// stops counting allocations made by the calling thread, e.g. the thread of an in-process stand-in server
+		static void IgnoreCurrentThread();
+	};
+
+}} /* namespace GameSparks.Tools */
+
+#endif /* _GAMESPARKS_TOOLS_ALLOCATIONCOUNTER_HPP_ */
@@ -0,0 +1,81 @@
+#ifndef _GAMESPARKS_TOOLS_HISTOGRAM_HPP_
+#define _GAMESPARKS_TOOLS_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace GameSparks { namespace Tools {
+
+	/// log-linear histogram over nanoseconds: 16 sub buckets per power of two, i.e. values are accurate to ~6%.
+	class Histogram
+	{
+		public:
+			enum { SUB_BUCKET_BITS = 4, SUB_BUCKETS = 1 << SUB_BUCKET_BITS, BUCKETS = 64 * SUB_BUCKETS };
+
+			Histogram() : counts(BUCKETS, 0), total(0), sum(0), max(0) {}
+
+			void Record(int64_t ns)
+			{
+				uint64_t v = ns > 0 ? uint64_t(ns) : 0;
+				counts[Index(v)]++;
+				total++;
+				sum += v;
+				max = std::max(max, v);
+			}
+
+			void Merge(const Histogram& o)
+			{
+				for (size_t i = 0; i != counts.size(); ++i)
+					counts[i] += o.counts[i];
+				total += o.total;
+				sum += o.sum;
+				max = std::max(max, o.max);
+			}
+
+			uint64_t Count() const { return total; }
+			double MeanUs() const { return total ? double(sum) / double(total) / 1000.0 : 0.0; }
+			double MaxUs() const { return double(max) / 1000.0; }
+
+			double PercentileUs(double p) const
+			{
+				if (!total)
+					return 0.0;
+				uint64_t rank = uint64_t(p / 100.0 * double(total - 1)) + 1;
+				uint64_t seen = 0;
+				for (size_t i = 0; i != counts.size(); ++i)
+				{
+					seen += counts[i];
+					if (seen >= rank)
+						return double(std::min(UpperBound(i), max)) / 1000.0;
+				}
+				return MaxUs();
+			}
+		private:
+			static size_t Index(uint64_t v)
+			{
+				if (v < SUB_BUCKETS)
+					return size_t(v);
+				int msb = 63 - __builtin_clzll(v);
+				int shift = msb - SUB_BUCKET_BITS;
+				return size_t((shift + 1) * SUB_BUCKETS + int((v >> shift) & (SUB_BUCKETS - 1)));
+			}
+
+			static uint64_t UpperBound(size_t index)
+			{
+				if (index < SUB_BUCKETS)
+					return index;
+				int shift = int(index / SUB_BUCKETS) - 1;
+				uint64_t sub = index % SUB_BUCKETS;
+				return ((uint64_t(SUB_BUCKETS) | sub) << shift) + ((uint64_t(1) << shift) - 1);
+			}
+
+			std::vector<uint64_t> counts;
+			uint64_t total;
+			uint64_t sum;
+			uint64_t max;
+	};
+
+}} /* namespace GameSparks.Tools */
+
+#endif /* _GAMESPARKS_TOOLS_HISTOGRAM_HPP_ */
@@ -0,0 +1,66 @@
+#ifndef _GAMESPARKS_TOOLS_PROFILECAPTURE_HPP_
+#define _GAMESPARKS_TOOLS_PROFILECAPTURE_HPP_
+
+#include <GameSparks/GSLeakDetector.h>
+#include <GameSparks/GSProfiler.h>
+
+#include <iostream>
+#include <string>
+
+namespace GameSparks { namespace Tools {
+
+	/// records the GSProfiler scopes for its lifetime and writes <prefix>.json and <prefix>.trace.json when destroyed.
+	/// With GS_USE_LEAK_DETECTOR it also writes the AllocationProfiler report to <prefix>.allocations.json.
+	/// Does nothing for an empty prefix.
+	class ProfileCapture
+	{
+		public:
+			explicit ProfileCapture(const std::string& prefix_)
+			:prefix(prefix_)
+			{
+				#if GS_USE_PROFILER
+				if (!prefix.empty())
+				{
+					GameSparks::Util::Profiler::Reset();
+					GameSparks::Util::Profiler::StartTrace();
+					#if defined(GS_USE_LEAK_DETECTOR)
+					GameSparks::Util::AllocationProfiler::Reset();
+					#endif
+				}
+				#endif
+			}
+
+			~ProfileCapture()
+			{
+				#if GS_USE_PROFILER
+				if (prefix.empty())
+					return;
+
+				GameSparks::Util::Profiler::StopTrace();
+				GameSparks::Util::Profiler::SetEnabled(false);
+
+				if (GameSparks::Util::Profiler::WriteJSON(prefix + ".json") && GameSparks::Util::Profiler::WriteChromeTrace(prefix + ".trace.json"))
+					std::cout << "wrote " << prefix << ".json and " << prefix << ".trace.json" << std::endl;
+				else
+					std::cerr << "could not write the profile to " << prefix << ".json" << std::endl;
+
+				#if defined(GS_USE_LEAK_DETECTOR)
+				std::cout << GameSparks::Util::AllocationProfiler::Report(10);
+				if (!GameSparks::Util::AllocationProfiler::WriteJSON(prefix + ".allocations.json", 100))
+					std::cerr << "could not write " << prefix << ".allocations.json" << std::endl;
+				#endif
+				#else
+				if (!prefix.empty())
+					std::cerr << "the SDK was built without GS_USE_PROFILER, no profile written" << std::endl;
+				#endif
+			}
+		private:
+			std::string prefix;
+
+			ProfileCapture(const ProfileCapture&);
+			ProfileCapture& operator=(const ProfileCapture&);
+	};
+
+}} /* namespace GameSparks.Tools */
+
+#endif /* _GAMESPARKS_TOOLS_PROFILECAPTURE_HPP_ */
@@ -0,0 +1,662 @@
+/*
+ * Benchmarks for the GameSparks core SDK (GS, GSConnection and the generated request classes).
+ *
+ * Every benchmark runs a fresh GS instance against an in-process MockGSBackend over loopback, so a run needs no
+ * external service and its results only depend on the SDK, the machine and the backend options:
+ *
+ *     GSBenchmarks --benchmarks roundtrip,durable --latency-ms 2 --jitter-ms 1 --payload 1024 --json results.json
+ *
+ * roundtrip  LogEventRequest::Send() -> response callback, with --window requests in flight
+ * durable    SendDurable() cost while the persistent queue grows, then the time it takes to drain it
+ * dispatch   MockGSBackend::Push() -> ScriptMessage listener, plus the GS::Update() time spent per message
+ * json       GSObject::FromJSON() and GSData::GetJSON() on representative documents, without any networking
+ *
+ * The exit code is non-zero if a benchmark could not complete, so the suite can gate CI.
+ */
+
+#include <GameSparks/GS.h>
+#include <GameSparks/IGSPlatform.h>
+#include <GameSparks/generated/GSMessages.h>
+#include <GameSparks/generated/GSRequests.h>
+#include <GameSparks/generated/GSResponses.h>
+
+#include "MockGSBackend.hpp"
+#include "../Common/AllocationCounter.hpp"
+#include "../Common/Histogram.hpp"
+#include "../Common/ProfileCapture.hpp"
+
+#include <dirent.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GameSparks;
+using namespace GameSparks::Core;
+using namespace GameSparks::Api::Messages;
+using namespace GameSparks::Api::Requests;
+using namespace GameSparks::Api::Responses;
+using GameSparks::Tools::AllocationCounter;
+using GameSparks::Tools::Histogram;
+using GameSparks::Tools::MockGSBackend;
+using GameSparks::Tools::ProfileCapture;
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+
+const char* API_KEY = "benchmarkApiKey";
+const char* API_SECRET = "benchmarkApiSecret";
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+struct Settings
+{
+    std::vector<std::string> benchmarks = { "roundtrip", "durable", "dispatch", "json" };
+    int requests = 5000;
+    int window = 1;
+    Seconds requestTimeout = 5.0f;
+    int durable = 500;
+    std::string clientConfig = "{\"durableDrainInterval\":1,\"durableConcurrentRequests\":8}";
+    int messages = 5000;
+    int burst = 100;
+    int iterations = 20000;
+    int payload = 256;
+    double latencyMs = 0;
+    double jitterMs = 0;
+    double loss = 0;
+    double timeout = 60;
+    int updateHz = 0;
+    unsigned seed = 1;
+    int servePort = -1;
+    std::string json;
+    std::string profile;
+    bool verbose = false;
+};
+
+/// one line of the report
+struct Result
+{
+    std::string name;
+    bool completed = true;
+    uint64_t operations = 0;
+    double seconds = 0;
+    uint64_t allocations = 0;
+    Histogram latency;
+    std::vector<std::pair<std::string, double>> extra; ///< benchmark specific values, reported as is
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// SDK harness
+
+/// keeps the persistent storage of a run in its own temporary directory, so runs never see each others queues
+class BenchmarkPlatform : public IGSPlatform
+{
+    public:
+        BenchmarkPlatform(bool verbose)
+        :IGSPlatform(API_KEY, API_SECRET, true, verbose)
+        {
+            char pattern[] = "/tmp/gsbenchmarksXXXXXX";
+            if (mkdtemp(pattern))
+                directory = pattern;
+        }
+
+        ~BenchmarkPlatform()
+        {
+            if (directory.empty())
+                return;
+            if (DIR* dir = opendir(directory.c_str()))
+            {
+                while (dirent* entry = readdir(dir))
+                {
+                    if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+                        unlink((directory + "/" + entry->d_name).c_str());
+                }
+                closedir(dir);
+            }
+            rmdir(directory.c_str());
+        }
+
+        virtual gsstl::string GetSDK() const { return "GSBenchmarks"; }
+        virtual gsstl::string GetDeviceType() const { return "benchmark"; }
+        virtual gsstl::string GetDeviceId() const { return "benchmark-device"; }
+
+        virtual void DebugMsg(const gsstl::string& message) const
+        {
+            if (m_verboseLogging)
+                std::clog << "GS: " << message << std::endl;
+        }
+
+        virtual gsstl::string ToWritableLocation(gsstl::string desired_name) const
+        {
+            return directory + "/" + desired_name;
+        }
+    private:
+        std::string directory;
+};
+
+/// a GS instance driven like a game loop would: Update() with the real frame time, optionally capped to --update-hz
+class Client
+{
+    public:
+        Client(const Settings& settings_, const std::string& url_)
+        :settings(settings_)
+        ,url(url_)
+        ,platform(settings_.verbose)
+        ,updateNs(0)
+        {
+            platform.SetApiDomain(url);
+            gs.Initialise(&platform);
+            lastUpdate = Clock::now();
+        }
+
+        ~Client()
+        {
+            gs.ShutDown();
+        }
+
+        GS& Instance() { return gs; }
+
+        void Pump()
+        {
+            if (settings.updateHz > 0)
+                std::this_thread::sleep_until(lastUpdate + std::chrono::nanoseconds(1000000000 / settings.updateHz));
+
+            auto now = Clock::now();
+            Seconds delta = std::chrono::duration<Seconds>(now - lastUpdate).count();
+            lastUpdate = now;
+            gs.Update(delta);
+            updateNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - now).count();
+        }
+
+        /// pumps until done() returns true. Returns false if that did not happen within seconds.
+        bool PumpUntil(const std::function<bool()>& done, double seconds)
+        {
+            auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+            while (!done())
+            {
+                if (Clock::now() > deadline)
+                    return false;
+                Pump();
+            }
+            return true;
+        }
+
+        bool Connect()
+        {
+            if (PumpUntil([this](){ return gs.GetAvailable(); }, settings.timeout))
+                return true;
+            std::cerr << "could not connect to " << url << " within " << settings.timeout << "s" << std::endl;
+            return false;
+        }
+
+        /// time spent inside GS::Update() so far
+        int64_t UpdateNs() const { return updateNs; }
+    private:
+        const Settings& settings;
+        std::string url;
+        BenchmarkPlatform platform;
+        GS gs;
+        Clock::time_point lastUpdate;
+        int64_t updateNs;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// benchmarks
+
+Result RoundTrip(const Settings& settings, MockGSBackend& backend)
+{
+    Result result;
+    result.name = "roundtrip";
+
+    Client client(settings, backend.Url());
+    if (!client.Connect())
+    {
+        result.completed = false;
+        return result;
+    }
+
+    int sent = 0, completed = 0, errors = 0;
+    auto send = [&]()
+    {
+        int64_t start = NowNs();
+        LogEventRequest request(client.Instance());
+        request.SetEventKey("benchmark");
+        request.SetEventAttribute("sequence", sent);
+        request.Send([&, start](GS&, const LogEventResponse& response)
+        {
+            result.latency.Record(NowNs() - start);
+            completed++;
+            if (response.GetHasErrors())
+                errors++;
+        }, settings.requestTimeout);
+        sent++;
+    };
+
+    uint64_t allocationsStart = AllocationCounter::Count();
+    int64_t start = NowNs();
+    result.completed = client.PumpUntil([&]()
+    {
+        while (sent < settings.requests && sent - completed < settings.window)
+            send();
+        return completed == settings.requests;
+    }, settings.timeout);
+
+    result.seconds = double(NowNs() - start) / 1e9;
+    result.operations = uint64_t(completed);
+    result.allocations = AllocationCounter::Count() - allocationsStart;
+    result.extra.push_back(std::make_pair("errors", double(errors)));
+    return result;
+}
+
+Result Durable(const Settings& settings, MockGSBackend& backend)
+{
+    Result result;
+    result.name = "durable";
+
+    Client client(settings, backend.Url());
+    if (!client.Connect())
+    {
+        result.completed = false;
+        return result;
+    }
+    GS& gs = client.Instance();
+
+    // every SendDurable() rewrites the whole persistent queue, so the enqueue cost grows with the queue
+    Histogram enqueue;
+    int completed = 0;
+    uint64_t allocationsStart = AllocationCounter::Count();
+    gs.SetDurableQueueRunning(false);
+    for (int i = 0; i < settings.durable; ++i)
+    {
+        int64_t start = NowNs();
+        LogEventRequest request(gs);
+        request.SetEventKey("benchmark");
+        request.SetEventAttribute("sequence", i);
+        request.SetDurable(true);
+        request.Send([&](GS&, const LogEventResponse&){ completed++; });
+        enqueue.Record(NowNs() - start);
+    }
+    uint64_t enqueueAllocations = AllocationCounter::Count() - allocationsStart;
+
+    int64_t start = NowNs();
+    gs.SetDurableQueueRunning(true);
+    result.completed = client.PumpUntil([&](){ return gs.GetRequestQueueCount() == 0 && completed == settings.durable; }, settings.timeout);
+
+    result.seconds = double(NowNs() - start) / 1e9;
+    result.operations = uint64_t(completed);
+    result.allocations = AllocationCounter::Count() - allocationsStart - enqueueAllocations;
+    result.latency = enqueue; // ops/s is the drain rate, the latency columns are the SendDurable() cost
+    result.extra.push_back(std::make_pair("enqueueAllocationsPerRequest", settings.durable ? double(enqueueAllocations) / settings.durable : 0.0));
+    return result;
+}
+
+Result Dispatch(const Settings& settings, MockGSBackend& backend)
+{
+    Result result;
+    result.name = "dispatch";
+
+    Client client(settings, backend.Url());
+    if (!client.Connect())
+    {
+        result.completed = false;
+        return result;
+    }
+    GS& gs = client.Instance();
+
+    int received = 0;
+    gs.SetMessageListener<ScriptMessage>([&](GS&, const ScriptMessage& message)
+    {
+        long long sentNs = message.GetData().GetValueOrDefault(GSData()).GetLongLong("sentNs").GetValueOrDefault(0);
+        result.latency.Record(NowNs() - sentNs);
+        received++;
+    });
+
+    std::string payload(size_t(std::max(0, settings.payload)), 'x');
+    uint64_t allocationsStart = AllocationCounter::Count();
+    int64_t updateStart = client.UpdateNs();
+    int64_t start = NowNs();
+
+    // bursts keep the measured latency from being dominated by the backlog of a single huge push
+    int pushed = 0;
+    result.completed = client.PumpUntil([&]()
+    {
+        if (received == pushed && pushed < settings.messages)
+        {
+            for (int i = 0; i < settings.burst && pushed < settings.messages; ++i, ++pushed)
+            {
+                std::ostringstream message;
+                message << "{\"@class\":\".ScriptMessage\",\"extCode\":\"benchmark\",\"messageId\":\"m" << pushed
+                        << "\",\"data\":{\"sentNs\":" << NowNs() << ",\"payload\":\"" << payload << "\"}}";
+                backend.Push(message.str());
+            }
+        }
+        return received == settings.messages;
+    }, settings.timeout);
+
+    result.seconds = double(NowNs() - start) / 1e9;
+    result.operations = uint64_t(received);
+    result.allocations = AllocationCounter::Count() - allocationsStart;
+    result.extra.push_back(std::make_pair("updateUsPerMessage", received ? double(client.UpdateNs() - updateStart) / 1000.0 / received : 0.0));
+    return result;
+}
+
+std::string LargeDocument(int payloadBytes)
+{
+    std::ostringstream json;
+    json << "{\"@class\":\".LeaderboardDataResponse\",\"requestId\":\"1_1\",\"leaderboardShortCode\":\"benchmark\",\"data\":[";
+    for (int i = 0; i < 100; ++i)
+    {
+        json << (i ? "," : "") << "{\"userId\":\"user" << i << "\",\"userName\":\"player " << i << "\",\"rank\":" << i + 1
+             << ",\"score\":" << 100000 - i * 17 << ",\"when\":\"2020-01-01T00:00Z\",\"externalIds\":{\"FB\":\"" << i * 7919 << "\"}}";
+    }
+    json << "],\"scriptData\":{\"payload\":\"" << std::string(size_t(std::max(0, payloadBytes)), 'x') << "\"}}";
+    return json.str();
+}
+
+std::vector<Result> Json(const Settings& settings)
+{
+    std::string payload(size_t(std::max(0, settings.payload)), 'x');
+    std::vector<std::pair<std::string, std::string>> documents =
+    {
+        { "small", "{\"@class\":\".LogEventResponse\",\"requestId\":\"1571234567_42\"}" },
+        { "message", "{\"@class\":\".ScriptMessage\",\"extCode\":\"benchmark\",\"messageId\":\"m1\",\"data\":{\"sentNs\":1234567890123,\"payload\":\"" + payload + "\"}}" },
+        { "large", LargeDocument(settings.payload) },
+    };
+
+    std::vector<Result> results;
+    auto run = [&](const std::string& name, size_t bytes, const std::function<void()>& operation)
+    {
+        Result result;
+        result.name = name;
+        uint64_t allocationsStart = AllocationCounter::Count();
+        int64_t start = NowNs();
+        for (int i = 0; i < settings.iterations; ++i)
+        {
+            int64_t operationStart = NowNs();
+            operation();
+            result.latency.Record(NowNs() - operationStart);
+        }
+        result.seconds = double(NowNs() - start) / 1e9;
+        result.operations = uint64_t(settings.iterations);
+        result.allocations = AllocationCounter::Count() - allocationsStart;
+        result.extra.push_back(std::make_pair("bytes", double(bytes)));
+        results.push_back(result);
+    };
+
+    for (const auto& document : documents)
+    {
+        run("json parse " + document.first, document.second.size(), [&]()
+        {
+            GSObject parsed = GSObject::FromJSON(document.second);
+            (void)parsed;
+        });
+
+        GSObject parsed = GSObject::FromJSON(document.second);
+        run("json print " + document.first, document.second.size(), [&]()
+        {
+            gsstl::string json = parsed.GetJSON();
+            (void)json;
+        });
+    }
+
+    // the request side: building a request the way LogEventRequest does and serializing it, as GSConnection::SendImmediate does
+    run("json request", 0, [&]()
+    {
+        GSRequestData request;
+        request.AddString("@class", ".LogEventRequest");
+        request.AddString("eventKey", "benchmark");
+        request.AddNumber("score", 12345);
+        request.AddString("payload", payload);
+        request.AddString("requestId", "1571234567_42");
+        gsstl::string json = request.GetJSON();
+        (void)json;
+    });
+
+    return results;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// report
+
+void Report(const Settings& settings, const std::vector<Result>& results, const MockGSBackend& backend)
+{
+    std::cout << std::endl << std::left << std::setw(22) << "benchmark" << std::right << std::setw(10) << "count"
+              << std::setw(12) << "ops/s" << std::setw(10) << "mean us" << std::setw(10) << "p50 us" << std::setw(10) << "p90 us"
+              << std::setw(10) << "p99 us" << std::setw(10) << "max us" << std::setw(10) << "allocs/op" << std::endl;
+
+    std::cout << std::fixed;
+    for (const auto& result : results)
+    {
+        double ops = result.operations ? double(result.operations) : 1.0;
+        std::cout << std::left << std::setw(22) << result.name << std::right << std::setw(10) << result.operations
+                  << std::setprecision(0) << std::setw(12) << (result.seconds > 0 ? double(result.operations) / result.seconds : 0.0)
+                  << std::setprecision(1)
+                  << std::setw(10) << result.latency.MeanUs()
+                  << std::setw(10) << result.latency.PercentileUs(50)
+                  << std::setw(10) << result.latency.PercentileUs(90)
+                  << std::setw(10) << result.latency.PercentileUs(99)
+                  << std::setw(10) << result.latency.MaxUs()
+                  << std::setw(10) << double(result.allocations) / ops;
+        if (!result.completed)
+            std::cout << "  INCOMPLETE";
+        for (const auto& extra : result.extra)
+            std::cout << "  " << extra.first << "=" << std::setprecision(2) << extra.second;
+        std::cout << std::endl;
+    }
+
+    const MockGSBackend::Stats& stats = backend.GetStats();
+    std::cout << std::endl << "backend: " << stats.connections << " connections, " << stats.requests << " requests, " << stats.dropped
+              << " dropped, " << stats.messages << " messages, " << std::setprecision(1) << double(stats.threadCpuNs) / 1e6 << " ms cpu" << std::endl;
+
+    if (settings.json.empty())
+        return;
+
+    std::ofstream out(settings.json);
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"latencyMs\": " << settings.latencyMs << ",\n  \"jitterMs\": " << settings.jitterMs << ",\n  \"loss\": " << settings.loss
+        << ",\n  \"payloadBytes\": " << settings.payload << ",\n  \"benchmarks\": [";
+    bool first = true;
+    for (const auto& result : results)
+    {
+        double ops = result.operations ? double(result.operations) : 1.0;
+        out << (first ? "" : ",") << "\n    {\"name\": \"" << result.name << "\", \"completed\": " << (result.completed ? "true" : "false")
+            << ", \"operations\": " << result.operations << ", \"seconds\": " << result.seconds
+            << ", \"opsPerSecond\": " << (result.seconds > 0 ? double(result.operations) / result.seconds : 0.0)
+            << ", \"meanUs\": " << result.latency.MeanUs() << ", \"p50Us\": " << result.latency.PercentileUs(50)
+            << ", \"p90Us\": " << result.latency.PercentileUs(90) << ", \"p99Us\": " << result.latency.PercentileUs(99)
+            << ", \"maxUs\": " << result.latency.MaxUs() << ", \"allocationsPerOp\": " << double(result.allocations) / ops;
+        for (const auto& extra : result.extra)
+            out << ", \"" << extra.first << "\": " << extra.second;
+        out << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// command line
+
+void PrintUsage()
+{
+    std::cout <<
+        "usage: GSBenchmarks [options]\n"
+        "  --benchmarks <list>     comma separated subset of roundtrip,durable,dispatch,json (default all)\n"
+        "  --requests <n>          roundtrip: requests to send (default 5000)\n"
+        "  --window <n>            roundtrip: requests in flight (default 1)\n"
+        "  --request-timeout <s>   roundtrip: timeout passed to Send(), matters with --loss (default 5)\n"
+        "  --durable <n>           durable: requests to queue (default 500)\n"
+        "  --client-config <json>  clientConfig sent with the session (default drains 8 durable requests at a time every 1ms)\n"
+        "  --messages <n>          dispatch: messages to push (default 5000)\n"
+        "  --burst <n>             dispatch: messages pushed at once (default 100)\n"
+        "  --iterations <n>        json: iterations per document (default 20000)\n"
+        "  --payload <bytes>       size of the padding in responses, messages and json documents (default 256)\n"
+        "  --latency-ms <ms>       backend latency added to every response and message (default 0)\n"
+        "  --jitter-ms <ms>        uniformly distributed extra latency (default 0)\n"
+        "  --loss <ratio>          fraction of responses the backend drops (default 0)\n"
+        "  --timeout <s>           time limit per benchmark (default 60)\n"
+        "  --update-hz <n>         cap GS::Update() to n calls per second, 0 pumps as fast as possible (default 0)\n"
+        "  --serve <port>          only run the mock backend on port (0 picks one) until interrupted\n"
+        "  --seed <n>              random seed of the backend (default 1)\n"
+        "  --json <path>           also write the report as json\n"
+        "  --profile <prefix>      record the SDK scope timers, writes <prefix>.json and <prefix>.trace.json (chrome://tracing)\n"
+        "  --verbose               SDK and backend logging\n";
+}
+
+std::vector<std::string> Split(const std::string& s, char separator)
+{
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, separator))
+        parts.push_back(part);
+    return parts;
+}
+
+bool ParseArguments(int argc, char** argv, Settings& settings)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char*
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << arg << " needs a value" << std::endl;
+                exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--benchmarks") settings.benchmarks = Split(value(), ',');
+        else if (arg == "--requests") settings.requests = atoi(value());
+        else if (arg == "--window") settings.window = atoi(value());
+        else if (arg == "--request-timeout") settings.requestTimeout = Seconds(atof(value()));
+        else if (arg == "--durable") settings.durable = atoi(value());
+        else if (arg == "--client-config") settings.clientConfig = value();
+        else if (arg == "--messages") settings.messages = atoi(value());
+        else if (arg == "--burst") settings.burst = atoi(value());
+        else if (arg == "--iterations") settings.iterations = atoi(value());
+        else if (arg == "--payload") settings.payload = atoi(value());
+        else if (arg == "--latency-ms") settings.latencyMs = atof(value());
+        else if (arg == "--jitter-ms") settings.jitterMs = atof(value());
+        else if (arg == "--loss") settings.loss = atof(value());
+        else if (arg == "--timeout") settings.timeout = atof(value());
+        else if (arg == "--update-hz") settings.updateHz = atoi(value());
+        else if (arg == "--serve") settings.servePort = atoi(value());
+        else if (arg == "--seed") settings.seed = unsigned(atoi(value()));
+        else if (arg == "--json") settings.json = value();
+        else if (arg == "--profile") settings.profile = value();
+        else if (arg == "--verbose") settings.verbose = true;
+        else if (arg == "--help" || arg == "-h") { PrintUsage(); exit(0); }
+        else
+        {
+            std::cerr << "unknown option " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+    }
+
+    for (const auto& name : settings.benchmarks)
+    {
+        if (name != "roundtrip" && name != "durable" && name != "dispatch" && name != "json")
+        {
+            std::cerr << "unknown benchmark " << name << std::endl;
+            return false;
+        }
+    }
+    if (settings.requests <= 0 || settings.window <= 0 || settings.durable <= 0 || settings.messages <= 0 || settings.burst <= 0 || settings.iterations <= 0)
+    {
+        std::cerr << "--requests, --window, --durable, --messages, --burst and --iterations must be positive" << std::endl;
+        return false;
+    }
+    if (settings.loss < 0 || settings.loss >= 1)
+    {
+        std::cerr << "--loss must be in [0, 1)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+volatile sig_atomic_t interrupted = 0;
+
+} /* anonymous namespace */
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+    if (!ParseArguments(argc, argv, settings))
+        return 2;
+
+    MockGSBackend backend;
+    MockGSBackend::Options backendOptions;
+    backendOptions.apiSecret = API_SECRET;
+    backendOptions.latencyMs = settings.latencyMs;
+    backendOptions.jitterMs = settings.jitterMs;
+    backendOptions.lossRate = settings.loss;
+    backendOptions.payloadBytes = settings.payload;
+    backendOptions.clientConfig = settings.clientConfig;
+    backendOptions.seed = settings.seed;
+    backendOptions.verbose = settings.verbose;
+    backendOptions.onThreadStarted = &AllocationCounter::IgnoreCurrentThread;
+
+    if (settings.servePort >= 0)
+    {
+        backendOptions.bindAddress = "0.0.0.0";
+        backendOptions.port = settings.servePort;
+        if (!backend.Start(backendOptions))
+            return 1;
+        std::cout << "mock GameSparks backend listening on " << backend.Url() << " (api secret " << API_SECRET << ")" << std::endl;
+
+        signal(SIGINT, [](int){ interrupted = 1; });
+        signal(SIGTERM, [](int){ interrupted = 1; });
+        while (!interrupted)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        backend.Stop();
+        return 0;
+    }
+
+    if (!backend.Start(backendOptions))
+        return 1;
+
+    std::vector<Result> results;
+    {
+        ProfileCapture profile(settings.profile);
+        for (const auto& name : settings.benchmarks)
+        {
+            std::cout << "running " << name << "..." << std::endl;
+            if (name == "roundtrip") results.push_back(RoundTrip(settings, backend));
+            else if (name == "durable") results.push_back(Durable(settings, backend));
+            else if (name == "dispatch") results.push_back(Dispatch(settings, backend));
+            else
+            {
+                std::vector<Result> json = Json(settings);
+                results.insert(results.end(), json.begin(), json.end());
+            }
+        }
+    }
+
+    Report(settings, results, backend);
+    backend.Stop();
+
+    for (const auto& result : results)
+    {
+        if (!result.completed)
+            return 1;
+    }
+    return 0;
+}
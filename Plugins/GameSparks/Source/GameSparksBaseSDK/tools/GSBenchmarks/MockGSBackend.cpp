@@ -0,0 +1,678 @@
+#include "MockGSBackend.hpp"
+
+#include <GameSparks/GSUtil.h>
+#include <cjson/cJSON.h>
+#include <mbedtls/base64.h>
+#include <mbedtls/sha1.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+
+namespace GameSparks { namespace Tools {
+
+namespace {
+
+enum Opcode { TEXT_FRAME = 0x1, CLOSE = 0x8, PING = 0x9, PONG = 0xa };
+
+enum { MAX_READ = 65536, MAX_POLL_WAIT_MS = 50 };
+
+int64_t NowNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+int64_t ThreadCpuNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+bool SetNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool EndsWith(const std::string& s, const char* suffix)
+{
+    size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+/// server to client frames are never masked (RFC 6455 5.1)
+void AppendFrame(std::string& out, Opcode opcode, const std::string& payload)
+{
+    out.push_back(char(0x80 | opcode));
+    uint64_t n = payload.size();
+    if (n < 126)
+        out.push_back(char(n));
+    else if (n < 65536)
+    {
+        out.push_back(char(126));
+        out.push_back(char(n >> 8));
+        out.push_back(char(n));
+    }
+    else
+    {
+        out.push_back(char(127));
+        for (int shift = 56; shift >= 0; shift -= 8)
+            out.push_back(char(n >> shift));
+    }
+    out += payload;
+}
+
+/// the Sec-WebSocket-Accept value for the given Sec-WebSocket-Key. easywsclient does not verify it, browsers do.
+std::string AcceptKey(const std::string& key)
+{
+    std::string input = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    unsigned char digest[20];
+    mbedtls_sha1(reinterpret_cast<const unsigned char*>(input.data()), input.size(), digest);
+    unsigned char encoded[64];
+    size_t length = 0;
+    mbedtls_base64_encode(encoded, sizeof(encoded), &length, digest, sizeof(digest));
+    return std::string(reinterpret_cast<const char*>(encoded), length);
+}
+
+std::string HeaderValue(const std::string& request, const char* name)
+{
+    size_t nameLength = strlen(name);
+    size_t lineStart = request.find("\r\n");
+    while (lineStart != std::string::npos)
+    {
+        lineStart += 2;
+        size_t lineEnd = request.find("\r\n", lineStart);
+        if (lineEnd == std::string::npos || lineEnd == lineStart)
+            break;
+        if (lineEnd - lineStart > nameLength && request[lineStart + nameLength] == ':' && strncasecmp(request.c_str() + lineStart, name, nameLength) == 0)
+        {
+            size_t valueStart = request.find_first_not_of(' ', lineStart + nameLength + 1);
+            return request.substr(valueStart, lineEnd - valueStart);
+        }
+        lineStart = lineEnd;
+    }
+    return std::string();
+}
+
+std::string StringItem(cJSON* object, const char* name)
+{
+    cJSON* item = cJSON_GetObjectItem(object, name);
+    return (item && item->type == cJSON_String && item->valuestring) ? item->valuestring : "";
+}
+
+std::string Print(cJSON* object)
+{
+    char* text = cJSON_PrintUnformatted(object);
+    std::string result(text ? text : "");
+    cJSON_Free(text);
+    return result;
+}
+
+} /* anonymous namespace */
+
+
+struct MockGSBackend::Impl
+{
+    struct Scheduled
+    {
+        int64_t dueNs;
+        std::string frame;
+    };
+
+    struct Connection
+    {
+        int fd = -1;
+        bool upgraded = false;
+        bool authenticated = false;
+        bool closing = false;
+        std::string nonce;
+        std::string inbox;
+        std::string outbox;
+        std::deque<Scheduled> delayed; // frames waiting for their simulated latency, in send order
+    };
+
+    MockGSBackend& server;
+    int listenFd = -1;
+    int wakeFd = -1;
+    int nextSession = 1;
+
+    std::map<int, std::unique_ptr<Connection>> connections; // by fd
+    std::map<std::string, cJSON*> responses; // parsed Options::responses
+    cJSON* clientConfig = nullptr;
+    std::string payload;
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> uniform;
+
+    explicit Impl(MockGSBackend& server_)
+    :server(server_)
+    ,rng(server_.options.seed)
+    ,uniform(0.0, 1.0)
+    {
+    }
+
+    ~Impl()
+    {
+        for (auto& it : connections)
+            close(it.first);
+        if (listenFd >= 0) close(listenFd);
+        if (wakeFd >= 0) close(wakeFd);
+
+        for (auto& it : responses)
+            cJSON_Delete(it.second);
+        if (clientConfig)
+            cJSON_Delete(clientConfig);
+    }
+
+    bool Setup(const Options& options)
+    {
+        for (const auto& it : options.responses)
+        {
+            cJSON* response = cJSON_Parse(it.second.c_str());
+            if (!response || response->type != cJSON_Object)
+            {
+                std::cerr << "MockGSBackend: the response for " << it.first << " is not a json object" << std::endl;
+                if (response) cJSON_Delete(response);
+                return false;
+            }
+            responses[it.first] = response;
+        }
+
+        if (!options.clientConfig.empty())
+        {
+            clientConfig = cJSON_Parse(options.clientConfig.c_str());
+            if (!clientConfig || clientConfig->type != cJSON_Object)
+            {
+                std::cerr << "MockGSBackend: clientConfig is not a json object" << std::endl;
+                return false;
+            }
+        }
+
+        payload.assign(size_t(std::max(0, options.payloadBytes)), 'x');
+
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(uint16_t(options.port));
+        if (inet_pton(AF_INET, options.bindAddress.c_str(), &address.sin_addr) != 1)
+        {
+            std::cerr << "MockGSBackend: invalid bind address " << options.bindAddress << std::endl;
+            return false;
+        }
+
+        int one = 1;
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listenFd, 1024) != 0 || !SetNonBlocking(listenFd))
+        {
+            std::cerr << "MockGSBackend: could not listen on " << options.bindAddress << ":" << options.port << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeFd < 0)
+        {
+            std::cerr << "MockGSBackend: eventfd failed: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        socklen_t length = sizeof(address);
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        server.port = ntohs(address.sin_port);
+        return true;
+    }
+
+    void Wake()
+    {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    void Poll()
+    {
+        int64_t now = NowNs();
+        int64_t waitNs = int64_t(MAX_POLL_WAIT_MS) * 1000000;
+
+        std::vector<pollfd> fds;
+        fds.reserve(connections.size() + 2);
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wakeFd, POLLIN, 0});
+        for (auto& it : connections)
+        {
+            Connection& connection = *it.second;
+            fds.push_back({it.first, short(connection.outbox.empty() ? POLLIN : POLLIN | POLLOUT), 0});
+            if (!connection.delayed.empty())
+                waitNs = std::min(waitNs, std::max(int64_t(0), connection.delayed.front().dueNs - now));
+        }
+
+        // ppoll, because a millisecond timeout would round every simulated latency up
+        timespec timeout = { time_t(waitNs / 1000000000), long(waitNs % 1000000000) };
+        int n = ppoll(fds.data(), nfds_t(fds.size()), &timeout, nullptr);
+
+        if (n > 0)
+        {
+            if (fds[0].revents & POLLIN)
+                Accept();
+            if (fds[1].revents & POLLIN)
+            {
+                uint64_t value;
+                ssize_t ignored = read(wakeFd, &value, sizeof(value));
+                (void)ignored;
+            }
+            for (size_t i = 2; i < fds.size(); ++i)
+            {
+                if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                    continue;
+                auto it = connections.find(fds[i].fd);
+                if (it != connections.end())
+                    Receive(*it->second);
+            }
+        }
+
+        DeliverPushed();
+
+        now = NowNs();
+        for (auto& it : connections)
+        {
+            Connection& connection = *it.second;
+            while (!connection.delayed.empty() && connection.delayed.front().dueNs <= now)
+            {
+                connection.outbox += connection.delayed.front().frame;
+                connection.delayed.pop_front();
+            }
+            Flush(connection);
+        }
+
+        for (auto it = connections.begin(); it != connections.end();)
+        {
+            if (it->second->closing)
+            {
+                close(it->first);
+                it = connections.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    void Accept()
+    {
+        for (;;)
+        {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0)
+                return;
+
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            std::unique_ptr<Connection> connection(new Connection());
+            connection->fd = fd;
+            connections[fd] = std::move(connection);
+            server.stats.connections++;
+        }
+    }
+
+    void Receive(Connection& connection)
+    {
+        char buffer[MAX_READ];
+        for (;;)
+        {
+            ssize_t n = recv(connection.fd, buffer, sizeof(buffer), 0);
+            if (n > 0)
+            {
+                connection.inbox.append(buffer, size_t(n));
+                server.stats.bytesIn += uint64_t(n);
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                break;
+            connection.closing = true; // closed by the peer or a fatal error
+            return;
+        }
+
+        if (!connection.upgraded && !Upgrade(connection))
+            return;
+
+        size_t consumed = 0;
+        while (!connection.closing)
+        {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(connection.inbox.data()) + consumed;
+            size_t available = connection.inbox.size() - consumed;
+            if (available < 2)
+                break;
+
+            bool fin = (p[0] & 0x80) != 0;
+            int opcode = p[0] & 0x0f;
+            bool masked = (p[1] & 0x80) != 0;
+            uint64_t length = p[1] & 0x7f;
+            size_t header = 2;
+            if (length == 126)
+            {
+                if (available < 4) break;
+                length = (uint64_t(p[2]) << 8) | p[3];
+                header = 4;
+            }
+            else if (length == 127)
+            {
+                if (available < 10) break;
+                length = 0;
+                for (int i = 0; i < 8; ++i)
+                    length = (length << 8) | p[2 + i];
+                header = 10;
+            }
+            size_t maskOffset = header;
+            if (masked)
+                header += 4;
+            if (available < header || available - header < length)
+                break;
+
+            // easywsclient never fragments, so neither do we
+            if (!fin || opcode == 0)
+            {
+                if (server.options.verbose)
+                    std::clog << "MockGSBackend: fragmented frames are not supported" << std::endl;
+                connection.closing = true;
+                break;
+            }
+
+            std::string data(reinterpret_cast<const char*>(p) + header, size_t(length));
+            if (masked)
+            {
+                for (size_t i = 0; i != data.size(); ++i)
+                    data[i] = char(data[i] ^ p[maskOffset + (i & 3)]);
+            }
+            consumed += header + size_t(length);
+
+            switch (opcode)
+            {
+                case TEXT_FRAME: Handle(connection, data); break;
+                case PING: AppendFrame(connection.outbox, PONG, data); break;
+                case CLOSE:
+                    AppendFrame(connection.outbox, CLOSE, std::string());
+                    Flush(connection);
+                    connection.closing = true;
+                    break;
+                default: break;
+            }
+        }
+        connection.inbox.erase(0, consumed);
+    }
+
+    bool Upgrade(Connection& connection)
+    {
+        size_t end = connection.inbox.find("\r\n\r\n");
+        if (end == std::string::npos)
+            return false;
+
+        std::string request = connection.inbox.substr(0, end + 2);
+        connection.inbox.erase(0, end + 4);
+
+        std::string key = HeaderValue(request, "Sec-WebSocket-Key");
+        if (request.compare(0, 4, "GET ") != 0 || key.empty())
+        {
+            connection.outbox = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
+            Flush(connection);
+            connection.closing = true;
+            return false;
+        }
+
+        connection.outbox +=
+            "HTTP/1.1 101 Switching Protocols\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: " + AcceptKey(key) + "\r\n\r\n";
+        connection.upgraded = true;
+
+        // the service starts the handshake (see GS::Handshake)
+        char nonce[32];
+        snprintf(nonce, sizeof(nonce), "%08x%08x", unsigned(rng()), unsigned(rng()));
+        connection.nonce = nonce;
+
+        cJSON* response = cJSON_CreateObject();
+        cJSON_AddStringToObject(response, "@class", ".AuthenticatedConnectResponse");
+        cJSON_AddStringToObject(response, "nonce", nonce);
+        Send(connection, Print(response));
+        cJSON_Delete(response);
+        return true;
+    }
+
+    void Handle(Connection& connection, const std::string& text)
+    {
+        cJSON* request = cJSON_Parse(text.c_str());
+        if (!request || request->type != cJSON_Object)
+        {
+            // the SDK sends " " as keep alive
+            if (request) cJSON_Delete(request);
+            return;
+        }
+
+        std::string type = StringItem(request, "@class");
+        if (type == ".AuthenticatedConnectRequest")
+            Authenticate(connection, request);
+        else if (EndsWith(type, "Request"))
+            Respond(connection, type, request);
+        else if (server.options.verbose)
+            std::clog << "MockGSBackend: ignoring " << text << std::endl;
+
+        cJSON_Delete(request);
+    }
+
+    void Authenticate(Connection& connection, cJSON* request)
+    {
+        cJSON* response = cJSON_CreateObject();
+        cJSON_AddStringToObject(response, "@class", ".AuthenticatedConnectResponse");
+
+        const std::string& secret = server.options.apiSecret;
+        if (!secret.empty() && StringItem(request, "hmac") != GameSparks::Util::getHMAC(connection.nonce, secret))
+        {
+            cJSON* error = cJSON_CreateObject();
+            cJSON_AddStringToObject(error, "hmac", "INVALID");
+            cJSON_AddItemToObject(response, "error", error);
+            if (server.options.verbose)
+                std::clog << "MockGSBackend: rejected handshake with an invalid hmac" << std::endl;
+        }
+        else
+        {
+            char sessionId[32];
+            snprintf(sessionId, sizeof(sessionId), "mock-session-%d", nextSession++);
+            cJSON_AddStringToObject(response, "sessionId", sessionId);
+            cJSON_AddStringToObject(response, "authToken", "mock-auth-token");
+            cJSON_AddStringToObject(response, "userId", "mock-user");
+            if (clientConfig)
+                cJSON_AddItemToObject(response, "clientConfig", cJSON_Duplicate(clientConfig, 1));
+            connection.authenticated = true;
+            server.stats.handshakes++;
+        }
+
+        Send(connection, Print(response));
+        cJSON_Delete(response);
+    }
+
+    void Respond(Connection& connection, const std::string& type, cJSON* request)
+    {
+        server.stats.requests++;
+        if (server.options.lossRate > 0 && uniform(rng) < server.options.lossRate)
+        {
+            server.stats.dropped++;
+            return;
+        }
+
+        cJSON* response;
+        auto configured = responses.find(type);
+        if (configured != responses.end())
+        {
+            response = cJSON_Duplicate(configured->second, 1);
+        }
+        else
+        {
+            response = cJSON_CreateObject();
+            if (!payload.empty())
+            {
+                cJSON* scriptData = cJSON_CreateObject();
+                cJSON_AddStringToObject(scriptData, "payload", payload.c_str());
+                cJSON_AddItemToObject(response, "scriptData", scriptData);
+            }
+        }
+
+        if (!cJSON_GetObjectItem(response, "@class"))
+            cJSON_AddStringToObject(response, "@class", (type.substr(0, type.size() - strlen("Request")) + "Response").c_str());
+
+        std::string requestId = StringItem(request, "requestId");
+        if (!requestId.empty())
+        {
+            cJSON_DeleteItemFromObject(response, "requestId");
+            cJSON_AddStringToObject(response, "requestId", requestId.c_str());
+        }
+
+        Send(connection, Print(response));
+        cJSON_Delete(response);
+        server.stats.responses++;
+    }
+
+    void DeliverPushed()
+    {
+        std::vector<std::string> messages;
+        {
+            std::lock_guard<std::mutex> lock(server.pushMutex);
+            messages.swap(server.pushed);
+        }
+
+        for (const auto& message : messages)
+        {
+            for (auto& it : connections)
+            {
+                if (it.second->authenticated && !it.second->closing)
+                {
+                    Send(*it.second, message);
+                    server.stats.messages++;
+                }
+            }
+        }
+    }
+
+    void Send(Connection& connection, const std::string& text)
+    {
+        const Options& options = server.options;
+        if (options.latencyMs <= 0 && options.jitterMs <= 0)
+        {
+            AppendFrame(connection.outbox, TEXT_FRAME, text);
+            return;
+        }
+
+        int64_t due = NowNs() + int64_t((options.latencyMs + options.jitterMs * uniform(rng)) * 1e6);
+        // a websocket cannot reorder, so jitter only ever delays a frame behind its predecessor
+        if (!connection.delayed.empty())
+            due = std::max(due, connection.delayed.back().dueNs);
+
+        Scheduled scheduled;
+        scheduled.dueNs = due;
+        AppendFrame(scheduled.frame, TEXT_FRAME, text);
+        connection.delayed.push_back(std::move(scheduled));
+    }
+
+    void Flush(Connection& connection)
+    {
+        while (!connection.outbox.empty() && !connection.closing)
+        {
+            ssize_t n = ::send(connection.fd, connection.outbox.data(), connection.outbox.size(), MSG_NOSIGNAL);
+            if (n < 0)
+            {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                    connection.closing = true;
+                return;
+            }
+            server.stats.bytesOut += uint64_t(n);
+            connection.outbox.erase(0, size_t(n));
+        }
+    }
+};
+
+
+MockGSBackend::MockGSBackend()
+:impl(nullptr)
+,running(false)
+,port(0)
+{
+}
+
+MockGSBackend::~MockGSBackend()
+{
+    Stop();
+}
+
+bool MockGSBackend::Start(const Options& options_)
+{
+    assert(!impl);
+    options = options_;
+    impl = new Impl(*this);
+    if (!impl->Setup(options))
+    {
+        delete impl;
+        impl = nullptr;
+        return false;
+    }
+
+    running = true;
+    thread = std::thread([this](){ Run(); });
+    return true;
+}
+
+void MockGSBackend::Stop()
+{
+    running = false;
+    if (impl)
+        impl->Wake();
+    if (thread.joinable())
+        thread.join();
+    delete impl;
+    impl = nullptr;
+}
+
+void MockGSBackend::Push(const std::string& json)
+{
+    {
+        std::lock_guard<std::mutex> lock(pushMutex);
+        pushed.push_back(json);
+    }
+    if (impl)
+        impl->Wake();
+}
+
+std::string MockGSBackend::Url() const
+{
+    return "ws://" + (options.bindAddress == "0.0.0.0" ? std::string("127.0.0.1") : options.bindAddress) + ":" + std::to_string(port);
+}
+
+void MockGSBackend::Run()
+{
+    if (options.onThreadStarted)
+        options.onThreadStarted();
+
+    while (running)
+    {
+        impl->Poll();
+        stats.threadCpuNs = uint64_t(ThreadCpuNs());
+    }
+}
+
+}} /* namespace GameSparks.Tools */
@@ -0,0 +1,95 @@
+#ifndef _GAMESPARKS_TOOLS_MOCKGSBACKEND_HPP_
+#define _GAMESPARKS_TOOLS_MOCKGSBACKEND_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GameSparks { namespace Tools {
+
+	/*!
+	 * A loopback stand-in for the GameSparks websocket service, good enough to drive GS and GSConnection without any
+	 * external service.
+	 *
+	 * It speaks plain ws:// (point the SDK at it with IGSPlatform::SetApiDomain(backend.Url())), sends the nonce on
+	 * connect, answers the .AuthenticatedConnectRequest sent by GS::SendHandshake with a session and answers every
+	 * ".<Name>Request" with a ".<Name>Response" carrying the same requestId. Responses can be delayed, dropped and
+	 * padded, and messages can be pushed to all authenticated connections with Push().
+	 *
+	 * Everything runs on a single poll() loop. Only linux is supported.
+	 */
+	class MockGSBackend
+	{
+		public:
+			struct Options
+			{
+				std::string bindAddress = "127.0.0.1";
+				int port = 0; ///< 0 picks a free one
+				std::string apiSecret; ///< if not empty, the hmac of the handshake is checked against it
+				double latencyMs = 0; ///< added to every response and pushed message
+				double jitterMs = 0; ///< uniformly distributed on top of latencyMs. Frames of one connection stay in order
+				double lossRate = 0; ///< fraction of responses that are never sent (the handshake is never dropped)
+				int payloadBytes = 0; ///< length of the scriptData.payload string added to default responses
+				std::map<std::string, std::string> responses; ///< request @class -> json object to answer with instead of the default
+				std::string clientConfig; ///< json object sent as clientConfig with the session, e.g. {"durableDrainInterval":0}
+				unsigned seed = 1;
+				bool verbose = false;
+				std::function<void()> onThreadStarted; ///< called on the server thread before the loop starts
+			};
+
+			struct Stats
+			{
+				std::atomic<uint64_t> connections{0};
+				std::atomic<uint64_t> handshakes{0};
+				std::atomic<uint64_t> requests{0};
+				std::atomic<uint64_t> responses{0};
+				std::atomic<uint64_t> dropped{0};
+				std::atomic<uint64_t> messages{0};
+				std::atomic<uint64_t> bytesIn{0};
+				std::atomic<uint64_t> bytesOut{0};
+				std::atomic<uint64_t> threadCpuNs{0}; ///< cpu time consumed by the server thread
+			};
+
+			MockGSBackend();
+			~MockGSBackend();
+
+			/// binds the socket and starts the server thread. Returns false (and logs why) if it could not bind.
+			bool Start(const Options& options);
+			void Stop();
+
+			/// queues a message (a json object whose @class ends with "Message") for every authenticated connection. Thread safe.
+			void Push(const std::string& json);
+
+			int Port() const { return port; }
+
+			/// the value to pass to IGSPlatform::SetApiDomain
+			std::string Url() const;
+
+			const Stats& GetStats() const { return stats; }
+		private:
+			struct Impl;
+
+			void Run();
+
+			Impl* impl;
+			Options options;
+			std::thread thread;
+			std::atomic<bool> running;
+			int port;
+			Stats stats;
+
+			std::mutex pushMutex;
+			std::vector<std::string> pushed;
+
+			MockGSBackend(const MockGSBackend&);
+			MockGSBackend& operator=(const MockGSBackend&);
+	};
+
+}} /* namespace GameSparks.Tools */
+
+#endif /* _GAMESPARKS_TOOLS_MOCKGSBACKEND_HPP_ */
@@ -0,0 +1,906 @@
+#include "LocalRTServer.hpp"
+
+#include <mbedtls/certs.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/x509_crt.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#if !defined(MBEDTLS_SSL_SRV_C)
+#	error "LocalRTServer needs MBEDTLS_SSL_SRV_C, build it through GameSparksBaseSDK/CMakeLists.txt"
+#endif
+
+namespace GameSparks { namespace Tools {
+
+namespace {
+
+// see GameSparksRT/Commands/CommandFactory.hpp and the RTRequest subclasses
+enum OpCode
+{
+    LoginCommand = 0,
+    LoginResult = -1,
+    PingCommand = -2,
+    PingResult = -3,
+    UDPConnectMessage = -5,
+    PlayerConnectMessage = -101,
+    PlayerDisconnectMessage = -103
+};
+
+enum { MAX_TLS_RECORD = 16384, MAX_DATAGRAM = 65536, MAX_UDP_QUEUE_MS = 200 };
+
+typedef std::chrono::steady_clock Clock;
+
+typedef std::string Buffer;
+
+void WriteVarint(Buffer& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(char(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+bool ReadVarint(const char*& p, const char* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7)
+    {
+        uint8_t b = uint8_t(*p++);
+        value |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/// the fields of Proto::Packet the relay needs. RTData and the payload are passed through as raw bytes.
+struct WirePacket
+{
+    int opCode = 0;
+    bool hasSequence = false;
+    uint64_t sequence = 0;
+    std::vector<int> targets;
+    bool hasReliable = false;
+    bool reliable = false;
+    Buffer data;
+    bool hasPayload = false;
+    Buffer payload;
+};
+
+bool Decode(const char* p, const char* end, WirePacket& packet)
+{
+    while (p < end)
+    {
+        uint64_t key;
+        if (!ReadVarint(p, end, key))
+            return false;
+
+        uint32_t field = uint32_t(key >> 3);
+        switch (key & 7)
+        {
+            case 0:
+            {
+                uint64_t value;
+                if (!ReadVarint(p, end, value))
+                    return false;
+                switch (field)
+                {
+                    case 1: packet.opCode = int(uint32_t(value) >> 1) ^ -int(value & 1); break;
+                    case 2: packet.hasSequence = true; packet.sequence = value; break;
+                    case 4: packet.targets.push_back(int(value)); break;
+                    case 6: packet.hasReliable = true; packet.reliable = value != 0; break;
+                    default: break; // RequestId and Sender are owned by the server
+                }
+                break;
+            }
+            case 1:
+                if (end - p < 8) return false;
+                p += 8;
+                break;
+            case 5:
+                if (end - p < 4) return false;
+                p += 4;
+                break;
+            case 2:
+            {
+                uint64_t length;
+                if (!ReadVarint(p, end, length) || uint64_t(end - p) < length)
+                    return false;
+                if (field == 14)
+                    packet.data.assign(p, size_t(length));
+                else if (field == 15)
+                {
+                    packet.hasPayload = true;
+                    packet.payload.assign(p, size_t(length));
+                }
+                p += length;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/// appends packet to out in the length delimited format Packet::DeserializeLengthDelimited expects.
+void Encode(Buffer& out, Buffer& scratch, const WirePacket& packet, int sender)
+{
+    scratch.clear();
+    scratch.push_back(8);
+    WriteVarint(scratch, (uint32_t(packet.opCode) << 1) ^ uint32_t(packet.opCode >> 31));
+    if (packet.hasSequence)
+    {
+        scratch.push_back(16);
+        WriteVarint(scratch, packet.sequence);
+    }
+    if (sender != 0)
+    {
+        scratch.push_back(40);
+        WriteVarint(scratch, uint64_t(sender));
+    }
+    if (packet.hasReliable)
+    {
+        scratch.push_back(48);
+        WriteVarint(scratch, packet.reliable ? 1 : 0);
+    }
+    scratch.push_back(114);
+    WriteVarint(scratch, packet.data.size());
+    scratch += packet.data;
+    // system messages always carry a (possibly empty) payload, otherwise the client treats them as custom packets
+    if (packet.hasPayload)
+    {
+        scratch.push_back(char(122));
+        WriteVarint(scratch, packet.payload.size());
+        scratch += packet.payload;
+    }
+
+    WriteVarint(out, scratch.size());
+    out += scratch;
+}
+
+std::string ReadLoginToken(const Buffer& payload)
+{
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    while (p < end)
+    {
+        uint64_t key, value;
+        if (!ReadVarint(p, end, key))
+            break;
+        if ((key & 7) == 2)
+        {
+            if (!ReadVarint(p, end, value) || uint64_t(end - p) < value)
+                break;
+            if ((key >> 3) == 1)
+                return std::string(p, size_t(value));
+            p += value;
+        }
+        else if ((key & 7) == 0)
+        {
+            if (!ReadVarint(p, end, value))
+                break;
+        }
+        else
+            break;
+    }
+    return std::string();
+}
+
+uint64_t AddressKey(const sockaddr_in& address)
+{
+    return (uint64_t(address.sin_addr.s_addr) << 16) | address.sin_port;
+}
+
+int64_t ThreadCpuNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+int BioSend(void* ctx, const unsigned char* buf, size_t len)
+{
+    ssize_t n = ::send(*static_cast<int*>(ctx), buf, len, MSG_NOSIGNAL);
+    if (n < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? MBEDTLS_ERR_SSL_WANT_WRITE : -1;
+    return int(n);
+}
+
+int BioRecv(void* ctx, unsigned char* buf, size_t len)
+{
+    ssize_t n = ::recv(*static_cast<int*>(ctx), buf, len, 0);
+    if (n < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? MBEDTLS_ERR_SSL_WANT_READ : -1;
+    return int(n);
+}
+
+bool SetNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+} /* anonymous namespace */
+
+
+struct LocalRTServer::Impl
+{
+    struct Room;
+
+    struct Peer
+    {
+        int fd = -1;
+        mbedtls_ssl_context ssl;
+        bool handshakeDone = false;
+        bool closing = false;
+        Buffer inbox;
+        Buffer outbox;
+        size_t pendingWrite = 0; // mbedtls_ssl_write has to be repeated with the same length after WANT_WRITE
+        Room* room = nullptr;
+        int peerId = 0;
+        std::string reconnectToken;
+        bool hasUdp = false;
+        sockaddr_in udpAddress;
+        Clock::time_point udpBusyUntil; ///< Options::udpBandwidth
+    };
+
+    struct Room
+    {
+        std::map<int, Peer*> peers;
+        int nextPeerId = 1;
+    };
+
+    LocalRTServer& server;
+    int listenFd = -1;
+    int udpFd = -1;
+
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctrDrbg;
+    mbedtls_x509_crt certificate;
+    mbedtls_pk_context key;
+    mbedtls_ssl_config conf;
+
+    std::map<int, std::unique_ptr<Peer>> peers; // by fd
+    std::map<std::string, Room> rooms;
+    std::map<std::string, Peer*> peersByToken;
+    std::map<uint64_t, Peer*> peersByUdpAddress;
+
+    struct DelayedDatagram
+    {
+        sockaddr_in from;
+        Buffer bytes;
+    };
+    std::multimap<Clock::time_point, DelayedDatagram> delayedDatagrams; ///< by release time
+
+    Buffer scratch;
+    Buffer datagram;
+
+    explicit Impl(LocalRTServer& server_)
+    :server(server_)
+    {
+        mbedtls_entropy_init(&entropy);
+        mbedtls_ctr_drbg_init(&ctrDrbg);
+        mbedtls_x509_crt_init(&certificate);
+        mbedtls_pk_init(&key);
+        mbedtls_ssl_config_init(&conf);
+    }
+
+    ~Impl()
+    {
+        for (auto& it : peers)
+        {
+            mbedtls_ssl_free(&it.second->ssl);
+            close(it.second->fd);
+        }
+        if (listenFd >= 0) close(listenFd);
+        if (udpFd >= 0) close(udpFd);
+
+        mbedtls_ssl_config_free(&conf);
+        mbedtls_pk_free(&key);
+        mbedtls_x509_crt_free(&certificate);
+        mbedtls_ctr_drbg_free(&ctrDrbg);
+        mbedtls_entropy_free(&entropy);
+    }
+
+    bool Setup(const Options& options)
+    {
+        const char pers[] = "gs_local_rt_server";
+        if (mbedtls_ctr_drbg_seed(&ctrDrbg, mbedtls_entropy_func, &entropy, reinterpret_cast<const unsigned char*>(pers), sizeof(pers) - 1) != 0 ||
+            mbedtls_x509_crt_parse(&certificate, reinterpret_cast<const unsigned char*>(mbedtls_test_srv_crt), mbedtls_test_srv_crt_len) != 0 ||
+            mbedtls_pk_parse_key(&key, reinterpret_cast<const unsigned char*>(mbedtls_test_srv_key), mbedtls_test_srv_key_len, nullptr, 0) != 0 ||
+            mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT) != 0 ||
+            mbedtls_ssl_conf_own_cert(&conf, &certificate, &key) != 0)
+        {
+            std::cerr << "LocalRTServer: TLS setup failed" << std::endl;
+            return false;
+        }
+        mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctrDrbg);
+
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(uint16_t(options.port));
+        if (inet_pton(AF_INET, options.bindAddress.c_str(), &address.sin_addr) != 1)
+        {
+            std::cerr << "LocalRTServer: invalid bind address " << options.bindAddress << std::endl;
+            return false;
+        }
+
+        int one = 1;
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listenFd, 1024) != 0 || !SetNonBlocking(listenFd))
+        {
+            std::cerr << "LocalRTServer: could not listen on " << options.bindAddress << ":" << options.port << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        address.sin_port = 0;
+        udpFd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (udpFd < 0 || bind(udpFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || !SetNonBlocking(udpFd))
+        {
+            std::cerr << "LocalRTServer: could not bind udp socket: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        server.tcpPort = LocalPort(listenFd);
+        server.udpPort = LocalPort(udpFd);
+        return true;
+    }
+
+    static int LocalPort(int fd)
+    {
+        sockaddr_in address;
+        socklen_t length = sizeof(address);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+        return ntohs(address.sin_port);
+    }
+
+    void Poll(int timeoutMs)
+    {
+        std::vector<pollfd> fds;
+        fds.reserve(peers.size() + 2);
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({udpFd, POLLIN, 0});
+        for (auto& it : peers)
+        {
+            short events = POLLIN;
+            if (!it.second->outbox.empty() || !it.second->handshakeDone)
+                events |= POLLOUT;
+            fds.push_back({it.first, events, 0});
+        }
+
+        if (!delayedDatagrams.empty())
+        {
+            auto untilRelease = std::chrono::duration_cast<std::chrono::milliseconds>(delayedDatagrams.begin()->first - Clock::now()).count();
+            timeoutMs = int(std::max<int64_t>(0, std::min<int64_t>(timeoutMs, untilRelease + 1)));
+        }
+
+        int n = poll(fds.data(), nfds_t(fds.size()), timeoutMs);
+        ReleaseDelayedDatagrams();
+        if (n <= 0)
+            return;
+
+        if (fds[0].revents & POLLIN)
+            Accept();
+        if (fds[1].revents & POLLIN)
+            ReceiveDatagrams();
+
+        for (size_t i = 2; i < fds.size(); ++i)
+        {
+            if (!fds[i].revents)
+                continue;
+            auto it = peers.find(fds[i].fd);
+            if (it != peers.end())
+                Service(*it->second);
+        }
+
+        // relaying queued data for peers that were not readable in this iteration
+        for (auto& it : peers)
+        {
+            if (!it.second->outbox.empty() && it.second->handshakeDone && !it.second->closing)
+                Flush(*it.second);
+        }
+
+        for (auto it = peers.begin(); it != peers.end();)
+        {
+            if (it->second->closing)
+            {
+                std::unique_ptr<Peer> peer = std::move(it->second);
+                it = peers.erase(it);
+                Disconnect(*peer);
+            }
+            else
+                ++it;
+        }
+    }
+
+    void Accept()
+    {
+        for (;;)
+        {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0)
+                return;
+
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            std::unique_ptr<Peer> peer(new Peer());
+            peer->fd = fd;
+            mbedtls_ssl_init(&peer->ssl);
+            if (mbedtls_ssl_setup(&peer->ssl, &conf) != 0)
+            {
+                mbedtls_ssl_free(&peer->ssl);
+                close(fd);
+                continue;
+            }
+            mbedtls_ssl_set_bio(&peer->ssl, &peer->fd, BioSend, BioRecv, nullptr);
+            peers[fd] = std::move(peer);
+        }
+    }
+
+    void Service(Peer& peer)
+    {
+        if (peer.closing)
+            return;
+
+        if (!peer.handshakeDone)
+        {
+            int res = mbedtls_ssl_handshake(&peer.ssl);
+            if (res == MBEDTLS_ERR_SSL_WANT_READ || res == MBEDTLS_ERR_SSL_WANT_WRITE)
+                return;
+            if (res != 0)
+            {
+                if (server.options.verbose)
+                    std::clog << "LocalRTServer: handshake failed: " << res << std::endl;
+                peer.closing = true;
+                return;
+            }
+            peer.handshakeDone = true;
+        }
+
+        unsigned char buffer[MAX_TLS_RECORD];
+        for (;;)
+        {
+            int res = mbedtls_ssl_read(&peer.ssl, buffer, sizeof(buffer));
+            if (res > 0)
+            {
+                peer.inbox.append(reinterpret_cast<const char*>(buffer), size_t(res));
+                server.stats.bytesIn += uint64_t(res);
+                continue;
+            }
+            if (res == MBEDTLS_ERR_SSL_WANT_READ || res == MBEDTLS_ERR_SSL_WANT_WRITE)
+                break;
+            peer.closing = true; // closed by the peer (0 or CLOSE_NOTIFY) or a fatal error
+            break;
+        }
+
+        // frames are varint length prefixed, just like in ReliableConnection
+        size_t consumed = 0;
+        while (!peer.closing)
+        {
+            const char* p = peer.inbox.data() + consumed;
+            const char* end = peer.inbox.data() + peer.inbox.size();
+            uint64_t length;
+            if (!ReadVarint(p, end, length) || uint64_t(end - p) < length)
+                break;
+
+            WirePacket packet;
+            if (!Decode(p, p + length, packet))
+            {
+                peer.closing = true;
+                break;
+            }
+            consumed = size_t(p + length - peer.inbox.data());
+            server.stats.packetsIn++;
+            Handle(peer, packet, false);
+        }
+        peer.inbox.erase(0, consumed);
+
+        Flush(peer);
+    }
+
+    void Flush(Peer& peer)
+    {
+        while (!peer.outbox.empty() && !peer.closing)
+        {
+            size_t chunk = peer.pendingWrite ? peer.pendingWrite : std::min(peer.outbox.size(), size_t(MAX_TLS_RECORD));
+            int res = mbedtls_ssl_write(&peer.ssl, reinterpret_cast<const unsigned char*>(peer.outbox.data()), chunk);
+            if (res == MBEDTLS_ERR_SSL_WANT_READ || res == MBEDTLS_ERR_SSL_WANT_WRITE)
+            {
+                peer.pendingWrite = chunk;
+                return;
+            }
+            peer.pendingWrite = 0;
+            if (res < 0)
+            {
+                peer.closing = true;
+                return;
+            }
+            peer.outbox.erase(0, size_t(res));
+            server.stats.bytesOut += uint64_t(res);
+        }
+    }
+
+    void SendReliable(Peer& to, const WirePacket& packet, int sender)
+    {
+        Encode(to.outbox, scratch, packet, sender);
+        server.stats.packetsOut++;
+    }
+
+    void SendFast(Peer& to, const WirePacket& packet, int sender)
+    {
+        datagram.clear();
+        Encode(datagram, scratch, packet, sender);
+        SendDatagram(to, datagram);
+        server.stats.packetsOut++;
+    }
+
+    void SendDatagram(Peer& to, const Buffer& bytes)
+    {
+        ssize_t n = sendto(udpFd, bytes.data(), bytes.size(), 0, reinterpret_cast<const sockaddr*>(&to.udpAddress), sizeof(to.udpAddress));
+        if (n > 0)
+            server.stats.bytesOut += uint64_t(n);
+    }
+
+    void ReceiveDatagrams()
+    {
+        char buffer[MAX_DATAGRAM];
+        for (;;)
+        {
+            sockaddr_in from;
+            socklen_t fromLength = sizeof(from);
+            ssize_t n = recvfrom(udpFd, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr*>(&from), &fromLength);
+            if (n <= 0)
+                return;
+            server.stats.bytesIn += uint64_t(n);
+
+            auto peer = peersByUdpAddress.find(AddressKey(from));
+            if (peer != peersByUdpAddress.end() && Throttle(*peer->second, buffer, size_t(n)))
+                continue;
+
+            HandleDatagram(from, buffer, buffer + n);
+        }
+    }
+
+    void HandleDatagram(const sockaddr_in& from, const char* p, const char* end)
+    {
+        // FastConnection sends one packet per datagram, but the format allows several
+        while (p < end)
+        {
+            uint64_t length;
+            if (!ReadVarint(p, end, length) || uint64_t(end - p) < length)
+                break;
+
+            WirePacket packet;
+            bool ok = Decode(p, p + length, packet);
+            p += length;
+            if (!ok)
+                break;
+            server.stats.packetsIn++;
+
+            if (packet.opCode == LoginCommand)
+            {
+                UdpLogin(from, packet);
+                continue;
+            }
+
+            auto it = peersByUdpAddress.find(AddressKey(from));
+            if (it != peersByUdpAddress.end())
+                Handle(*it->second, packet, true);
+        }
+    }
+
+    /// Options::udpBandwidth: a link of that bandwidth with a drop tail queue of MAX_UDP_QUEUE_MS. Returns true if the
+    /// datagram was queued or dropped, false if it can be handled right away.
+    bool Throttle(Peer& peer, const char* bytes, size_t length)
+    {
+        const int bandwidth = server.options.udpBandwidth;
+        if (bandwidth <= 0)
+            return false;
+
+        auto now = Clock::now();
+        peer.udpBusyUntil = std::max(peer.udpBusyUntil, now);
+        if (peer.udpBusyUntil - now > std::chrono::milliseconds(MAX_UDP_QUEUE_MS))
+        {
+            server.stats.udpDropped++;
+            return true;
+        }
+
+        peer.udpBusyUntil += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(double(length) / bandwidth));
+        DelayedDatagram& delayed = delayedDatagrams.emplace(peer.udpBusyUntil, DelayedDatagram())->second;
+        delayed.from = peer.udpAddress;
+        delayed.bytes.assign(bytes, length);
+        return true;
+    }
+
+    void ReleaseDelayedDatagrams()
+    {
+        auto now = Clock::now();
+        while (!delayedDatagrams.empty() && delayedDatagrams.begin()->first <= now)
+        {
+            DelayedDatagram delayed = std::move(delayedDatagrams.begin()->second);
+            delayedDatagrams.erase(delayedDatagrams.begin());
+            HandleDatagram(delayed.from, delayed.bytes.data(), delayed.bytes.data() + delayed.bytes.size());
+        }
+    }
+
+    void Handle(Peer& peer, WirePacket& packet, bool viaUdp)
+    {
+        switch (packet.opCode)
+        {
+            case LoginCommand:
+                Login(peer, packet);
+                return;
+            case PingCommand:
+            {
+                WirePacket result;
+                result.opCode = PingResult;
+                result.hasReliable = true;
+                result.reliable = !viaUdp;
+                result.hasPayload = true;
+                if (viaUdp) SendFast(peer, result, 0); else SendReliable(peer, result, 0);
+                return;
+            }
+            default:
+                break;
+        }
+
+        // other system op codes (e.g. the reliable UDPConnectMessage acknowledgement) need no answer
+        if (packet.opCode < 0 || peer.room == nullptr)
+            return;
+
+        Relay(peer, packet, viaUdp);
+    }
+
+    void Relay(Peer& from, WirePacket& packet, bool viaUdp)
+    {
+        Room& room = *from.room;
+        bool fast = viaUdp && !packet.reliable;
+
+        auto deliver = [&](Peer& to)
+        {
+            if (to.closing)
+                return;
+            if (fast && to.hasUdp)
+                SendFast(to, packet, from.peerId);
+            else
+                SendReliable(to, packet, from.peerId);
+        };
+
+        if (packet.targets.empty())
+        {
+            for (auto& it : room.peers)
+            {
+                if (it.second != &from)
+                    deliver(*it.second);
+            }
+        }
+        else
+        {
+            for (int target : packet.targets)
+            {
+                auto it = room.peers.find(target);
+                if (it != room.peers.end())
+                    deliver(*it->second);
+            }
+        }
+    }
+
+    void Login(Peer& peer, const WirePacket& packet)
+    {
+        if (peer.room != nullptr)
+            return;
+
+        // a reconnect presents the token returned in the last LoginResult: "<room>#<peerId>"
+        std::string token = ReadLoginToken(packet.payload);
+        std::string roomName = token;
+        int requestedPeerId = 0;
+        auto hash = token.rfind('#');
+        if (hash != std::string::npos)
+        {
+            roomName = token.substr(0, hash);
+            requestedPeerId = atoi(token.c_str() + hash + 1);
+        }
+
+        Room& room = rooms[roomName];
+        int peerId = requestedPeerId;
+        if (peerId <= 0 || room.peers.count(peerId))
+        {
+            while (room.peers.count(room.nextPeerId))
+                room.nextPeerId++;
+            peerId = room.nextPeerId++;
+        }
+
+        peer.room = &room;
+        peer.peerId = peerId;
+        peer.reconnectToken = roomName + "#" + std::to_string(peerId);
+        room.peers[peerId] = &peer;
+        peersByToken[peer.reconnectToken] = &peer;
+        server.stats.logins++;
+
+        if (server.options.verbose)
+            std::clog << "LocalRTServer: peer " << peerId << " joined room '" << roomName << "' (" << room.peers.size() << " peers)" << std::endl;
+
+        SendReliable(peer, MakeLoginResult(peer, true), 0);
+
+        WirePacket connected;
+        connected.opCode = PlayerConnectMessage;
+        connected.hasReliable = true;
+        connected.reliable = true;
+        connected.hasPayload = true;
+        WritePeerList(connected.payload, peerId, room);
+        for (auto& it : room.peers)
+        {
+            if (it.second != &peer)
+                SendReliable(*it.second, connected, 0);
+        }
+    }
+
+    void UdpLogin(const sockaddr_in& from, const WirePacket& packet)
+    {
+        auto it = peersByToken.find(ReadLoginToken(packet.payload));
+        if (it == peersByToken.end())
+            return;
+
+        Peer& peer = *it->second;
+        if (peer.hasUdp && AddressKey(peer.udpAddress) != AddressKey(from))
+            peersByUdpAddress.erase(AddressKey(peer.udpAddress));
+        peer.hasUdp = true;
+        peer.udpAddress = from;
+        peersByUdpAddress[AddressKey(from)] = &peer;
+
+        WirePacket udpConnect;
+        udpConnect.opCode = UDPConnectMessage;
+        udpConnect.hasReliable = true;
+        udpConnect.reliable = false;
+        udpConnect.hasPayload = true;
+
+        // the UDP login is acknowledged on the reliable connection: FastConnection only starts receiving datagrams
+        // once its login loop has seen the session move to ReliableAndFastSend.
+        SendReliable(peer, MakeLoginResult(peer, false), 0);
+        SendFast(peer, udpConnect, 0);
+    }
+
+    WirePacket MakeLoginResult(const Peer& peer, bool reliable)
+    {
+        WirePacket result;
+        result.opCode = LoginResult;
+        result.hasReliable = true;
+        result.reliable = reliable;
+        result.hasPayload = true;
+
+        Buffer& payload = result.payload;
+        payload.push_back(8);
+        WriteVarint(payload, 1); // Success
+        payload.push_back(18);
+        WriteVarint(payload, peer.reconnectToken.size());
+        payload += peer.reconnectToken;
+        payload.push_back(24);
+        WriteVarint(payload, uint64_t(peer.peerId));
+        for (auto& it : peer.room->peers)
+        {
+            payload.push_back(32);
+            WriteVarint(payload, uint64_t(it.first));
+        }
+        payload.push_back(40);
+        WriteVarint(payload, uint64_t(server.udpPort));
+        return result;
+    }
+
+    static void WritePeerList(Buffer& payload, int peerId, const Room& room)
+    {
+        payload.push_back(8);
+        WriteVarint(payload, uint64_t(peerId));
+        for (auto& it : room.peers)
+        {
+            payload.push_back(32);
+            WriteVarint(payload, uint64_t(it.first));
+        }
+    }
+
+    void Disconnect(Peer& peer)
+    {
+        if (peer.room != nullptr)
+        {
+            Room& room = *peer.room;
+            room.peers.erase(peer.peerId);
+            peersByToken.erase(peer.reconnectToken);
+            if (peer.hasUdp)
+                peersByUdpAddress.erase(AddressKey(peer.udpAddress));
+
+            WirePacket disconnected;
+            disconnected.opCode = PlayerDisconnectMessage;
+            disconnected.hasReliable = true;
+            disconnected.reliable = true;
+            disconnected.hasPayload = true;
+            WritePeerList(disconnected.payload, peer.peerId, room);
+            for (auto& it : room.peers)
+                SendReliable(*it.second, disconnected, 0);
+
+            if (server.options.verbose)
+                std::clog << "LocalRTServer: peer " << peer.peerId << " left (" << room.peers.size() << " peers)" << std::endl;
+        }
+
+        mbedtls_ssl_free(&peer.ssl);
+        close(peer.fd);
+    }
+};
+
+
+LocalRTServer::LocalRTServer()
+:impl(nullptr)
+,running(false)
+,tcpPort(0)
+,udpPort(0)
+{
+}
+
+LocalRTServer::~LocalRTServer()
+{
+    Stop();
+}
+
+bool LocalRTServer::Start(const Options& options_)
+{
+    assert(!impl);
+    options = options_;
+    impl = new Impl(*this);
+    if (!impl->Setup(options))
+    {
+        delete impl;
+        impl = nullptr;
+        return false;
+    }
+
+    running = true;
+    thread = std::thread([this](){ Run(); });
+    return true;
+}
+
+void LocalRTServer::Stop()
+{
+    running = false;
+    if (thread.joinable())
+        thread.join();
+    delete impl;
+    impl = nullptr;
+}
+
+void LocalRTServer::Run()
+{
+    if (options.onThreadStarted)
+        options.onThreadStarted();
+
+    while (running)
+    {
+        impl->Poll(50);
+        stats.threadCpuNs = uint64_t(ThreadCpuNs());
+    }
+}
+
+}} /* namespace GameSparks.Tools */
@@ -0,0 +1,74 @@
+#ifndef _GAMESPARKS_TOOLS_LOCALRTSERVER_HPP_
+#define _GAMESPARKS_TOOLS_LOCALRTSERVER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace GameSparks { namespace Tools {
+
+	/*!
+	 * A minimal stand-in for the GameSparks realtime server, good enough to drive RTSessionImpl without any external service.
+	 *
+	 * It accepts TLS connections (using the mbedtls test certificate), answers the LoginCommand with a LoginResult,
+	 * accepts the UDP login, announces PlayerConnect/PlayerDisconnect messages and relays every custom packet to its
+	 * target players (or to every other peer in the room). Sessions that log in with the same connect token share a room.
+	 *
+	 * Everything runs on a single poll() loop, so the server itself never becomes the bottleneck of a load test because
+	 * of lock contention. Options::udpBandwidth simulates a slow uplink for every peer. Only linux is supported.
+	 */
+	class LocalRTServer
+	{
+		public:
+			struct Options
+			{
+				std::string bindAddress = "127.0.0.1";
+				int port = 0; ///< TCP port, 0 picks a free one. The UDP port is always picked by the OS and sent as FastPort.
+				int udpBandwidth = 0; ///< bytes per second accepted from each peer over UDP, as if behind a link with a 200ms queue. 0 is unlimited.
+				bool verbose = false;
+				std::function<void()> onThreadStarted; ///< called on the server thread before the loop starts
+			};
+
+			struct Stats
+			{
+				std::atomic<uint64_t> logins{0};
+				std::atomic<uint64_t> packetsIn{0};
+				std::atomic<uint64_t> packetsOut{0};
+				std::atomic<uint64_t> bytesIn{0};
+				std::atomic<uint64_t> bytesOut{0};
+				std::atomic<uint64_t> udpDropped{0}; ///< datagrams dropped because the Options::udpBandwidth queue was full
+				std::atomic<uint64_t> threadCpuNs{0}; ///< cpu time consumed by the server thread
+			};
+
+			LocalRTServer();
+			~LocalRTServer();
+
+			/// binds the sockets and starts the server thread. Returns false (and logs why) if it could not bind.
+			bool Start(const Options& options);
+			void Stop();
+
+			int TcpPort() const { return tcpPort; }
+			int UdpPort() const { return udpPort; }
+			const Stats& GetStats() const { return stats; }
+		private:
+			struct Impl;
+
+			void Run();
+
+			Impl* impl;
+			Options options;
+			std::thread thread;
+			std::atomic<bool> running;
+			int tcpPort;
+			int udpPort;
+			Stats stats;
+
+			LocalRTServer(const LocalRTServer&);
+			LocalRTServer& operator=(const LocalRTServer&);
+	};
+
+}} /* namespace GameSparks.Tools */
+
+#endif /* _GAMESPARKS_TOOLS_LOCALRTSERVER_HPP_ */
@@ -0,0 +1,1064 @@
+/*
+ * Headless load generator for the GameSparks realtime SDK.
+ *
+ * Spins up N RTSessionImpl instances (through the public GameSparksRTSessionBuilder) against a host, drives all of them
+ * from one thread like a game loop would, and sends a scripted mix of messages. Every message carries its send time,
+ * so receive latency is measured end-to-end (sender SendData() -> server -> receiver IRTSessionListener::OnPacket()).
+ *
+ * Without --host a LocalRTServer is started in-process, so a run needs no external service:
+ *
+ *     RTLoadGenerator --sessions 64 --room-size 8 --rate 30 --duration 20 \
+ *         --pattern "100:unreliable:vector:70,101:reliable:ints:20,102:sequenced:string200:10"
+ *
+ * Use --serve to run only the stand-in server, e.g. to keep its cpu and allocations out of the measurement.
+ *
+ * With --scheduled the pattern entries become send scheduler streams (IRTSession::RegisterStream()) instead of being
+ * sent directly. Together with --throttle, which limits the UDP bandwidth the local server accepts from every session,
+ * this shows how the scheduler adapts the stream rates to a slow uplink:
+ *
+ *     RTLoadGenerator --sessions 8 --rate 60 --scheduled --throttle 8 \
+ *         --pattern "100:sequenced:vector:50,101:sequenced:string200:50"
+ *
+ * With --world the sessions move around a square world and every message becomes a position update of each of their
+ * --entities. --interest sends those through a RTInterestManager, which leaves out the peers that are far away and
+ * batches updates with the same recipients, instead of broadcasting every update to the room:
+ *
+ *     RTLoadGenerator --sessions 32 --room-size 32 --rate 30 --world 40000 --entities 4 --interest \
+ *         --pattern "100:unreliable:vector"
+ */
+
+#include <GameSparksRT/GameSparksRT.hpp>
+#include <GameSparksRT/IRTSession.hpp>
+#include <GameSparksRT/IRTSessionListener.hpp>
+#include <GameSparksRT/RTData.hpp>
+#include <GameSparksRT/RTInterestManager.hpp>
+
+#if GS_USE_SOCKET_REACTOR
+#	include "System/Net/Sockets/SocketReactor.hpp"
+#endif
+
+#include "LocalRTServer.hpp"
+#include "../Common/AllocationCounter.hpp"
+#include "../Common/Histogram.hpp"
+#include "../Common/ProfileCapture.hpp"
+
+#include <sys/resource.h>
+#include <signal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GameSparks::RT;
+using GameSparks::Tools::AllocationCounter;
+using GameSparks::Tools::Histogram;
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////////////
+// send pattern
+
+enum class Shape { Empty, Ints, Vector, String, Nested, Bytes };
+
+/// one entry of --pattern: "opCode:intent:shape[:weight[:target]]"
+struct PatternEntry
+{
+    int opCode = 100;
+    GameSparksRT::DeliveryIntent intent = GameSparksRT::DeliveryIntent::UNRELIABLE;
+    Shape shape = Shape::Ints;
+    int size = 0; ///< string/bytes length
+    int weight = 1;
+    bool targeted = false; ///< send to one random peer instead of the whole room
+    std::string name;
+
+    Histogram sendLatency;
+    Histogram receiveLatency;
+    uint64_t sent = 0;
+    uint64_t sentBytes = 0;
+    uint64_t expected = 0;
+    uint64_t received = 0;
+};
+
+std::vector<std::string> Split(const std::string& s, char separator)
+{
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, separator))
+        parts.push_back(part);
+    return parts;
+}
+
+bool ParsePattern(const std::string& spec, std::vector<PatternEntry>& pattern)
+{
+    for (const auto& item : Split(spec, ','))
+    {
+        auto fields = Split(item, ':');
+        if (fields.size() < 3 || fields.size() > 5)
+        {
+            std::cerr << "invalid pattern entry '" << item << "', expected opCode:intent:shape[:weight[:all|one]]" << std::endl;
+            return false;
+        }
+
+        PatternEntry entry;
+        entry.name = item;
+        entry.opCode = atoi(fields[0].c_str());
+        if (entry.opCode <= 0)
+        {
+            std::cerr << "op codes must be greater than zero: '" << item << "'" << std::endl;
+            return false;
+        }
+
+        if (fields[1] == "reliable") entry.intent = GameSparksRT::DeliveryIntent::RELIABLE;
+        else if (fields[1] == "unreliable") entry.intent = GameSparksRT::DeliveryIntent::UNRELIABLE;
+        else if (fields[1] == "sequenced") entry.intent = GameSparksRT::DeliveryIntent::UNRELIABLE_SEQUENCED;
+        else
+        {
+            std::cerr << "unknown intent '" << fields[1] << "'" << std::endl;
+            return false;
+        }
+
+        const std::string& shape = fields[2];
+        if (shape == "empty") entry.shape = Shape::Empty;
+        else if (shape == "ints") entry.shape = Shape::Ints;
+        else if (shape == "vector") entry.shape = Shape::Vector;
+        else if (shape == "nested") entry.shape = Shape::Nested;
+        else if (shape.compare(0, 6, "string") == 0) { entry.shape = Shape::String; entry.size = atoi(shape.c_str() + 6); }
+        else if (shape.compare(0, 5, "bytes") == 0) { entry.shape = Shape::Bytes; entry.size = atoi(shape.c_str() + 5); }
+        else
+        {
+            std::cerr << "unknown shape '" << shape << "', use empty, ints, vector, nested, string<N> or bytes<N>" << std::endl;
+            return false;
+        }
+
+        // leave room for the packet header and the timestamp fields
+        if (entry.size < 0 || entry.size > GameSparksRT::MAX_MESSAGE_SIZE_BYTES - 64)
+        {
+            std::cerr << "payload size of '" << item << "' must be between 0 and " << GameSparksRT::MAX_MESSAGE_SIZE_BYTES - 64 << std::endl;
+            return false;
+        }
+
+        if (fields.size() > 3)
+            entry.weight = std::max(1, atoi(fields[3].c_str()));
+        if (fields.size() > 4)
+            entry.targeted = fields[4] == "one";
+
+        pattern.push_back(std::move(entry));
+    }
+
+    // op codes identify the pattern entry on the receiving side
+    for (size_t i = 0; i != pattern.size(); ++i)
+        for (size_t j = i + 1; j != pattern.size(); ++j)
+            if (pattern[i].opCode == pattern[j].opCode)
+            {
+                std::cerr << "op code " << pattern[i].opCode << " is used twice in the pattern" << std::endl;
+                return false;
+            }
+
+    return !pattern.empty();
+}
+
+// RTData slots used by every message
+enum { SLOT_SEND_TIME = 1, SLOT_SENDER_INDEX = 2, SLOT_FIRST_FREE = 3 };
+
+void FillData(const PatternEntry& entry, RTData& data, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    switch (entry.shape)
+    {
+        case Shape::Empty:
+        case Shape::Bytes:
+            break;
+        case Shape::Ints:
+            for (uint i = 0; i != 8; ++i)
+                data.SetLong(SLOT_FIRST_FREE + i, int64_t(rng()));
+            break;
+        case Shape::Vector:
+            for (uint i = 0; i != 4; ++i)
+                data.SetRTVector(SLOT_FIRST_FREE + i, RTVector(coordinate(rng), coordinate(rng), coordinate(rng)));
+            for (uint i = 4; i != 8; ++i)
+                data.SetFloat(SLOT_FIRST_FREE + i, coordinate(rng));
+            break;
+        case Shape::String:
+            data.SetString(SLOT_FIRST_FREE, std::string(size_t(entry.size), char('a' + rng() % 26)));
+            break;
+        case Shape::Nested:
+        {
+            RTData inner;
+            inner.SetLong(1, int64_t(rng()));
+            inner.SetRTVector(2, RTVector(coordinate(rng), coordinate(rng), coordinate(rng), coordinate(rng)));
+            RTData outer;
+            outer.SetData(1, inner);
+            outer.SetDouble(2, double(coordinate(rng)));
+            data.SetData(SLOT_FIRST_FREE, outer);
+            data.SetData(SLOT_FIRST_FREE + 1, inner);
+            break;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// sessions
+
+struct Settings
+{
+    std::string host;
+    int port = 0;
+    int sessions = 16;
+    int roomSize = 8;
+    double rate = 20.0;        ///< messages per second and session
+    double duration = 10.0;    ///< measurement window in seconds
+    double warmup = 2.0;
+    double connectTimeout = 15.0;
+    double drain = 1.0;
+    int updateHz = 1000;       ///< how often Update() is called on every session
+    std::string pattern = "100:unreliable:vector:60,101:reliable:ints:25,102:sequenced:nested:15";
+    unsigned seed = 1;
+    bool verbose = false;
+    std::string json;          ///< optional path for a machine readable report
+    std::string profile;       ///< optional prefix for the GSProfiler summary and trace
+    int servePort = -1;
+    bool scheduled = false;    ///< send through the send scheduler streams
+    int throttle = 0;          ///< KiB/s the local server accepts from every session over UDP, 0 is unlimited
+    float world = 0;           ///< edge length of the world the sessions move in, 0 disables the position updates
+    int entities = 1;          ///< position updates per message with --world
+    bool interest = false;     ///< send the position updates through a RTInterestManager
+    float cellSize = 4000;     ///< RTInterestManager::Settings::CellSize
+};
+
+class LoadGenerator;
+
+class Session : public IRTSessionListener
+{
+    public:
+        Session(LoadGenerator& generator_, int index_) : generator(generator_), index(index_) {}
+
+        void OnReady(bool ready_) override { ready = ready_; }
+        void OnPacket(const RTPacket& packet) override;
+
+        LoadGenerator& generator;
+        int index;
+        bool ready = false;
+        std::unique_ptr<IRTSession> session;
+        Clock::time_point nextSend;
+        std::vector<int> peers;
+        std::vector<int> streams; ///< stream id of every pattern entry with --scheduled
+        float x = 0, y = 0, vx = 0, vy = 0; ///< with --world
+        std::vector<std::pair<float, float>> offsets; ///< of the entities from x/y, the first one is the session itself
+        std::unique_ptr<RTInterestManager> interest;
+        uint64_t sent = 0;
+        uint64_t received = 0;
+};
+
+class LoadGenerator
+{
+    public:
+        explicit LoadGenerator(const Settings& settings_)
+        :settings(settings_)
+        ,rng(settings_.seed)
+        {
+        }
+
+        bool Setup()
+        {
+            if (!ParsePattern(settings.pattern, pattern))
+                return false;
+            if (settings.scheduled)
+            {
+                for (const auto& entry : pattern)
+                {
+                    if (entry.shape == Shape::Bytes)
+                    {
+                        std::cerr << "streams only carry RTData, bytes<N> can't be used with --scheduled: '" << entry.name << "'" << std::endl;
+                        return false;
+                    }
+                }
+            }
+            if (settings.world > 0)
+            {
+                if (settings.scheduled)
+                {
+                    std::cerr << "--world can't be combined with --scheduled" << std::endl;
+                    return false;
+                }
+                for (const auto& entry : pattern)
+                {
+                    if (entry.shape == Shape::Bytes || entry.targeted)
+                    {
+                        std::cerr << "position updates are broadcast RTData, bytes<N> and one can't be used with --world: '" << entry.name << "'" << std::endl;
+                        return false;
+                    }
+                }
+            }
+            for (const auto& entry : pattern)
+                totalWeight += entry.weight;
+            return true;
+        }
+
+        int Run(const std::string& host, int port);
+
+        void OnPacket(Session& receiver, const RTPacket& packet)
+        {
+            receiver.received++;
+            if (!measuring)
+                return;
+
+            auto it = std::find_if(pattern.begin(), pattern.end(), [&](const PatternEntry& e){ return e.opCode == packet.OpCode; });
+            auto sendTime = packet.Data.GetLong(SLOT_SEND_TIME);
+            if (it == pattern.end() || !sendTime.HasValue())
+                return;
+
+            // only messages sent inside the window count, so that warmup traffic still in flight does not skew the numbers
+            int64_t sentAt = sendTime.Value();
+            if (sentAt < windowStartNs || sentAt > windowEndNs)
+                return;
+
+            it->received++;
+            it->receiveLatency.Record(NowNs() - sentAt);
+        }
+
+        /// a packet of RTInterestManager::Flush(), every update in it counts as a message
+        void OnInterestPacket(Session& receiver, const RTPacket& packet)
+        {
+            std::vector<RTData> updates;
+            RTInterestManager::ReadUpdates(packet.Data, updates);
+            receiver.received += updates.size();
+            if (!measuring)
+                return;
+
+            auto it = std::find_if(pattern.begin(), pattern.end(), [&](const PatternEntry& e){ return e.opCode == packet.OpCode; });
+            if (it == pattern.end())
+                return;
+
+            int64_t now = NowNs();
+            for (const auto& update : updates)
+            {
+                auto sendTime = update.GetLong(SLOT_SEND_TIME);
+                if (!sendTime.HasValue() || sendTime.Value() < windowStartNs || sendTime.Value() > windowEndNs)
+                    continue;
+                it->received++;
+                it->receiveLatency.Record(now - sendTime.Value());
+            }
+        }
+    private:
+        static int64_t NowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        }
+
+        PatternEntry& PickEntry()
+        {
+            int pick = int(rng() % uint32_t(totalWeight));
+            for (auto& entry : pattern)
+            {
+                pick -= entry.weight;
+                if (pick < 0)
+                    return entry;
+            }
+            return pattern.back();
+        }
+
+        /// one position update per entity, broadcast one by one or through the interest manager
+        void SendPositions(Session& s)
+        {
+            PatternEntry& entry = PickEntry();
+
+            auto start = Clock::now();
+            int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+            const auto& peers = s.session->ActivePeers;
+            uint64_t expected = 0;
+            int written = 0;
+
+            if (s.interest)
+            {
+                // what the session would know from the updates of its room
+                size_t roomBegin = size_t(s.index / settings.roomSize * settings.roomSize);
+                size_t roomEnd = std::min(roomBegin + size_t(settings.roomSize), sessions.size());
+                for (size_t i = roomBegin; i != roomEnd; ++i)
+                {
+                    const Session& other = *sessions[i];
+                    if (&other != &s && other.session->PeerId.HasValue())
+                        s.interest->SetPeerPosition(other.session->PeerId.Value(), other.x, other.y);
+                }
+            }
+
+            for (const auto& offset : s.offsets)
+            {
+                float x = s.x + offset.first;
+                float y = s.y + offset.second;
+
+                RTData data;
+                FillData(entry, data, rng);
+                data.SetLong(SLOT_SEND_TIME, startNs);
+                data.SetLong(SLOT_SENDER_INDEX, s.index);
+                data.SetRTVector(SLOT_FIRST_FREE, RTVector(x, y, 0.0f));
+
+                if (s.interest)
+                {
+                    s.interest->QueueUpdate(x, y, data);
+                }
+                else
+                {
+                    written += std::max(0, s.session->SendRTData(entry.opCode, entry.intent, data, std::vector<int>()));
+                    expected += peers.empty() ? 0 : peers.size() - 1;
+                }
+            }
+
+            if (s.interest)
+            {
+                uint64_t deliveries = s.interest->GetStats().Deliveries;
+                written = s.interest->Flush(*s.session, entry.opCode, entry.intent);
+                expected = s.interest->GetStats().Deliveries - deliveries;
+            }
+            auto elapsed = Clock::now() - start;
+
+            s.sent += s.offsets.size();
+            if (measuring && startNs >= windowStartNs && startNs <= windowEndNs)
+            {
+                entry.sent += s.offsets.size();
+                entry.sentBytes += uint64_t(written);
+                entry.expected += expected;
+                entry.sendLatency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        }
+
+        /// moves the sessions in a straight line at running speed, bouncing off the edges of the world
+        void Move(float seconds)
+        {
+            for (auto& s : sessions)
+            {
+                s->x += s->vx * seconds;
+                s->y += s->vy * seconds;
+                if (s->x < 0 || s->x > settings.world)
+                {
+                    s->vx = -s->vx;
+                    s->x = std::min(std::max(s->x, 0.0f), settings.world);
+                }
+                if (s->y < 0 || s->y > settings.world)
+                {
+                    s->vy = -s->vy;
+                    s->y = std::min(std::max(s->y, 0.0f), settings.world);
+                }
+            }
+        }
+
+        void PlaceSessions()
+        {
+            const float speed = 600.0f;
+            std::uniform_real_distribution<float> position(0.0f, settings.world);
+            std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+            std::uniform_real_distribution<float> offset(-1000.0f, 1000.0f);
+            for (auto& s : sessions)
+            {
+                s->x = position(rng);
+                s->y = position(rng);
+                float a = angle(rng);
+                s->vx = speed * std::cos(a);
+                s->vy = speed * std::sin(a);
+
+                s->offsets.push_back(std::make_pair(0.0f, 0.0f));
+                for (int i = 1; i < settings.entities; ++i)
+                    s->offsets.push_back(std::make_pair(offset(rng), offset(rng)));
+
+                if (settings.interest)
+                {
+                    RTInterestManager::Settings interestSettings;
+                    interestSettings.CellSize = settings.cellSize;
+                    s->interest.reset(new RTInterestManager(interestSettings));
+                }
+            }
+        }
+
+        void Send(Session& s)
+        {
+            if (settings.world > 0)
+            {
+                SendPositions(s);
+                return;
+            }
+
+            PatternEntry& entry = PickEntry();
+
+            RTData data;
+            FillData(entry, data, rng);
+
+            std::vector<int> targets;
+            const auto& peers = s.session->ActivePeers;
+            int self = s.session->PeerId.GetValueOrDefault(0);
+            uint64_t expected = peers.empty() ? 0 : peers.size() - 1;
+            if (entry.targeted && peers.size() > 1)
+            {
+                int target;
+                do target = peers[rng() % peers.size()];
+                while (target == self);
+                targets.push_back(target);
+                expected = 1;
+            }
+
+            System::Bytes payload;
+            if (entry.shape == Shape::Bytes)
+                payload.assign(size_t(entry.size), System::Byte(rng()));
+
+            auto start = Clock::now();
+            int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+            data.SetLong(SLOT_SEND_TIME, startNs);
+            data.SetLong(SLOT_SENDER_INDEX, s.index);
+            int written = 0;
+            if (settings.scheduled)
+                s.session->SetStreamState(s.streams[size_t(&entry - pattern.data())], data, targets);
+            else
+                written = s.session->SendData(entry.opCode, entry.intent, payload, data, targets);
+            auto elapsed = Clock::now() - start;
+
+            s.sent++;
+            if (measuring && startNs >= windowStartNs && startNs <= windowEndNs)
+            {
+                entry.sent++;
+                entry.sentBytes += uint64_t(std::max(0, written));
+                entry.expected += expected;
+                entry.sendLatency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        }
+
+        void Tick(bool sending)
+        {
+            auto now = Clock::now();
+            if (settings.world > 0)
+            {
+                Move(std::chrono::duration<float>(now - lastTick).count());
+                lastTick = now;
+            }
+            for (auto& s : sessions)
+            {
+                s->session->Update();
+
+                if (!sending || !s->ready)
+                    continue;
+
+                // catch up at most one second, a stalled loop should show up as latency, not as a burst
+                if (now - s->nextSend > std::chrono::seconds(1))
+                    s->nextSend = now - std::chrono::seconds(1);
+                while (s->nextSend <= now)
+                {
+                    Send(*s);
+                    s->nextSend += sendInterval;
+                }
+            }
+        }
+
+        void RunFor(double seconds, bool sending)
+        {
+            auto tick = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.updateHz));
+            auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+            auto next = Clock::now();
+            while (Clock::now() < end)
+            {
+                Tick(sending);
+                next += tick;
+                auto now = Clock::now();
+                if (next > now)
+                    std::this_thread::sleep_until(next);
+                else
+                    next = now;
+            }
+        }
+
+        /// one stream per pattern entry, the first entry has the highest priority
+        void RegisterStreams(Session& s)
+        {
+            for (size_t i = 0; i != pattern.size(); ++i)
+            {
+                const PatternEntry& entry = pattern[i];
+                double targetRate = settings.rate * entry.weight / totalWeight;
+                s.streams.push_back(s.session->RegisterStream(entry.name, entry.opCode, int(pattern.size() - i), float(targetRate)));
+            }
+        }
+
+        void Report(double windowSeconds, double cpuSeconds, double serverCpuSeconds, uint64_t allocations, uint64_t bytes, int threads);
+        void ReportScheduler();
+        void ReportInterest();
+
+        Settings settings;
+        std::mt19937 rng;
+        std::vector<PatternEntry> pattern;
+        int totalWeight = 0;
+        std::vector<std::unique_ptr<Session>> sessions;
+        Clock::duration sendInterval;
+        Clock::time_point lastTick = Clock::now();
+        bool measuring = false;
+        uint64_t serverBytesIn = 0;  ///< over the window, from the local server
+        uint64_t serverBytesOut = 0;
+        int64_t windowStartNs = 0;
+        int64_t windowEndNs = 0;
+};
+
+void Session::OnPacket(const RTPacket& packet)
+{
+    if (interest)
+        generator.OnInterestPacket(*this, packet);
+    else
+        generator.OnPacket(*this, packet);
+}
+
+double ProcessCpuSeconds()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return double(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + double(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+int ThreadCount()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 8, "Threads:") == 0)
+            return atoi(line.c_str() + 8);
+    }
+    return 0;
+}
+
+GameSparks::Tools::LocalRTServer* localServer = nullptr;
+
+double ServerCpuSeconds()
+{
+    return localServer ? double(localServer->GetStats().threadCpuNs.load()) / 1e9 : 0.0;
+}
+
+int LoadGenerator::Run(const std::string& host, int port)
+{
+    sendInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.rate));
+
+    std::cout << "starting " << settings.sessions << " sessions against " << host << ":" << port
+              << " (" << settings.roomSize << " per room, " << settings.rate << " msg/s each)" << std::endl;
+
+    for (int i = 0; i != settings.sessions; ++i)
+    {
+        std::unique_ptr<Session> s(new Session(*this, i));
+        s->session.reset(GameSparksRT::SessionBuilder()
+            .SetConnectToken("load-room-" + std::to_string(i / settings.roomSize))
+            .SetHost(host)
+            .SetPort(port)
+            .SetListener(s.get())
+            .Build());
+        s->session->Start();
+        sessions.push_back(std::move(s));
+    }
+
+    // connect
+    auto connectDeadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(settings.connectTimeout));
+    auto connectStart = Clock::now();
+    size_t readyCount = 0;
+    while (Clock::now() < connectDeadline)
+    {
+        RunFor(0.05, false);
+        readyCount = size_t(std::count_if(sessions.begin(), sessions.end(), [](const std::unique_ptr<Session>& s){ return s->ready; }));
+        if (readyCount == sessions.size())
+            break;
+    }
+    double connectSeconds = std::chrono::duration<double>(Clock::now() - connectStart).count();
+    std::cout << readyCount << "/" << sessions.size() << " sessions ready after " << std::fixed << std::setprecision(2) << connectSeconds << "s" << std::endl;
+    if (readyCount == 0)
+    {
+        std::cerr << "no session became ready, giving up" << std::endl;
+        return 1;
+    }
+
+    if (settings.scheduled)
+    {
+        for (auto& s : sessions)
+            RegisterStreams(*s);
+    }
+    if (settings.world > 0)
+        PlaceSessions();
+
+    // spread the first sends over one interval, so that sessions do not send in lock step
+    auto now = Clock::now();
+    for (auto& s : sessions)
+        s->nextSend = now + std::chrono::duration_cast<Clock::duration>(sendInterval * (double(rng() % 1000) / 1000.0));
+
+    RunFor(settings.warmup, true);
+
+    // measure
+    measuring = true;
+    windowStartNs = NowNs();
+    windowEndNs = windowStartNs + int64_t(settings.duration * 1e9);
+    double cpuStart = ProcessCpuSeconds();
+    double serverCpuStart = ServerCpuSeconds();
+    uint64_t allocationsStart = AllocationCounter::Count();
+    uint64_t bytesStart = AllocationCounter::Bytes();
+    uint64_t serverBytesInStart = localServer ? localServer->GetStats().bytesIn.load() : 0;
+    uint64_t serverBytesOutStart = localServer ? localServer->GetStats().bytesOut.load() : 0;
+#if GS_USE_SOCKET_REACTOR
+    auto reactorStart = System::Net::Sockets::SocketReactor::Instance().GetStats();
+#endif
+
+    RunFor(settings.duration, true);
+
+    double cpuSeconds = ProcessCpuSeconds() - cpuStart;
+    double serverCpuSeconds = ServerCpuSeconds() - serverCpuStart;
+    uint64_t allocations = AllocationCounter::Count() - allocationsStart;
+    uint64_t bytes = AllocationCounter::Bytes() - bytesStart;
+    serverBytesIn = localServer ? localServer->GetStats().bytesIn.load() - serverBytesInStart : 0;
+    serverBytesOut = localServer ? localServer->GetStats().bytesOut.load() - serverBytesOutStart : 0;
+    int threads = ThreadCount();
+#if GS_USE_SOCKET_REACTOR
+    auto reactorEnd = System::Net::Sockets::SocketReactor::Instance().GetStats();
+#endif
+
+    // let messages sent at the end of the window arrive
+    RunFor(settings.drain, false);
+    measuring = false;
+
+    Report(settings.duration, cpuSeconds, serverCpuSeconds, allocations, bytes, threads);
+    if (settings.scheduled)
+        ReportScheduler();
+    if (settings.interest)
+        ReportInterest();
+
+#if GS_USE_SOCKET_REACTOR
+    double busy = std::chrono::duration<double>(reactorEnd.busyTime - reactorStart.busyTime).count();
+    std::cout << "reactor: " << reactorEnd.watchedSockets << " sockets, "
+              << double(reactorEnd.wakeups - reactorStart.wakeups) / settings.duration << " wakeups/s, "
+              << double(reactorEnd.dispatchedEvents - reactorStart.dispatchedEvents) / settings.duration << " events/s, "
+              << double(reactorEnd.firedTimers - reactorStart.firedTimers) / settings.duration << " timers/s, "
+              << std::setprecision(1) << busy / settings.duration * 100.0 << "% busy" << std::endl;
+#endif
+
+    for (auto& s : sessions)
+        s->session->Stop();
+    sessions.clear();
+    return 0;
+}
+
+void LoadGenerator::Report(double windowSeconds, double cpuSeconds, double serverCpuSeconds, uint64_t allocations, uint64_t bytes, int threads)
+{
+    Histogram sendAll, receiveAll;
+    uint64_t sent = 0, sentBytes = 0, expected = 0, received = 0;
+    for (const auto& entry : pattern)
+    {
+        sendAll.Merge(entry.sendLatency);
+        receiveAll.Merge(entry.receiveLatency);
+        sent += entry.sent;
+        sentBytes += entry.sentBytes;
+        expected += entry.expected;
+        received += entry.received;
+    }
+
+    double clientCpu = std::max(0.0, cpuSeconds - serverCpuSeconds);
+    double messages = double(sent + received);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::endl << "window " << windowSeconds << "s, " << sessions.size() << " sessions, " << threads << " threads" << std::endl;
+    std::cout << "throughput: sent " << double(sent) / windowSeconds << " msg/s (" << double(sentBytes) / windowSeconds / 1024.0 << " KiB/s), received "
+              << double(received) / windowSeconds << " msg/s, delivered " << std::setprecision(2)
+              << (expected ? 100.0 * double(received) / double(expected) : 0.0) << "% of " << expected << std::endl;
+    std::cout << std::setprecision(1);
+    std::cout << "allocations: " << double(allocations) / windowSeconds << "/s, " << double(bytes) / windowSeconds / 1024.0 << " KiB/s, "
+              << (messages > 0 ? double(allocations) / messages : 0.0) << " per message sent or received" << std::endl;
+    if (localServer)
+    {
+        double perSession = windowSeconds * double(sessions.size()) * 1024.0;
+        std::cout << "bandwidth per session: " << double(serverBytesIn) / perSession << " KiB/s up, "
+                  << double(serverBytesOut) / perSession << " KiB/s down (measured at the local server, tcp and udp)" << std::endl;
+    }
+    std::cout << "cpu: " << clientCpu / windowSeconds * 100.0 << "% of a core for the clients ("
+              << std::setprecision(3) << clientCpu / windowSeconds / double(sessions.size()) * 1000.0 << " ms/s per session)";
+    if (localServer)
+        std::cout << std::setprecision(1) << ", " << serverCpuSeconds / windowSeconds * 100.0 << "% for the local server";
+    std::cout << std::endl << std::endl;
+
+    auto row = [](const std::string& name, const char* what, const Histogram& h)
+    {
+        std::cout << std::left << std::setw(34) << name << std::setw(8) << what << std::right << std::setprecision(1)
+                  << std::setw(10) << h.Count()
+                  << std::setw(10) << h.PercentileUs(50)
+                  << std::setw(10) << h.PercentileUs(90)
+                  << std::setw(10) << h.PercentileUs(99)
+                  << std::setw(10) << h.PercentileUs(99.9)
+                  << std::setw(10) << h.MaxUs() << std::endl;
+    };
+
+    std::cout << std::left << std::setw(34) << "pattern" << std::setw(8) << "" << std::right << std::setw(10) << "count"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p90 us" << std::setw(10) << "p99 us"
+              << std::setw(10) << "p99.9 us" << std::setw(10) << "max us" << std::endl;
+    for (const auto& entry : pattern)
+    {
+        row(entry.name, "send", entry.sendLatency);
+        row("", "recv", entry.receiveLatency);
+    }
+    row("all", "send", sendAll);
+    row("", "recv", receiveAll);
+
+    if (!settings.json.empty())
+    {
+        std::ofstream out(settings.json);
+        out << std::fixed << std::setprecision(3);
+        out << "{\n  \"sessions\": " << sessions.size() << ",\n  \"window\": " << windowSeconds
+            << ",\n  \"threads\": " << threads
+            << ",\n  \"sentPerSecond\": " << double(sent) / windowSeconds
+            << ",\n  \"receivedPerSecond\": " << double(received) / windowSeconds
+            << ",\n  \"deliveryRatio\": " << (expected ? double(received) / double(expected) : 0.0)
+            << ",\n  \"allocationsPerSecond\": " << double(allocations) / windowSeconds
+            << ",\n  \"allocatedBytesPerSecond\": " << double(bytes) / windowSeconds
+            << ",\n  \"cpuPerSession\": " << clientCpu / windowSeconds / double(sessions.size())
+            << ",\n  \"bytesUpPerSession\": " << double(serverBytesIn) / windowSeconds / double(sessions.size())
+            << ",\n  \"bytesDownPerSession\": " << double(serverBytesOut) / windowSeconds / double(sessions.size())
+            << ",\n  \"patterns\": [";
+        bool first = true;
+        for (const auto& entry : pattern)
+        {
+            out << (first ? "" : ",") << "\n    {\"pattern\": \"" << entry.name << "\", \"sent\": " << entry.sent << ", \"received\": " << entry.received
+                << ", \"sendP50us\": " << entry.sendLatency.PercentileUs(50) << ", \"sendP99us\": " << entry.sendLatency.PercentileUs(99)
+                << ", \"recvP50us\": " << entry.receiveLatency.PercentileUs(50) << ", \"recvP99us\": " << entry.receiveLatency.PercentileUs(99)
+                << ", \"recvP999us\": " << entry.receiveLatency.PercentileUs(99.9) << "}";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+    }
+}
+
+void LoadGenerator::ReportScheduler()
+{
+    // averaged over the sessions, sent and dropped include the warmup
+    std::vector<RTSendSchedulerStats> all;
+    for (const auto& s : sessions)
+        all.push_back(s->session->GetSendSchedulerStats());
+    if (all.empty())
+        return;
+
+    double n = double(all.size());
+    double sendRate = 0, roundTripTime = 0, loss = 0;
+    for (const auto& stats : all)
+    {
+        sendRate += stats.SendRate / n;
+        roundTripTime += stats.RoundTripTime / n;
+        loss += stats.Loss / n;
+    }
+
+    std::cout << std::endl << std::fixed << std::setprecision(1)
+              << "send scheduler: " << sendRate / 1024.0 << " KiB/s allowed, rtt " << roundTripTime * 1000.0 << " ms, ping loss " << loss * 100.0 << "%";
+    if (localServer)
+        std::cout << ", " << localServer->GetStats().udpDropped.load() << " datagrams dropped by the server";
+    std::cout << std::endl;
+
+    std::cout << std::left << std::setw(34) << "stream" << std::right << std::setw(10) << "priority" << std::setw(10) << "target/s"
+              << std::setw(10) << "rate/s" << std::setw(10) << "sent" << std::setw(10) << "dropped" << std::endl;
+    for (size_t i = 0; i != pattern.size(); ++i)
+    {
+        double rate = 0;
+        uint64_t sent = 0, dropped = 0;
+        for (const auto& stats : all)
+        {
+            if (i >= stats.Streams.size())
+                continue;
+            rate += stats.Streams[i].Rate / n;
+            sent += stats.Streams[i].Sent;
+            dropped += stats.Streams[i].Dropped;
+        }
+        const RTStreamStats& first = all.front().Streams[i];
+        std::cout << std::left << std::setw(34) << first.Name << std::right << std::setw(10) << first.Priority
+                  << std::setw(10) << first.TargetRate << std::setw(10) << rate << std::setw(10) << sent << std::setw(10) << dropped << std::endl;
+    }
+}
+
+void LoadGenerator::ReportInterest()
+{
+    // summed over the sessions, including the warmup
+    RTInterestManager::Stats total;
+    for (const auto& s : sessions)
+    {
+        if (!s->interest)
+            continue;
+        const RTInterestManager::Stats& stats = s->interest->GetStats();
+        total.Updates += stats.Updates;
+        total.Packets += stats.Packets;
+        total.Deliveries += stats.Deliveries;
+        total.Filtered += stats.Filtered;
+    }
+
+    double recipients = double(total.Deliveries + total.Filtered);
+    std::cout << std::endl << std::fixed << std::setprecision(2)
+              << "interest: " << total.Updates << " updates in " << total.Packets << " packets ("
+              << (total.Packets ? double(total.Updates) / double(total.Packets) : 0.0) << " per packet), "
+              << std::setprecision(1) << (recipients > 0 ? 100.0 * double(total.Filtered) / recipients : 0.0)
+              << "% of the update recipients filtered" << std::endl;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// command line
+
+void PrintUsage()
+{
+    std::cout <<
+        "usage: RTLoadGenerator [options]\n"
+        "  --host <host>           RT host to connect to. Without it a local stand-in server is started in-process\n"
+        "  --port <port>           RT port (required with --host)\n"
+        "  --serve <port>          only run the local stand-in server on port (0 picks one) until interrupted\n"
+        "  --sessions <n>          number of sessions (default 16)\n"
+        "  --room-size <n>         sessions that share a connect token, i.e. a room (default 8)\n"
+        "  --rate <n>              messages per second and session (default 20)\n"
+        "  --duration <s>          measurement window (default 10)\n"
+        "  --warmup <s>            sending before the window starts (default 2)\n"
+        "  --connect-timeout <s>   time to wait for sessions to become ready (default 15)\n"
+        "  --update-hz <n>         IRTSession::Update() frequency, bounds the receive latency resolution (default 1000)\n"
+        "  --pattern <spec>        comma separated opCode:intent:shape[:weight[:all|one]] entries\n"
+        "                          intent: reliable, unreliable, sequenced\n"
+        "                          shape: empty, ints, vector, nested, string<N>, bytes<N>\n"
+        "  --scheduled             send through IRTSession::RegisterStream() streams, one per pattern entry in order of priority.\n"
+        "                          The intent of the entries is ignored, stream updates are always sequenced\n"
+        "  --throttle <KiB/s>      UDP bandwidth the local server accepts from every session, queued up to 200ms, then dropped\n"
+        "  --world <size>          the sessions move around a world of size x size, every message becomes a position update\n"
+        "                          of each of their entities, sent as a broadcast\n"
+        "  --entities <n>          entities per session with --world, the session and n - 1 around it (default 1)\n"
+        "  --interest              send the position updates through a RTInterestManager instead of broadcasting them\n"
+        "  --cell <size>           grid cell size of the interest manager (default 4000)\n"
+        "  --seed <n>              random seed (default 1)\n"
+        "  --json <path>           also write the report as json\n"
+        "  --profile <prefix>      record the SDK scope timers, writes <prefix>.json and <prefix>.trace.json (chrome://tracing)\n"
+        "  --verbose               SDK and server logging\n";
+}
+
+bool ParseArguments(int argc, char** argv, Settings& settings)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char*
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << arg << " needs a value" << std::endl;
+                exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--host") settings.host = value();
+        else if (arg == "--port") settings.port = atoi(value());
+        else if (arg == "--serve") settings.servePort = atoi(value());
+        else if (arg == "--sessions") settings.sessions = atoi(value());
+        else if (arg == "--room-size") settings.roomSize = atoi(value());
+        else if (arg == "--rate") settings.rate = atof(value());
+        else if (arg == "--duration") settings.duration = atof(value());
+        else if (arg == "--warmup") settings.warmup = atof(value());
+        else if (arg == "--connect-timeout") settings.connectTimeout = atof(value());
+        else if (arg == "--update-hz") settings.updateHz = atoi(value());
+        else if (arg == "--pattern") settings.pattern = value();
+        else if (arg == "--scheduled") settings.scheduled = true;
+        else if (arg == "--throttle") settings.throttle = atoi(value());
+        else if (arg == "--world") settings.world = float(atof(value()));
+        else if (arg == "--entities") settings.entities = atoi(value());
+        else if (arg == "--interest") settings.interest = true;
+        else if (arg == "--cell") settings.cellSize = float(atof(value()));
+        else if (arg == "--seed") settings.seed = unsigned(atoi(value()));
+        else if (arg == "--json") settings.json = value();
+        else if (arg == "--profile") settings.profile = value();
+        else if (arg == "--verbose") settings.verbose = true;
+        else if (arg == "--help" || arg == "-h") { PrintUsage(); exit(0); }
+        else
+        {
+            std::cerr << "unknown option " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+    }
+
+    if (settings.sessions <= 0 || settings.roomSize <= 0 || settings.rate <= 0 || settings.duration <= 0 || settings.updateHz <= 0)
+    {
+        std::cerr << "--sessions, --room-size, --rate, --duration and --update-hz must be positive" << std::endl;
+        return false;
+    }
+    if (settings.entities <= 0 || settings.cellSize <= 0)
+    {
+        std::cerr << "--entities and --cell must be positive" << std::endl;
+        return false;
+    }
+    if (settings.interest && settings.world <= 0)
+    {
+        std::cerr << "--interest requires --world" << std::endl;
+        return false;
+    }
+    if (!settings.host.empty() && settings.port <= 0)
+    {
+        std::cerr << "--host requires --port" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+volatile sig_atomic_t interrupted = 0;
+
+} /* anonymous namespace */
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+    if (!ParseArguments(argc, argv, settings))
+        return 2;
+
+    // the SDK log goes through the action queue and is printed from Update(), which would end up in the measurement
+    if (!settings.verbose)
+        GameSparksRT::Logger = [](const std::string&){};
+
+    GameSparks::Tools::LocalRTServer server;
+    GameSparks::Tools::LocalRTServer::Options serverOptions;
+    serverOptions.verbose = settings.verbose;
+    serverOptions.udpBandwidth = settings.throttle * 1024;
+    serverOptions.onThreadStarted = &AllocationCounter::IgnoreCurrentThread;
+
+    if (settings.servePort >= 0)
+    {
+        serverOptions.bindAddress = "0.0.0.0";
+        serverOptions.port = settings.servePort;
+        if (!server.Start(serverOptions))
+            return 1;
+        std::cout << "local RT server listening on tcp " << server.TcpPort() << ", udp " << server.UdpPort() << std::endl;
+
+        signal(SIGINT, [](int){ interrupted = 1; });
+        signal(SIGTERM, [](int){ interrupted = 1; });
+        while (!interrupted)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        server.Stop();
+        return 0;
+    }
+
+    LoadGenerator generator(settings);
+    if (!generator.Setup())
+        return 2;
+
+    std::string host = settings.host;
+    int port = settings.port;
+    if (host.empty())
+    {
+        if (!server.Start(serverOptions))
+            return 1;
+        localServer = &server;
+        host = "127.0.0.1";
+        port = server.TcpPort();
+    }
+
+    int result;
+    {
+        GameSparks::Tools::ProfileCapture profile(settings.profile);
+        result = generator.Run(host, port);
+    }
+
+    localServer = nullptr;
+    server.Stop();
+    return result;
+}
@@ -8,6 +8,7 @@
 #include "Bots/ShooterBot.h"
 #include "Bots/ShooterAIController.h"
 #include "Online/ShooterPlayerState.h"
+#include "Player/ShooterCharacterGrid.h"
 
 UBTDecorator_HasLoSTo::UBTDecorator_HasLoSTo(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -88,6 +89,14 @@ bool UBTDecorator_HasLoSTo::CalculateRawConditionValue(UBehaviorTreeComponent& O
 			bGotTarget = true;
 		}
 
+		// characters leave the grid when they die, there is nothing to see
+		const AShooterCharacter* EnemyCharacter = Cast<AShooterCharacter>(EnemyActor);
+		AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		if (EnemyCharacter && GameMode && !GameMode->GetCharacterGrid().Contains(EnemyCharacter))
+		{
+			bGotTarget = false;
+		}
+
 		if (bGotTarget== true )
 		{
 			if (LOSTrace(OwnerComp.GetOwner(), EnemyActor, TargetLocation) == true)
@@ -8,6 +8,7 @@
 #include "Bots/ShooterAIController.h"
 #include "Bots/ShooterBot.h"
 #include "Pickups/ShooterPickup_Ammo.h"
+#include "Pickups/ShooterPickupRegistry.h"
 #include "Weapons/ShooterWeapon_Instant.h"
 
 UBTTask_FindPickup::UBTTask_FindPickup(const FObjectInitializer& ObjectInitializer) 
@@ -30,23 +31,8 @@ EBTNodeResult::Type UBTTask_FindPickup::ExecuteTask(UBehaviorTreeComponent& Owne
 		return EBTNodeResult::Failed;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	AShooterPickup_Ammo* BestPickup = NULL;
-	float BestDistSq = MAX_FLT;
-
-	for (int32 i = 0; i < GameMode->LevelPickups.Num(); ++i)
-	{
-		AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(GameMode->LevelPickups[i]);
-		if (AmmoPickup && AmmoPickup->IsForWeapon(AShooterWeapon_Instant::StaticClass()) && AmmoPickup->CanBePickedUp(MyBot))
-		{
-			const float DistSq = (AmmoPickup->GetActorLocation() - MyLoc).SizeSquared();
-			if (BestDistSq == -1 || DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPickup = AmmoPickup;
-			}
-		}
-	}
+	const AShooterPickup* BestPickup = GameMode->GetPickupRegistry().FindNearest(MyBot->GetActorLocation(), AShooterPickup_Ammo::StaticClass(), AShooterWeapon_Instant::StaticClass(),
+		[MyBot](AShooterPickup* Pickup) { return Pickup->CanBePickedUp(MyBot); });
 
 	if (BestPickup)
 	{
@@ -0,0 +1,207 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Effects/ShooterActorPool.h"
+
+DECLARE_STATS_GROUP(TEXT("ShooterActorPool"), STATGROUP_ShooterActorPool, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Reused"), STAT_ActorPool_Reused, STATGROUP_ShooterActorPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawned"), STAT_ActorPool_Spawned, STATGROUP_ShooterActorPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Released"), STAT_ActorPool_Released, STATGROUP_ShooterActorPool);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Parked"), STAT_ActorPool_Parked, STATGROUP_ShooterActorPool);
+
+static int32 ActorPoolMaxPerClass = 64;
+FAutoConsoleVariableRef CVarActorPoolMaxPerClass(
+	TEXT("p.ActorPoolMaxPerClass"),
+	ActorPoolMaxPerClass,
+	TEXT("Maximum number of parked actors per class, released actors beyond that are destroyed. 0 disables pooling."),
+	ECVF_Default);
+
+UShooterPoolableActor::UShooterPoolableActor(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+}
+
+FShooterActorPool::FShooterActorPool(UWorld* InWorld)
+	: World(InWorld)
+	, bWarmingUp(false)
+{
+}
+
+FShooterActorPool* FShooterActorPool::Get(const UObject* WorldContextObject)
+{
+	UWorld* const MyWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	AShooterGameState* const MyGameState = MyWorld ? MyWorld->GetGameState<AShooterGameState>() : nullptr;
+	return MyGameState ? &MyGameState->GetActorPool() : nullptr;
+}
+
+AActor* FShooterActorPool::BeginSpawn(const UObject* WorldContextObject, UClass* ActorClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	if (ActorClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	FShooterActorPool* const Pool = Get(WorldContextObject);
+	if (AActor* const RecycledActor = Pool ? Pool->Acquire(ActorClass, Transform, Owner, Instigator) : nullptr)
+	{
+		return RecycledActor;
+	}
+
+	UWorld* const MyWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (MyWorld == nullptr)
+	{
+		return nullptr;
+	}
+
+	INC_DWORD_STAT(STAT_ActorPool_Spawned);
+	return MyWorld->SpawnActorDeferred<AActor>(ActorClass, Transform, Owner, Instigator);
+}
+
+void FShooterActorPool::FinishSpawn(AActor* Actor, const FTransform& Transform)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	if (!Actor->HasActorBegunPlay())
+	{
+		UGameplayStatics::FinishSpawningActor(Actor, Transform);
+		return;
+	}
+
+	// recycled actor, undo Park
+	const AActor* const DefaultActor = Actor->GetClass()->GetDefaultObject<AActor>();
+	Actor->SetActorHiddenInGame(DefaultActor->bHidden);
+	Actor->SetActorEnableCollision(DefaultActor->GetActorEnableCollision());
+	Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+	for (UActorComponent* Component : Components)
+	{
+		Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+	}
+
+	CastChecked<IShooterPoolableActor>(Actor)->OnAcquiredFromPool();
+}
+
+bool FShooterActorPool::Release(AActor* Actor)
+{
+	FShooterActorPool* const Pool = Actor ? Get(Actor) : nullptr;
+	return Pool && Pool->Park(Actor);
+}
+
+void FShooterActorPool::WarmUp(UClass* ActorClass, int32 Count)
+{
+	UWorld* const MyWorld = World.Get();
+	if (MyWorld == nullptr || !CanPool(ActorClass))
+	{
+		return;
+	}
+
+	TGuardValue<bool> WarmUpGuard(bWarmingUp, true);
+
+	const TArray<TWeakObjectPtr<AActor>>* FreeList = FreeLists.Find(ActorClass);
+	const int32 NumToSpawn = FMath::Min(Count, ActorPoolMaxPerClass) - (FreeList ? FreeList->Num() : 0);
+	for (int32 i = 0; i < NumToSpawn; ++i)
+	{
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnInfo.ObjectFlags |= RF_Transient;
+
+		AActor* const Actor = MyWorld->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnInfo);
+		if (Actor == nullptr || !Park(Actor))
+		{
+			if (Actor)
+			{
+				Actor->Destroy();
+			}
+			break;
+		}
+	}
+}
+
+bool FShooterActorPool::CanPool(UClass* ActorClass) const
+{
+	const UWorld* const MyWorld = World.Get();
+	if (MyWorld == nullptr || ActorClass == nullptr || ActorPoolMaxPerClass <= 0 || !ActorClass->ImplementsInterface(UShooterPoolableActor::StaticClass()))
+	{
+		return false;
+	}
+
+	const AActor* const DefaultActor = ActorClass->GetDefaultObject<AActor>();
+	return !DefaultActor->GetIsReplicated() || MyWorld->GetNetMode() == NM_Standalone;
+}
+
+int32 FShooterActorPool::NumParked() const
+{
+	int32 Num = 0;
+	for (const auto& FreeList : FreeLists)
+	{
+		Num += FreeList.Value.Num();
+	}
+	return Num;
+}
+
+AActor* FShooterActorPool::Acquire(UClass* ActorClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	if (!CanPool(ActorClass))
+	{
+		return nullptr;
+	}
+
+	TArray<TWeakObjectPtr<AActor>>* const FreeList = FreeLists.Find(ActorClass);
+	while (FreeList && FreeList->Num() > 0)
+	{
+		AActor* const Actor = FreeList->Pop(false).Get();
+		DEC_DWORD_STAT(STAT_ActorPool_Parked);
+
+		// parked actors go away with their level
+		if (Actor && !Actor->IsPendingKillPending())
+		{
+			Actor->SetOwner(Owner);
+			Actor->Instigator = Instigator;
+			Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+
+			INC_DWORD_STAT(STAT_ActorPool_Reused);
+			return Actor;
+		}
+	}
+
+	return nullptr;
+}
+
+bool FShooterActorPool::Park(AActor* Actor)
+{
+	if (Actor->GetWorld() != World.Get() || Actor->IsPendingKillPending() || !CanPool(Actor->GetClass()))
+	{
+		return false;
+	}
+
+	TArray<TWeakObjectPtr<AActor>>& FreeList = FreeLists.FindOrAdd(Actor->GetClass());
+	if (FreeList.Num() >= ActorPoolMaxPerClass)
+	{
+		return false;
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->SetLifeSpan(0.0f);
+
+	// components tick on their own, a parked projectile would keep falling
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+	for (UActorComponent* Component : Components)
+	{
+		Component->SetComponentTickEnabled(false);
+	}
+
+	Actor->SetOwner(nullptr);
+	Actor->Instigator = nullptr;
+
+	CastChecked<IShooterPoolableActor>(Actor)->OnReleasedToPool();
+
+	FreeList.Add(Actor);
+	INC_DWORD_STAT(STAT_ActorPool_Released);
+	INC_DWORD_STAT(STAT_ActorPool_Parked);
+	return true;
+}
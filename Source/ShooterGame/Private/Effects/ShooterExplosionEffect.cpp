@@ -19,12 +19,34 @@ AShooterExplosionEffect::AShooterExplosionEffect(const FObjectInitializer& Objec
 	ExplosionLight->bVisible = true;
 
 	ExplosionLightFadeOut = 0.2f;
+	StartTime = 0.0f;
 }
 
 void AShooterExplosionEffect::BeginPlay()
 {
 	Super::BeginPlay();
 
+	const FShooterActorPool* Pool = FShooterActorPool::Get(this);
+	if (Pool == nullptr || !Pool->IsWarmingUp())
+	{
+		PlayEffect();
+	}
+}
+
+void AShooterExplosionEffect::OnAcquiredFromPool()
+{
+	PlayEffect();
+}
+
+void AShooterExplosionEffect::OnReleasedToPool()
+{
+	SurfaceHit = FHitResult();
+}
+
+void AShooterExplosionEffect::PlayEffect()
+{
+	StartTime = GetWorld()->GetTimeSeconds();
+
 	if (ExplosionFX)
 	{
 		UGameplayStatics::SpawnEmitterAtLocation(this, ExplosionFX, GetActorLocation(), GetActorRotation());
@@ -51,7 +73,7 @@ void AShooterExplosionEffect::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	const float TimeAlive = GetWorld()->GetTimeSeconds() - CreationTime;
+	const float TimeAlive = GetWorld()->GetTimeSeconds() - StartTime;
 	const float TimeRemaining = FMath::Max(0.0f, ExplosionLightFadeOut - TimeAlive);
 
 	if (TimeRemaining > 0)
@@ -61,7 +83,7 @@ void AShooterExplosionEffect::Tick(float DeltaSeconds)
 		UPointLightComponent* DefLight = Cast<UPointLightComponent>(GetClass()->GetDefaultSubobjectByName(ExplosionLightComponentName));
 		ExplosionLight->SetIntensity(DefLight->Intensity * FadeAlpha);
 	}
-	else
+	else if (!FShooterActorPool::Release(this))
 	{
 		Destroy();
 	}
@@ -12,6 +12,38 @@ void AShooterImpactEffect::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
+	const FShooterActorPool* Pool = FShooterActorPool::Get(this);
+	if (Pool == nullptr || !Pool->IsWarmingUp())
+	{
+		PlayEffect();
+	}
+}
+
+void AShooterImpactEffect::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// the effect already played, keep the actor for the next impact (warm up parks it itself)
+	const FShooterActorPool* Pool = FShooterActorPool::Get(this);
+	if (Pool && !Pool->IsWarmingUp())
+	{
+		FShooterActorPool::Release(this);
+	}
+}
+
+void AShooterImpactEffect::OnAcquiredFromPool()
+{
+	PlayEffect();
+	FShooterActorPool::Release(this);
+}
+
+void AShooterImpactEffect::OnReleasedToPool()
+{
+	SurfaceHit = FHitResult();
+}
+
+void AShooterImpactEffect::PlayEffect()
+{
 	UPhysicalMaterial* HitPhysMat = SurfaceHit.PhysMaterial.Get();
 	EPhysicalSurface HitSurfaceType = UPhysicalMaterial::DetermineSurfaceType(HitPhysMat);
 
@@ -10,6 +10,7 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "Weapons/ShooterWeapon.h"
+#include "Player/ShooterCharacterGrid.h"
 
 AShooterEnemyAIController::AShooterEnemyAIController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -57,24 +58,18 @@ void AShooterEnemyAIController::FindClosestEnemy()
 		return;
 	}
 
-	const FVector MyLoc = MyBot->GetActorLocation();
-	float BestDistSq = MAX_FLT;
-	AShooterCharacter* BestPawn = NULL;
-
-	for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode == NULL)
 	{
-		AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
-		if (TestPawn && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-		{
-			const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-			if (DistSq < BestDistSq)
-			{
-				BestDistSq = DistSq;
-				BestPawn = TestPawn;
-			}
-		}
+		return;
 	}
 
+	// characters are visited closest first, so the first enemy is the closest one
+	AShooterCharacter* BestPawn = GameMode->GetCharacterGrid().VisitByDistance(MyBot->GetActorLocation(), MAX_FLT, [this](AShooterCharacter* TestPawn, float DistSq)
+	{
+		return TestPawn->IsAlive() && TestPawn->IsEnemyFor(this);
+	});
+
 	if (BestPawn)
 	{
 		SetEnemy(BestPawn);
@@ -85,28 +80,15 @@ bool AShooterEnemyAIController::FindClosestEnemyWithLOS(AShooterCharacter* Exclu
 {
 	bool bGotEnemy = false;
 	APawn* MyBot = GetPawn();
-	if (MyBot != NULL)
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyBot != NULL && GameMode != NULL)
 	{
-		const FVector MyLoc = MyBot->GetActorLocation();
-		float BestDistSq = MAX_FLT;
-		AShooterCharacter* BestPawn = NULL;
-
-		for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
+		// test enemies closest first and stop at the first one we can see, instead of tracing to all of them
+		AShooterCharacter* BestPawn = GameMode->GetCharacterGrid().VisitByDistance(MyBot->GetActorLocation(), MAX_FLT, [this, ExcludeEnemy](AShooterCharacter* TestPawn, float DistSq)
 		{
-			AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
-			if (TestPawn && TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
-			{
-				if (HasWeaponLOSToEnemy(TestPawn, true) == true)
-				{
-					const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
-					if (DistSq < BestDistSq)
-					{
-						BestDistSq = DistSq;
-						BestPawn = TestPawn;
-					}
-				}
-			}
-		}
+			return TestPawn != ExcludeEnemy && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this) && HasWeaponLOSToEnemy(TestPawn, true);
+		});
+
 		if (BestPawn)
 		{
 			SetEnemy(BestPawn);
@@ -15,10 +15,75 @@ RTSessionInfo::RTSessionInfo(const MatchDetailsResponse& message)
 	for (std::size_t i = 0; i < message.GetOpponents().size(); i++)
 	{
 		RTPlayer* player = new RTPlayer(message.GetOpponents()[i]);
-		PlayerList.Add(MakeShareable(player));
+		AddPlayer(MakeShareable(player));
 	}
 }
 
 RTSessionInfo::~RTSessionInfo()
 {
 }
+
+void RTSessionInfo::AddPlayer(const TSharedPtr<RTPlayer>& Player)
+{
+	if (!Player.IsValid())
+	{
+		return;
+	}
+
+	RemovePlayer(Player->PeerID);
+	const int32 PlayerIndex = PlayerList.Add(Player);
+
+	if (Player->PeerID >= 0 && Player->PeerID < MaxIndexedPeerId)
+	{
+		if (Player->PeerID >= PlayerIndexByPeerId.Num())
+		{
+			const int32 NumAdded = Player->PeerID + 1 - PlayerIndexByPeerId.Num();
+			PlayerIndexByPeerId.Reserve(Player->PeerID + 1);
+			for (int32 i = 0; i < NumAdded; i++)
+			{
+				PlayerIndexByPeerId.Add(INDEX_NONE);
+			}
+		}
+		PlayerIndexByPeerId[Player->PeerID] = PlayerIndex;
+	}
+}
+
+void RTSessionInfo::RemovePlayer(int InPeerId)
+{
+	for (int32 PlayerIndex = 0; PlayerIndex < PlayerList.Num(); PlayerIndex++)
+	{
+		if (PlayerList[PlayerIndex]->PeerID != InPeerId)
+		{
+			continue;
+		}
+
+		if (InPeerId >= 0 && InPeerId < PlayerIndexByPeerId.Num())
+		{
+			PlayerIndexByPeerId[InPeerId] = INDEX_NONE;
+		}
+
+		// the last player takes the freed slot
+		PlayerList.RemoveAtSwap(PlayerIndex, 1, false);
+		if (PlayerIndex < PlayerList.Num())
+		{
+			const int32 MovedPeerId = PlayerList[PlayerIndex]->PeerID;
+			if (MovedPeerId >= 0 && MovedPeerId < PlayerIndexByPeerId.Num())
+			{
+				PlayerIndexByPeerId[MovedPeerId] = PlayerIndex;
+			}
+		}
+		return;
+	}
+}
+
+RTPlayer* RTSessionInfo::FindPlayerSlow(int InPeerId) const
+{
+	for (const TSharedPtr<RTPlayer>& Player : PlayerList)
+	{
+		if (Player->PeerID == InPeerId)
+		{
+			return Player.Get();
+		}
+	}
+	return nullptr;
+}
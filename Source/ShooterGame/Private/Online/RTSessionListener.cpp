@@ -32,10 +32,16 @@ void RTSessionListener::OnReady(bool ready)
 
 void RTSessionListener::OnPacket(const RTPacket& packet)
 {
-	UE_LOG(LogOnlineGame, Log, TEXT("GSM| OnPacket"));
+	UE_LOG(LogOnlineGame, VeryVerbose, TEXT("GSM| OnPacket %d"), packet.OpCode);
 	GameInstance->OnPacket(packet);
 }
 
+bool RTSessionListener::OnPacketReceived(const RTPacket& packet)
+{
+	// RT socket thread
+	return GameInstance && GameInstance->GetRTPacketRouter().DispatchReceiveThread(*GameInstance, packet);
+}
+
 RTSessionListener::~RTSessionListener()
 {
 	GameInstance = nullptr;
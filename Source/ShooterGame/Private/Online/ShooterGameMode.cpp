@@ -9,6 +9,10 @@
 #include "Online/ShooterPlayerState.h"
 #include "Online/ShooterGameSession.h"
 #include "Bots/ShooterAIController.h"
+#include "Player/ShooterPauseRelevancy.h"
+#include "Player/ShooterCharacterGrid.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Weapons/ShooterExplosionBatcher.h"
 #include "ShooterTeamStart.h"
 
 
@@ -31,6 +35,12 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
+
+	SpawnDangerRadius = 3000.0f;
+	SpawnDeathMemory = 10.0f;
+	PIESpawnPoint = NULL;
+	bSpawnPointsGathered = false;
+	RecentDeathIndex = 0;
 	bUseSeamlessTravel = true;	
 }
 
@@ -39,6 +49,42 @@ FString AShooterGameMode::GetBotsCountOptionName()
 	return FString(TEXT("Bots"));
 }
 
+FShooterPauseRelevancy& AShooterGameMode::GetPauseRelevancy()
+{
+	if (!PauseRelevancy.IsValid())
+	{
+		PauseRelevancy = MakeShareable(new FShooterPauseRelevancy(GetWorld()));
+	}
+	return *PauseRelevancy;
+}
+
+FShooterCharacterGrid& AShooterGameMode::GetCharacterGrid()
+{
+	if (!CharacterGrid.IsValid())
+	{
+		CharacterGrid = MakeShareable(new FShooterCharacterGrid());
+	}
+	return *CharacterGrid;
+}
+
+FShooterPickupRegistry& AShooterGameMode::GetPickupRegistry()
+{
+	if (!PickupRegistry.IsValid())
+	{
+		PickupRegistry = MakeShareable(new FShooterPickupRegistry());
+	}
+	return *PickupRegistry;
+}
+
+FShooterExplosionBatcher& AShooterGameMode::GetExplosionBatcher()
+{
+	if (!ExplosionBatcher.IsValid())
+	{
+		ExplosionBatcher = MakeShareable(new FShooterExplosionBatcher(GetWorld()));
+	}
+	return *ExplosionBatcher;
+}
+
 void AShooterGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
 	const int32 BotsCountOptionValue = UGameplayStatics::GetIntOption(Options, GetBotsCountOptionName(), 0);
@@ -300,6 +346,21 @@ void AShooterGameMode::Killed(AController* Killer, AController* KilledPlayer, AP
 		VictimPlayerState->ScoreDeath(KillerPlayerState, DeathScore);
 		VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
 	}
+
+	if (KilledPawn)
+	{
+		const int32 MaxRecentDeaths = 32;
+		const FShooterRecentDeath Death = { KilledPawn->GetActorLocation(), GetWorld()->GetTimeSeconds() };
+		if (RecentDeaths.Num() < MaxRecentDeaths)
+		{
+			RecentDeaths.Add(Death);
+		}
+		else
+		{
+			RecentDeaths[RecentDeathIndex] = Death;
+		}
+		RecentDeathIndex = (RecentDeathIndex + 1) % MaxRecentDeaths;
+	}
 }
 
 float AShooterGameMode::ModifyDamage(float Damage, AActor* DamagedActor, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) const
@@ -355,49 +416,134 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController_Implementation(AContr
 
 AActor* AShooterGameMode::ChoosePlayerStart_Implementation(AController* Player)
 {
-	TArray<APlayerStart*> PreferredSpawns;
-	TArray<APlayerStart*> FallbackSpawns;
+	// GC nulls the entries of starts that were destroyed or streamed out. The candidate lists index into
+	// SpawnPoints, so both are gathered again, which also picks up starts of newly streamed levels.
+	if (bSpawnPointsGathered && SpawnPoints.ContainsByPredicate([](const APlayerStart* SpawnPoint) { return !IsValid(SpawnPoint); }))
+	{
+		bSpawnPointsGathered = false;
+		SpawnPoints.Reset();
+		SpawnCandidates.Reset();
+	}
 
-	APlayerStart* BestStart = NULL;
-	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	// Gather the spawn points once instead of on every respawn
+	if (!bSpawnPointsGathered)
 	{
-		APlayerStart* TestSpawn = *It;
-		if (TestSpawn->IsA<APlayerStartPIE>())
+		bSpawnPointsGathered = true;
+		for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
 		{
-			// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
-			BestStart = TestSpawn;
-			break;
+			APlayerStart* TestSpawn = *It;
+			if (TestSpawn->IsA<APlayerStartPIE>())
+			{
+				// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
+				PIESpawnPoint = TestSpawn;
+				break;
+			}
+			SpawnPoints.Add(TestSpawn);
 		}
-		else
+	}
+
+	if (PIESpawnPoint)
+	{
+		return PIESpawnPoint;
+	}
+
+	// All respawns of a frame share one scoring pass. Every pick raises the danger of its spawn point,
+	// so a respawn storm spreads out instead of stacking on the safest point.
+	FShooterSpawnCandidates& Candidates = GetSpawnCandidates(Player);
+	if (Candidates.ScoreFrame != GFrameCounter)
+	{
+		ScoreSpawnCandidates(Candidates, Player);
+	}
+
+	const float ScoreJitter = 0.25f;
+	int32 BestCandidate = INDEX_NONE;
+	float BestScore = MAX_FLT;
+	bool bBestIsFree = false;
+	for (int32 i = 0; i < Candidates.SpawnIndices.Num(); ++i)
+	{
+		// free spawn points always win over occupied ones, then the least dangerous one, with a little randomness for variety
+		const bool bIsFree = !Candidates.bOccupied[i];
+		const float Score = Candidates.Danger[i] + FMath::FRand() * ScoreJitter;
+		if ((bIsFree && !bBestIsFree) || (bIsFree == bBestIsFree && Score < BestScore))
+		{
+			BestCandidate = i;
+			BestScore = Score;
+			bBestIsFree = bIsFree;
+		}
+	}
+
+	if (BestCandidate != INDEX_NONE)
+	{
+		Candidates.bOccupied[BestCandidate] = true;
+		Candidates.Danger[BestCandidate] += 1.0f;
+		return SpawnPoints[Candidates.SpawnIndices[BestCandidate]];
+	}
+
+	return Super::ChoosePlayerStart_Implementation(Player);
+}
+
+FShooterSpawnCandidates& AShooterGameMode::GetSpawnCandidates(AController* Player)
+{
+	const AShooterPlayerState* PlayerState = Player ? Cast<AShooterPlayerState>(Player->PlayerState) : NULL;
+	const FIntPoint Key(PlayerState ? PlayerState->GetTeamNum() : INDEX_NONE, Cast<AShooterAIController>(Player) != NULL ? 1 : 0);
+
+	FShooterSpawnCandidates* Candidates = SpawnCandidates.Find(Key);
+	if (Candidates == NULL)
+	{
+		Candidates = &SpawnCandidates.Add(Key);
+		for (int32 SpawnIdx = 0; SpawnIdx < SpawnPoints.Num(); ++SpawnIdx)
 		{
-			if (IsSpawnpointAllowed(TestSpawn, Player))
+			if (IsSpawnpointAllowed(SpawnPoints[SpawnIdx], Player))
 			{
-				if (IsSpawnpointPreferred(TestSpawn, Player))
-				{
-					PreferredSpawns.Add(TestSpawn);
-				}
-				else
-				{
-					FallbackSpawns.Add(TestSpawn);
-				}
+				Candidates->SpawnIndices.Add(SpawnIdx);
 			}
 		}
+		Candidates->Danger.SetNumZeroed(Candidates->SpawnIndices.Num());
+		Candidates->bOccupied.SetNumZeroed(Candidates->SpawnIndices.Num());
 	}
 
-	
-	if (BestStart == NULL)
+	return *Candidates;
+}
+
+void AShooterGameMode::ScoreSpawnCandidates(FShooterSpawnCandidates& Candidates, AController* Player) const
+{
+	Candidates.ScoreFrame = GFrameCounter;
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = 0; i < Candidates.SpawnIndices.Num(); ++i)
 	{
-		if (PreferredSpawns.Num() > 0)
+		APlayerStart* Spawn = SpawnPoints[Candidates.SpawnIndices[i]];
+		const FVector SpawnLocation = Spawn->GetActorLocation();
+
+		// enemies close to the spawn point, weighted by proximity
+		float Danger = 0.0f;
+		if (CharacterGrid.IsValid())
 		{
-			BestStart = PreferredSpawns[FMath::RandHelper(PreferredSpawns.Num())];
+			CharacterGrid->VisitByDistance(SpawnLocation, SpawnDangerRadius, [&](AShooterCharacter* Character, float DistSq)
+			{
+				if (Character->IsEnemyFor(Player))
+				{
+					Danger += 1.0f - FMath::Sqrt(DistSq) / SpawnDangerRadius;
+				}
+				return false;
+			});
 		}
-		else if (FallbackSpawns.Num() > 0)
+
+		// recent deaths close to the spawn point, fading out over SpawnDeathMemory
+		for (const FShooterRecentDeath& Death : RecentDeaths)
 		{
-			BestStart = FallbackSpawns[FMath::RandHelper(FallbackSpawns.Num())];
+			const float Age = Now - Death.Time;
+			const float Dist = (Death.Location - SpawnLocation).Size();
+			if (Age < SpawnDeathMemory && Dist < SpawnDangerRadius)
+			{
+				Danger += 0.5f * (1.0f - Age / SpawnDeathMemory) * (1.0f - Dist / SpawnDangerRadius);
+			}
 		}
-	}
 
-	return BestStart ? BestStart : Super::ChoosePlayerStart_Implementation(Player);
+		Candidates.Danger[i] = Danger;
+		Candidates.bOccupied[i] = !IsSpawnpointPreferred(Spawn, Player);
+	}
 }
 
 bool AShooterGameMode::IsSpawnpointAllowed(APlayerStart* SpawnPoint, AController* Player) const
@@ -433,29 +579,31 @@ bool AShooterGameMode::IsSpawnpointPreferred(APlayerStart* SpawnPoint, AControll
 	if (MyPawn)
 	{
 		const FVector SpawnLocation = SpawnPoint->GetActorLocation();
-		for (FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It)
-		{
-			ACharacter* OtherPawn = Cast<ACharacter>(*It);
-			if (OtherPawn && OtherPawn != MyPawn)
-			{
-				const float CombinedHeight = (MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
-				const float CombinedRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius() + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
-				const FVector OtherLocation = OtherPawn->GetActorLocation();
+		const float MyHalfHeight = MyPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		const float MyRadius = MyPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
 
-				// check if player start overlaps this pawn
-				if (FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius)
-				{
-					return false;
-				}
-			}
+		// no grid yet means no character was spawned yet
+		if (!CharacterGrid.IsValid())
+		{
+			return true;
 		}
-	}
-	else
-	{
-		return false;
+
+		// only pawns near the spawn point can overlap it. The search radius assumes the other pawns are at most as big as ours.
+		const float SearchRadius = 4.0f * (MyHalfHeight + MyRadius);
+		AShooterCharacter* BlockingPawn = CharacterGrid->VisitByDistance(SpawnLocation, SearchRadius, [&](AShooterCharacter* OtherPawn, float DistSq)
+		{
+			const float CombinedHeight = (MyHalfHeight + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()) * 2.0f;
+			const float CombinedRadius = MyRadius + OtherPawn->GetCapsuleComponent()->GetScaledCapsuleRadius();
+			const FVector OtherLocation = OtherPawn->GetActorLocation();
+
+			// check if player start overlaps this pawn
+			return FMath::Abs(SpawnLocation.Z - OtherLocation.Z) < CombinedHeight && (SpawnLocation - OtherLocation).Size2D() < CombinedRadius;
+		});
+
+		return BlockingPawn == NULL;
 	}
 	
-	return true;
+	return false;
 }
 
 void AShooterGameMode::CreateBotControllers()
@@ -33,34 +33,98 @@ void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty >
 	
 }
 
-void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
+void AShooterGameState::BeginPlay()
 {
-	OutRankedMap.Empty();
+	Super::BeginPlay();
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+	for (const FShooterActorPoolWarmUp& WarmUp : ActorPoolWarmUp)
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		if (UClass* ActorClass = WarmUp.ActorClass.LoadSynchronous())
 		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->Score), CurPlayerState);
+			GetActorPool().WarmUp(ActorClass, WarmUp.Count);
 		}
 	}
+}
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+FShooterActorPool& AShooterGameState::GetActorPool()
+{
+	if (!ActorPool.IsValid())
+	{
+		ActorPool = MakeShareable(new FShooterActorPool(GetWorld()));
+	}
+	return *ActorPool;
+}
+
+FShooterWeaponTraces& AShooterGameState::GetWeaponTraces()
+{
+	if (!WeaponTraces.IsValid())
+	{
+		WeaponTraces = MakeShareable(new FShooterWeaponTraces(GetWorld()));
+	}
+	return *WeaponTraces;
+}
 
-	//now, add them back to the ranked map
+void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const
+{
 	OutRankedMap.Empty();
 
-	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+	const int32 NumPlayers = PlayerRanking.GetNumPlayers(TeamIndex);
+	for (int32 Rank = 0; Rank < NumPlayers; ++Rank)
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		OutRankedMap.Add(Rank, PlayerRanking.GetPlayer(TeamIndex, Rank));
 	}
-	
+}
+
+int32 AShooterGameState::GetPlayerRank(const AShooterPlayerState* PlayerState) const
+{
+	return PlayerRanking.GetRank(PlayerState);
+}
+
+int32 AShooterGameState::GetNumRankedPlayers(int32 TeamIndex) const
+{
+	return PlayerRanking.GetNumPlayers(TeamIndex);
+}
+
+AShooterPlayerState* AShooterGameState::GetRankedPlayer(int32 TeamIndex, int32 Rank) const
+{
+	return PlayerRanking.GetPlayer(TeamIndex, Rank);
+}
+
+bool AShooterGameState::UpdatePlayerRanking(AShooterPlayerState* PlayerState)
+{
+	if (!PlayerRanking.Update(PlayerState))
+	{
+		return false;
+	}
+
+	OnPlayerStatsChange.Broadcast(PlayerState);
+	return true;
+}
+
+void AShooterGameState::NotifyPlayerStatsChanged(AShooterPlayerState* PlayerState)
+{
+	OnPlayerStatsChange.Broadcast(PlayerState);
+}
+
+void AShooterGameState::AddPlayerState(APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+
+	// inactive player states don't make it into PlayerArray
+	if (!PlayerState->bIsInactive)
+	{
+		PlayerRanking.Add(Cast<AShooterPlayerState>(PlayerState));
+		OnPlayerStatsChange.Broadcast(Cast<AShooterPlayerState>(PlayerState));
+	}
+}
+
+void AShooterGameState::RemovePlayerState(APlayerState* PlayerState)
+{
+	PlayerRanking.Remove(Cast<AShooterPlayerState>(PlayerState));
+
+	Super::RemovePlayerState(PlayerState);
+
+	OnPlayerStatsChange.Broadcast(Cast<AShooterPlayerState>(PlayerState));
 }
 
 
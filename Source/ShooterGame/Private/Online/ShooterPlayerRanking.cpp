@@ -0,0 +1,119 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterPlayerRanking.h"
+#include "Online/ShooterPlayerState.h"
+
+FShooterPlayerRanking::FKey FShooterPlayerRanking::MakeKey(const AShooterPlayerState* PlayerState)
+{
+	return FKey{ PlayerState->GetTeamNum(), FMath::TruncToInt(PlayerState->Score), PlayerState->PlayerId };
+}
+
+void FShooterPlayerRanking::Add(AShooterPlayerState* PlayerState)
+{
+	if (PlayerState && !Keys.Contains(PlayerState))
+	{
+		Insert(MakeKey(PlayerState), PlayerState);
+	}
+}
+
+void FShooterPlayerRanking::Remove(const AShooterPlayerState* PlayerState)
+{
+	FKey Key;
+	if (Keys.RemoveAndCopyValue(PlayerState, Key) && Key.TeamIndex >= 0)
+	{
+		const int32 Index = Find(Key, PlayerState);
+		if (ensure(Index != INDEX_NONE))
+		{
+			Teams[Key.TeamIndex].RemoveAt(Index, 1, false);
+		}
+	}
+}
+
+bool FShooterPlayerRanking::Update(AShooterPlayerState* PlayerState)
+{
+	const FKey* OldKey = Keys.Find(PlayerState);
+	if (OldKey == nullptr)
+	{
+		return false;
+	}
+
+	const FKey NewKey = MakeKey(PlayerState);
+	if (NewKey.TeamIndex == OldKey->TeamIndex && NewKey.Score == OldKey->Score && NewKey.PlayerId == OldKey->PlayerId)
+	{
+		return false;
+	}
+
+	Remove(PlayerState);
+	Insert(NewKey, PlayerState);
+	return true;
+}
+
+int32 FShooterPlayerRanking::GetRank(const AShooterPlayerState* PlayerState) const
+{
+	const FKey* Key = Keys.Find(PlayerState);
+	return (Key && Key->TeamIndex >= 0) ? Find(*Key, PlayerState) : INDEX_NONE;
+}
+
+int32 FShooterPlayerRanking::GetNumPlayers(int32 TeamIndex) const
+{
+	return Teams.IsValidIndex(TeamIndex) ? Teams[TeamIndex].Num() : 0;
+}
+
+AShooterPlayerState* FShooterPlayerRanking::GetPlayer(int32 TeamIndex, int32 Rank) const
+{
+	return (Teams.IsValidIndex(TeamIndex) && Teams[TeamIndex].IsValidIndex(Rank)) ? Teams[TeamIndex][Rank].PlayerState : nullptr;
+}
+
+int32 FShooterPlayerRanking::LowerBound(const FKey& Key) const
+{
+	const TArray<FEntry>& Entries = Teams[Key.TeamIndex];
+
+	int32 Begin = 0;
+	int32 End = Entries.Num();
+	while (Begin < End)
+	{
+		const int32 Mid = (Begin + End) / 2;
+		if (Entries[Mid].Key.RanksBefore(Key))
+		{
+			Begin = Mid + 1;
+		}
+		else
+		{
+			End = Mid;
+		}
+	}
+	return Begin;
+}
+
+int32 FShooterPlayerRanking::Find(const FKey& Key, const AShooterPlayerState* PlayerState) const
+{
+	const TArray<FEntry>& Entries = Teams[Key.TeamIndex];
+
+	// keys aren't unique until the player id is known, so look for the player among the entries with the same key
+	for (int32 Index = LowerBound(Key); Index < Entries.Num() && !Key.RanksBefore(Entries[Index].Key); Index++)
+	{
+		if (Entries[Index].PlayerState == PlayerState)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FShooterPlayerRanking::Insert(const FKey& Key, AShooterPlayerState* PlayerState)
+{
+	Keys.Add(PlayerState, Key);
+
+	// players without a team are known but not ranked
+	if (Key.TeamIndex < 0)
+	{
+		return;
+	}
+
+	if (Key.TeamIndex >= Teams.Num())
+	{
+		Teams.SetNum(Key.TeamIndex + 1);
+	}
+	Teams[Key.TeamIndex].Insert(FEntry{ Key, PlayerState }, LowerBound(Key));
+}
@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "ShooterPlayerState.h"
 
+FOnShooterPlayerStateScoreChange AShooterPlayerState::NotifyScoreChange;
+
 AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	TeamNumber = 0;
@@ -11,6 +13,7 @@ AShooterPlayerState::AShooterPlayerState(const FObjectInitializer& ObjectInitial
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
+	RankedPlayerId = 0;
 }
 
 void AShooterPlayerState::Reset()
@@ -24,6 +27,16 @@ void AShooterPlayerState::Reset()
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
+
+	UpdateRanking();
+	NotifyStatsChanged();
+}
+
+void AShooterPlayerState::RegisterPlayerWithSession(bool bWasFromInvite)
+{
+	Super::RegisterPlayerWithSession(bWasFromInvite);
+
+	UpdateRanking();
 }
 
 void AShooterPlayerState::UnregisterPlayerWithSession()
@@ -46,11 +59,61 @@ void AShooterPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	UpdateRanking();
 }
 
 void AShooterPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	UpdateRanking();
+}
+
+void AShooterPlayerState::OnRep_Score()
+{
+	Super::OnRep_Score();
+
+	UpdateRanking();
+}
+
+void AShooterPlayerState::OnRep_PlayerName()
+{
+	Super::OnRep_PlayerName();
+
+	NotifyStatsChanged();
+}
+
+void AShooterPlayerState::PostNetReceive()
+{
+	Super::PostNetReceive();
+
+	if (PlayerId != RankedPlayerId)
+	{
+		RankedPlayerId = PlayerId;
+		UpdateRanking();
+	}
+}
+
+void AShooterPlayerState::OnRep_Stats()
+{
+	NotifyStatsChanged();
+}
+
+void AShooterPlayerState::NotifyStatsChanged()
+{
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->NotifyPlayerStatsChanged(this);
+	}
+}
+
+void AShooterPlayerState::UpdateRanking()
+{
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->UpdatePlayerRanking(this);
+	}
 }
 
 void AShooterPlayerState::AddBulletsFired(int32 NumBullets)
@@ -81,6 +144,7 @@ void AShooterPlayerState::CopyProperties(APlayerState* PlayerState)
 	if (ShooterPlayer)
 	{
 		ShooterPlayer->TeamNumber = TeamNumber;
+		ShooterPlayer->UpdateRanking();
 	}	
 }
 
@@ -158,6 +222,14 @@ void AShooterPlayerState::ScorePoints(int32 Points)
 	}
 
 	Score += Points;
+
+	// kills or deaths changed too, so the scoreboard needs to hear about it even if the score stayed put
+	if (MyGameState && !MyGameState->UpdatePlayerRanking(this))
+	{
+		MyGameState->NotifyPlayerStatsChanged(this);
+	}
+
+	NotifyScoreChange.Broadcast(this);
 }
 
 void AShooterPlayerState::InformAboutKill_Implementation(class AShooterPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* KilledPlayerState)
@@ -0,0 +1,65 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterRTNetworkThread.h"
+#include <GameSparksRT/IRTSession.hpp>
+
+static float RTNetworkTickRate = 120.0f;
+FAutoConsoleVariableRef CVarRTNetworkTickRate(
+	TEXT("p.RTNetworkTickRate"),
+	RTNetworkTickRate,
+	TEXT("Rate in Hz at which the RT session connection is serviced on its own thread. 0: once per frame from the game instance tick, as before. Enabling or disabling applies to the next session."),
+	ECVF_Default);
+
+FShooterRTNetworkThread::FShooterRTNetworkThread(GameSparks::RT::IRTSession& InSession)
+	: Session(InSession)
+	, Thread(nullptr)
+{
+	Thread = FRunnableThread::Create(this, TEXT("ShooterRTNetworkThread"), 0, TPri_AboveNormal);
+}
+
+FShooterRTNetworkThread::~FShooterRTNetworkThread()
+{
+	if (Thread)
+	{
+		// waits for Run to return
+		Thread->Kill(true);
+		delete Thread;
+	}
+}
+
+TUniquePtr<FShooterRTNetworkThread> FShooterRTNetworkThread::Create(GameSparks::RT::IRTSession& Session)
+{
+	if (RTNetworkTickRate <= 0.0f || !FPlatformProcess::SupportsMultithreading())
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FShooterRTNetworkThread> NetworkThread(new FShooterRTNetworkThread(Session));
+	if (NetworkThread->Thread == nullptr)
+	{
+		return nullptr;
+	}
+	return NetworkThread;
+}
+
+uint32 FShooterRTNetworkThread::Run()
+{
+	double NextUpdateTime = FPlatformTime::Seconds();
+	while (!bStopping)
+	{
+		Session.UpdateConnection();
+
+		// fixed rate, but don't try to catch up after a stall
+		const double TickInterval = 1.0 / FMath::Clamp(RTNetworkTickRate, 10.0f, 1000.0f);
+		const double Now = FPlatformTime::Seconds();
+		NextUpdateTime = FMath::Max(NextUpdateTime + TickInterval, Now);
+		FPlatformProcess::SleepNoStats(NextUpdateTime - Now);
+	}
+	return 0;
+}
+
+void FShooterRTNetworkThread::Stop()
+{
+	bStopping = true;
+}
@@ -0,0 +1,169 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterRTPacketRouter.h"
+#include "ShooterGameInstance.h"
+
+DECLARE_STATS_GROUP(TEXT("ShooterRT"), STATGROUP_ShooterRT, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Game thread handlers"), STAT_RT_GameThreadHandlers, STATGROUP_ShooterRT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Game thread packets"), STAT_RT_GameThreadPackets, STATGROUP_ShooterRT);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Max receive to handler ms"), STAT_RT_MaxReceiveToHandler, STATGROUP_ShooterRT);
+
+namespace ShooterRTPacketRouter
+{
+	typedef bool (*FDecodeAndHandleFunc)(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet);
+
+	/** Decodes the packet into PacketType and passes it to Handler, returns false if it doesn't decode */
+	template<typename PacketType, void (UShooterGameInstance::*Handler)(const PacketType&)>
+	bool DecodeAndHandle(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet)
+	{
+		PacketType DecodedPacket;
+		if (!PacketType::Decode(Packet, DecodedPacket))
+		{
+			return false;
+		}
+		(GameInstance.*Handler)(DecodedPacket);
+		return true;
+	}
+
+	struct FHandler
+	{
+		EShooterRTOpCode::Type OpCode;
+		EShooterRTThread::Type Thread;
+		FDecodeAndHandleFunc DecodeAndHandle;
+	};
+
+	/** Handlers of the RT opcodes, one per opcode */
+	static const FHandler Handlers[] =
+	{
+		{ EShooterRTOpCode::Chat, EShooterRTThread::GameThread, &DecodeAndHandle<FShooterRTChatPacket, &UShooterGameInstance::OnRTChatPacket> },
+	};
+}
+
+bool FShooterRTChatPacket::Decode(const GameSparks::RT::RTPacket& Packet, FShooterRTChatPacket& OutPacket)
+{
+	const GameSparks::System::Nullable<gsstl::string> Message = Packet.Data.GetString(1);
+	if (!Message.HasValue())
+	{
+		return false;
+	}
+
+	OutPacket.Sender = Packet.Sender;
+	OutPacket.Message = Message.Value();
+	return true;
+}
+
+FShooterRTPacketRouter::FShooterRTPacketRouter()
+{
+	ResetCounters();
+
+	for (int32 OpCode = 0; OpCode < EShooterRTOpCode::Max; OpCode++)
+	{
+		HandlerIndexByOpCode[OpCode] = INDEX_NONE;
+	}
+
+	for (int32 HandlerIndex = 0; HandlerIndex < ARRAY_COUNT(ShooterRTPacketRouter::Handlers); HandlerIndex++)
+	{
+		const int32 OpCode = ShooterRTPacketRouter::Handlers[HandlerIndex].OpCode;
+		checkf(OpCode > 0 && OpCode < EShooterRTOpCode::Max && HandlerIndexByOpCode[OpCode] == INDEX_NONE, TEXT("RT opcode %d is out of range or handled twice"), OpCode);
+		HandlerIndexByOpCode[OpCode] = HandlerIndex;
+	}
+}
+
+bool FShooterRTPacketRouter::DispatchReceiveThread(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet)
+{
+	const int32 HandlerIndex = (Packet.OpCode > 0 && Packet.OpCode < EShooterRTOpCode::Max) ? HandlerIndexByOpCode[Packet.OpCode] : INDEX_NONE;
+	if (HandlerIndex == INDEX_NONE || ShooterRTPacketRouter::Handlers[HandlerIndex].Thread != EShooterRTThread::ReceiveThread)
+	{
+		ReceiveCycles.Enqueue(FPlatformTime::Cycles64());
+		return false;
+	}
+
+	Dispatch(GameInstance, Packet, HandlerIndex);
+	return true;
+}
+
+void FShooterRTPacketRouter::DispatchGameThread(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet)
+{
+	check(IsInGameThread());
+
+	uint64 ReceivedCycles = 0;
+	if (ReceiveCycles.Dequeue(ReceivedCycles))
+	{
+		const uint64 WaitCycles = FPlatformTime::Cycles64() - ReceivedCycles;
+		++NumQueuedPackets;
+		QueuedCycles += WaitCycles;
+		MaxQueuedCycles = FMath::Max(MaxQueuedCycles, WaitCycles);
+		SET_FLOAT_STAT(STAT_RT_MaxReceiveToHandler, FPlatformTime::ToMilliseconds64(MaxQueuedCycles));
+	}
+
+	const int32 HandlerIndex = (Packet.OpCode > 0 && Packet.OpCode < EShooterRTOpCode::Max) ? HandlerIndexByOpCode[Packet.OpCode] : INDEX_NONE;
+	if (HandlerIndex == INDEX_NONE)
+	{
+		++UnhandledPackets;
+		UE_LOG(LogOnlineGame, Verbose, TEXT("GSM| No handler for RT opcode %d"), Packet.OpCode);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_RT_GameThreadHandlers);
+	INC_DWORD_STAT(STAT_RT_GameThreadPackets);
+	Dispatch(GameInstance, Packet, HandlerIndex);
+}
+
+void FShooterRTPacketRouter::Dispatch(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet, int32 HandlerIndex)
+{
+	FShooterRTOpCodeCounters& OpCodeCounters = Counters[Packet.OpCode];
+	++OpCodeCounters.Packets;
+	OpCodeCounters.Bytes += (int64)Packet.Payload.size();
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	if (!ShooterRTPacketRouter::Handlers[HandlerIndex].DecodeAndHandle(GameInstance, Packet))
+	{
+		++OpCodeCounters.Dropped;
+	}
+	OpCodeCounters.HandlerCycles += (int64)(FPlatformTime::Cycles64() - StartCycles);
+}
+
+void FShooterRTPacketRouter::DumpCounters(FOutputDevice& Ar) const
+{
+	for (int32 OpCode = 0; OpCode < EShooterRTOpCode::Max; OpCode++)
+	{
+		const FShooterRTOpCodeCounters& OpCodeCounters = Counters[OpCode];
+		const int64 NumPackets = OpCodeCounters.Packets;
+		if (NumPackets > 0)
+		{
+			const double HandlerMs = FPlatformTime::ToMilliseconds64((int64)OpCodeCounters.HandlerCycles);
+			Ar.Logf(TEXT("RT opcode %d: %lld packets, %lld payload bytes, %lld dropped, %.3f ms handling (%.3f us per packet)"),
+				OpCode, NumPackets, (int64)OpCodeCounters.Bytes, (int64)OpCodeCounters.Dropped, HandlerMs, HandlerMs * 1000.0 / NumPackets);
+		}
+	}
+	Ar.Logf(TEXT("RT packets without handler: %lld"), (int64)UnhandledPackets);
+
+	if (NumQueuedPackets > 0)
+	{
+		Ar.Logf(TEXT("RT receive to game thread handler: %lld packets, %.3f ms average, %.3f ms max"),
+			NumQueuedPackets, FPlatformTime::ToMilliseconds64(QueuedCycles) / NumQueuedPackets, FPlatformTime::ToMilliseconds64(MaxQueuedCycles));
+	}
+}
+
+void FShooterRTPacketRouter::BeginSession()
+{
+	ReceiveCycles.Empty();
+	ResetCounters();
+}
+
+void FShooterRTPacketRouter::ResetCounters()
+{
+	for (int32 OpCode = 0; OpCode < EShooterRTOpCode::Max; OpCode++)
+	{
+		Counters[OpCode].Packets = 0;
+		Counters[OpCode].Bytes = 0;
+		Counters[OpCode].Dropped = 0;
+		Counters[OpCode].HandlerCycles = 0;
+	}
+	UnhandledPackets = 0;
+
+	NumQueuedPackets = 0;
+	QueuedCycles = 0;
+	MaxQueuedCycles = 0;
+}
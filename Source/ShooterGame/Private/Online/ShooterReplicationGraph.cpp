@@ -38,7 +38,8 @@
 *		UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
 *		A custom node for handling player state replication. This replicates a small rolling set of player states (currently 2/frame). This is so player states replicate
 *		to simulated connections at a low, steady frequency, and to take advantage of serialization sharing. Auto proxy player states are replicated at higher frequency (to the
-*		owning connection only) via UShooterReplicationGraphNode_AlwaysRelevant_ForConnection.
+*		owning connection only) via UShooterReplicationGraphNode_AlwaysRelevant_ForConnection. The rolling set is kept in persistent buckets updated as player states are
+*		routed in and out, and player states whose score changed (AShooterPlayerState::NotifyScoreChange) are sent on the next frame instead of waiting for their bucket.
 *		
 *		UReplicationGraphNode_TearOff_ForConnection
 *		Connection specific node for handling tear off actors. This is created and managed in the base implementation of Replication Graph.
@@ -202,7 +203,7 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 
 	AddInfo( AShooterWeapon::StaticClass(),							EClassRepNodeMapping::NotRouted);				// Handled via DependantActor replication (Pawn)
 	AddInfo( ALevelScriptActor::StaticClass(),						EClassRepNodeMapping::NotRouted);				// Not needed
-	AddInfo( APlayerState::StaticClass(),							EClassRepNodeMapping::NotRouted);				// Special cased via UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
+	AddInfo( APlayerState::StaticClass(),							EClassRepNodeMapping::PlayerState);				// Routes to UShooterReplicationGraphNode_PlayerStateFrequencyLimiter
 	AddInfo( AReplicationGraphDebugActor::StaticClass(),			EClassRepNodeMapping::NotRouted);				// Not needed. Replicated special case inside RepGraph
 	AddInfo( AInfo::StaticClass(),									EClassRepNodeMapping::RelevantAllConnections);	// Non spatialized, relevant to all
 	AddInfo( AShooterPickup::StaticClass(),							EClassRepNodeMapping::Spatialize_Static);		// Spatialized and never moves. Routes to GridNode.
@@ -359,6 +360,7 @@ void UShooterReplicationGraph::InitGlobalActorClassSettings()
 	// -------------------------------------------------------
 	
 	AShooterCharacter::NotifyWeaponChange.AddUObject(this, &UShooterReplicationGraph::OnCharacterWeaponChange);
+	AShooterPlayerState::NotifyScoreChange.AddUObject(this, &UShooterReplicationGraph::OnPlayerStateScoreChange);
 
 #if WITH_GAMEPLAY_DEBUGGER
 	AGameplayDebuggerCategoryReplicator::NotifyDebuggerOwnerChange.AddUObject(this, &UShooterReplicationGraph::OnGameplayDebuggerOwnerChange);
@@ -397,7 +399,7 @@ void UShooterReplicationGraph::InitGlobalGraphNodes()
 	// -----------------------------------------------
 	//	Player State specialization. This will return a rolling subset of the player states to replicate
 	// -----------------------------------------------
-	UShooterReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = CreateNewNode<UShooterReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode = CreateNewNode<UShooterReplicationGraphNode_PlayerStateFrequencyLimiter>();
 	AddGlobalGraphNode(PlayerStateNode);
 }
 
@@ -446,6 +448,12 @@ void UShooterReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedA
 			break;
 		}
 
+		case EClassRepNodeMapping::PlayerState:
+		{
+			PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+			break;
+		}
+
 		case EClassRepNodeMapping::Spatialize_Static:
 		{
 			GridNode->AddActor_Static(ActorInfo, GlobalInfo);
@@ -493,6 +501,12 @@ void UShooterReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicat
 			break;
 		}
 
+		case EClassRepNodeMapping::PlayerState:
+		{
+			PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+			break;
+		}
+
 		case EClassRepNodeMapping::Spatialize_Static:
 		{
 			GridNode->RemoveActor_Static(ActorInfo);
@@ -537,6 +551,13 @@ void UShooterReplicationGraph::OnCharacterWeaponChange(AShooterCharacter* Charac
 	}
 }
 
+void UShooterReplicationGraph::OnPlayerStateScoreChange(AShooterPlayerState* PlayerState)
+{
+	CHECK_WORLDS(PlayerState);
+
+	PlayerStateNode->NotifyPlayerStateChanged(PlayerState);
+}
+
 #if WITH_GAMEPLAY_DEBUGGER
 void UShooterReplicationGraph::OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner)
 {
@@ -749,47 +770,129 @@ UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::UShooterReplicationGra
 	bRequiresPrepareForReplicationCall = true;
 }
 
-void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
 {
-	QUICK_SCOPE_CYCLE_COUNTER( UShooterReplicationGraphNode_PlayerStateFrequencyLimiter_GlobalPrepareForReplication );
+	if (BucketIndices.Contains(ActorInfo.Actor))
+	{
+		return;
+	}
 
-	ReplicationActorLists.Reset();
-	ForceNetUpdateReplicationActorList.Reset();
+	// Fill the last bucket before opening a new one. Holes left by removed player states are closed in Defragment.
+	if (ReplicationActorLists.Num() == 0 || ReplicationActorLists.Last().Num() >= TargetActorsPerFrame)
+	{
+		ReplicationActorLists.AddDefaulted();
+		ReplicationActorLists.Last().PrepareForWrite();
+	}
 
-	ReplicationActorLists.AddDefaulted();
-	FActorRepListRefView* CurrentList = &ReplicationActorLists[0];
-	CurrentList->PrepareForWrite();
+	FActorRepListRefView& Bucket = ReplicationActorLists.Last();
+	Bucket.PrepareForWrite();
+	Bucket.Add(ActorInfo.Actor);
+	BucketIndices.Add(ActorInfo.Actor, ReplicationActorLists.Num() - 1);
+}
 
-	// We rebuild our lists of player states each frame. This is not as efficient as it could be but its the simplest way
-	// to handle players disconnecting and keeping the lists compact. If the lists were persistent we would need to defrag them as players left.
+bool UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	int32 BucketIdx = INDEX_NONE;
+	if (BucketIndices.RemoveAndCopyValue(ActorInfo.Actor, BucketIdx) == false)
+	{
+		UE_CLOG(bWarnIfNotFound, LogShooterReplicationGraph, Warning, TEXT("Player state %s was not found in PlayerStateFrequencyLimiter node"), *GetActorRepListTypeDebugString(ActorInfo.Actor));
+		return false;
+	}
+
+	FActorRepListRefView& Bucket = ReplicationActorLists[BucketIdx];
+	Bucket.PrepareForWrite();
+	Bucket.Remove(ActorInfo.Actor);
+
+	PendingPriorityActors.Remove(ActorInfo.Actor);
+	bNeedsDefragment = true;
+	return true;
+}
+
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyResetAllNetworkActors()
+{
+	ReplicationActorLists.Reset();
+	BucketIndices.Reset();
+	PriorityReplicationActorList.PrepareForWrite();
+	PriorityReplicationActorList.Reset();
+	PendingPriorityActors.Reset();
+	bNeedsDefragment = false;
+}
 
-	for (TActorIterator<APlayerState> It(GetWorld()); It; ++It)
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyPlayerStateChanged(AActor* PlayerState)
+{
+	if (BucketIndices.Contains(PlayerState))
+	{
+		PendingPriorityActors.AddUnique(PlayerState);
+	}
+}
+
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::Defragment()
+{
+	TArray<FActorRepListType> PlayerStates;
+	PlayerStates.Reserve(BucketIndices.Num());
+	for (const FActorRepListRefView& Bucket : ReplicationActorLists)
 	{
-		APlayerState* PS = *It;
-		if (IsActorValidForReplicationGather(PS) == false)
+		for (int32 i = 0; i < Bucket.Num(); ++i)
 		{
-			continue;
+			PlayerStates.Add(Bucket[i]);
 		}
+	}
 
-		if (CurrentList->Num() >= TargetActorsPerFrame)
+	const int32 NumBuckets = FMath::DivideAndRoundUp(PlayerStates.Num(), FMath::Max(TargetActorsPerFrame, 1));
+	ReplicationActorLists.SetNum(NumBuckets);
+
+	for (int32 BucketIdx = 0; BucketIdx < NumBuckets; ++BucketIdx)
+	{
+		FActorRepListRefView& Bucket = ReplicationActorLists[BucketIdx];
+		Bucket.PrepareForWrite();
+		Bucket.Reset();
+
+		const int32 First = BucketIdx * TargetActorsPerFrame;
+		const int32 Last = FMath::Min(First + TargetActorsPerFrame, PlayerStates.Num());
+		for (int32 i = First; i < Last; ++i)
 		{
-			ReplicationActorLists.AddDefaulted();
-			CurrentList = &ReplicationActorLists.Last(); 
-			CurrentList->PrepareForWrite();
+			Bucket.Add(PlayerStates[i]);
+			BucketIndices.Add(PlayerStates[i], BucketIdx);
 		}
-		
-		CurrentList->Add(PS);
-	}	
+	}
+
+	bNeedsDefragment = false;
+}
+
+void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+{
+	QUICK_SCOPE_CYCLE_COUNTER( UShooterReplicationGraphNode_PlayerStateFrequencyLimiter_GlobalPrepareForReplication );
+
+	// The buckets are maintained by NotifyAdd/RemoveNetworkActor, so most frames only the priority list is touched.
+	// They are only compacted after a player left or when TargetActorsPerFrame was changed.
+	const bool bBucketSizeChanged = ReplicationActorLists.Num() > 0 && ReplicationActorLists[0].Num() > TargetActorsPerFrame;
+	if (bNeedsDefragment || bBucketSizeChanged)
+	{
+		Defragment();
+	}
+
+	PriorityReplicationActorList.PrepareForWrite();
+	PriorityReplicationActorList.Reset();
+
+	const int32 NumPriority = FMath::Min(PendingPriorityActors.Num(), PriorityActorsPerFrame);
+	for (int32 i = 0; i < NumPriority; ++i)
+	{
+		PriorityReplicationActorList.Add(PendingPriorityActors[i]);
+	}
+	PendingPriorityActors.RemoveAt(0, NumPriority, false);
 }
 
 void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
 {
-	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
-	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
+	if (ReplicationActorLists.Num() > 0)
+	{
+		const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
+	}
 
-	if (ForceNetUpdateReplicationActorList.Num() > 0)
+	if (PriorityReplicationActorList.Num() > 0)
 	{
-		Params.OutGatheredReplicationLists.AddReplicationActorList(ForceNetUpdateReplicationActorList);
+		Params.OutGatheredReplicationLists.AddReplicationActorList(PriorityReplicationActorList);
 	}	
 }
 
@@ -804,6 +907,8 @@ void UShooterReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicat
 		LogActorRepList(DebugInfo, FString::Printf(TEXT("Bucket[%d]"), i++), List);
 	}
 
+	LogActorRepList(DebugInfo, TEXT("Priority"), PriorityReplicationActorList);
+
 	DebugInfo.PopIndent();
 }
 
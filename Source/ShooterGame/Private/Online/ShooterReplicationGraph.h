@@ -8,7 +8,9 @@
 
 //class AShooterCharacter;
 class AShooterWeapon;
+class AShooterPlayerState;
 class UReplicationGraphNode_GridSpatialization2D;
+class UShooterReplicationGraphNode_PlayerStateFrequencyLimiter;
 class AGameplayDebuggerCategoryReplicator;
 
 DECLARE_LOG_CATEGORY_EXTERN( LogShooterReplicationGraph, Display, All );
@@ -17,8 +19,9 @@ DECLARE_LOG_CATEGORY_EXTERN( LogShooterReplicationGraph, Display, All );
 UENUM()
 enum class EClassRepNodeMapping : uint32
 {
-	NotRouted,						// Doesn't map to any node. Used for special case actors that handled by special case nodes (UShooterReplicationGraphNode_PlayerStateFrequencyLimiter)
+	NotRouted,						// Doesn't map to any node. Used for special case actors that handled by special case nodes (UShooterReplicationGraphNode_AlwaysRelevant_ForConnection)
 	RelevantAllConnections,			// Routes to an AlwaysRelevantNode or AlwaysRelevantStreamingLevelNode node
+	PlayerState,					// Routes to PlayerStateNode (UShooterReplicationGraphNode_PlayerStateFrequencyLimiter)
 	
 	// ONLY SPATIALIZED Enums below here! See UShooterReplicationGraph::IsSpatialized
 
@@ -60,10 +63,15 @@ public:
 	UPROPERTY()
 	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
 
+	UPROPERTY()
+	UShooterReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode;
+
 	TMap<FName, FActorRepListRefView> AlwaysRelevantStreamingLevelActors;
 
 	void OnCharacterWeaponChange(AShooterCharacter* Character, AShooterWeapon* NewWeapon, AShooterWeapon* OldWeapon);
 
+	void OnPlayerStateScoreChange(AShooterPlayerState* PlayerState);
+
 #if WITH_GAMEPLAY_DEBUGGER
 	void OnGameplayDebuggerOwnerChange(AGameplayDebuggerCategoryReplicator* Debugger, APlayerController* OldOwner);
 #endif
@@ -115,16 +123,23 @@ private:
 	bool bInitializedPlayerState = false;
 };
 
-/** This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame. */
+/**
+ * This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame.
+ * The player states are kept in persistent buckets of TargetActorsPerFrame, maintained as they are routed in and out of the graph. Player states whose score changed are returned
+ * on the next frame in addition to the current bucket, so the scoreboard does not wait a full rotation.
+ */
 UCLASS()
 class UShooterReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicationGraphNode
 {
 	GENERATED_BODY()
 
+public:
+
 	UShooterReplicationGraphNode_PlayerStateFrequencyLimiter();
 
-	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
-	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override { return false; }
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override;
+	virtual void NotifyResetAllNetworkActors() override;
 
 	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
 
@@ -132,11 +147,30 @@ class UShooterReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplica
 
 	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
 
+	/** Queues the player state to be returned next frame, ahead of its bucket. */
+	void NotifyPlayerStateChanged(AActor* PlayerState);
+
 	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
 	int32 TargetActorsPerFrame = 2;
 
+	/** How many changed player states are returned per frame on top of TargetActorsPerFrame. The rest wait for the following frames. */
+	int32 PriorityActorsPerFrame = 2;
+
 private:
-	
+
+	/** Rebuilds the buckets without the holes left by removed player states. Only runs on frames after a removal or a TargetActorsPerFrame change. */
+	void Defragment();
+
 	TArray<FActorRepListRefView> ReplicationActorLists;
-	FActorRepListRefView ForceNetUpdateReplicationActorList;
+
+	/** Bucket index of every tracked player state */
+	TMap<FActorRepListType, int32> BucketIndices;
+
+	/** Changed player states returned this frame */
+	FActorRepListRefView PriorityReplicationActorList;
+
+	/** Changed player states waiting for a slot in PriorityReplicationActorList, oldest first */
+	TArray<FActorRepListType> PendingPriorityActors;
+
+	bool bNeedsDefragment = false;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterPickupRegistry.h"
 #include "Particles/ParticleSystemComponent.h"
 
 AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -33,14 +34,27 @@ void AShooterPickup::BeginPlay()
 
 	RespawnPickup();
 
-	// register on pickup list (server only), don't care about unregistering (in FinishDestroy) - no streaming
+	// register on pickup list (server only), EndPlay unregisters
 	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
 	if (GameMode)
 	{
 		GameMode->LevelPickups.Add(this);
+		GameMode->GetPickupRegistry().Add(this, bIsActive);
 	}
 }
 
+void AShooterPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode)
+	{
+		GameMode->LevelPickups.RemoveSingleSwap(this, false);
+		GameMode->GetPickupRegistry().Remove(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AShooterPickup::NotifyActorBeginOverlap(class AActor* Other)
 {
 	Super::NotifyActorBeginOverlap(Other);
@@ -112,6 +126,8 @@ void AShooterPickup::OnPickedUp()
 	}
 
 	OnPickedUpEvent();
+
+	UpdatePickupRegistry();
 }
 
 void AShooterPickup::OnRespawned()
@@ -133,6 +149,17 @@ void AShooterPickup::OnRespawned()
 	}
 
 	OnRespawnEvent();
+
+	UpdatePickupRegistry();
+}
+
+void AShooterPickup::UpdatePickupRegistry()
+{
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (GameMode)
+	{
+		GameMode->GetPickupRegistry().SetActive(this, bIsActive);
+	}
 }
 
 void AShooterPickup::OnRep_IsActive()
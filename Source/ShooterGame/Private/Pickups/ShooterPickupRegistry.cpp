@@ -0,0 +1,115 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Pickups/ShooterPickup.h"
+#include "Pickups/ShooterPickup_Ammo.h"
+
+void FShooterPickupRegistry::Add(AShooterPickup* Pickup, bool bIsActive)
+{
+	if (Pickup == nullptr || PickupLocations.Contains(Pickup))
+	{
+		return;
+	}
+
+	UClass* PickupClass = Pickup->GetClass();
+	const AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(Pickup);
+	UClass* WeaponClass = AmmoPickup ? AmmoPickup->GetWeaponType().Get() : nullptr;
+
+	int32 BucketIdx = Buckets.IndexOfByPredicate([&](const FBucket& Bucket) { return Bucket.PickupClass == PickupClass && Bucket.WeaponClass == WeaponClass; });
+	if (BucketIdx == INDEX_NONE)
+	{
+		BucketIdx = Buckets.AddDefaulted();
+		Buckets[BucketIdx].PickupClass = PickupClass;
+		Buckets[BucketIdx].WeaponClass = WeaponClass;
+	}
+
+	FBucket& Bucket = Buckets[BucketIdx];
+	Bucket.Entries.Add(FEntry{ Pickup->GetActorLocation(), Pickup, bIsActive });
+
+	// pickups only register at BeginPlay, rebuilding the whole tree is cheap enough
+	BuildTree(BucketIdx, 0, Bucket.Entries.Num(), 0);
+}
+
+void FShooterPickupRegistry::Remove(const AShooterPickup* Pickup)
+{
+	FIntPoint Location;
+	if (PickupLocations.RemoveAndCopyValue(Pickup, Location))
+	{
+		// empty buckets stay, PickupLocations refers to the others by index
+		TArray<FEntry>& Entries = Buckets[Location.X].Entries;
+		Entries.RemoveAtSwap(Location.Y, 1, false);
+		BuildTree(Location.X, 0, Entries.Num(), 0);
+	}
+}
+
+void FShooterPickupRegistry::SetActive(AShooterPickup* Pickup, bool bIsActive)
+{
+	if (const FIntPoint* Location = PickupLocations.Find(Pickup))
+	{
+		Buckets[Location->X].Entries[Location->Y].bIsActive = bIsActive;
+	}
+}
+
+void FShooterPickupRegistry::BuildTree(int32 BucketIdx, int32 Begin, int32 End, int32 Depth)
+{
+	if (Begin >= End)
+	{
+		return;
+	}
+
+	TArray<FEntry>& Entries = Buckets[BucketIdx].Entries;
+	const int32 Axis = Depth % 3;
+	Sort(&Entries[Begin], End - Begin, [Axis](const FEntry& A, const FEntry& B) { return A.Location[Axis] < B.Location[Axis]; });
+
+	const int32 Mid = (Begin + End) / 2;
+	PickupLocations.Add(Entries[Mid].Pickup, FIntPoint(BucketIdx, Mid));
+
+	BuildTree(BucketIdx, Begin, Mid, Depth + 1);
+	BuildTree(BucketIdx, Mid + 1, End, Depth + 1);
+}
+
+void FShooterPickupRegistry::FindNearestInTree(const FBucket& Bucket, int32 Begin, int32 End, int32 Depth, const FVector& Origin, TFunctionRef<bool(AShooterPickup*)> Predicate, AShooterPickup*& BestPickup, float& BestDistSq)
+{
+	if (Begin >= End)
+	{
+		return;
+	}
+
+	const int32 Mid = (Begin + End) / 2;
+	const FEntry& Entry = Bucket.Entries[Mid];
+
+	const float DistSq = (Entry.Location - Origin).SizeSquared();
+	if (Entry.bIsActive && DistSq < BestDistSq && Predicate(Entry.Pickup))
+	{
+		BestDistSq = DistSq;
+		BestPickup = Entry.Pickup;
+	}
+
+	// search the side of the split the origin is on first, the other side only if it can still hold something closer
+	const int32 Axis = Depth % 3;
+	const float SplitDist = Origin[Axis] - Entry.Location[Axis];
+	const bool bNearIsLow = SplitDist < 0.0f;
+
+	FindNearestInTree(Bucket, bNearIsLow ? Begin : Mid + 1, bNearIsLow ? Mid : End, Depth + 1, Origin, Predicate, BestPickup, BestDistSq);
+	if (FMath::Square(SplitDist) < BestDistSq)
+	{
+		FindNearestInTree(Bucket, bNearIsLow ? Mid + 1 : Begin, bNearIsLow ? End : Mid, Depth + 1, Origin, Predicate, BestPickup, BestDistSq);
+	}
+}
+
+AShooterPickup* FShooterPickupRegistry::FindNearest(const FVector& Origin, UClass* PickupClass, UClass* WeaponClass, TFunctionRef<bool(AShooterPickup*)> Predicate) const
+{
+	AShooterPickup* BestPickup = nullptr;
+	float BestDistSq = MAX_FLT;
+
+	for (const FBucket& Bucket : Buckets)
+	{
+		if (Bucket.PickupClass->IsChildOf(PickupClass) && (WeaponClass == nullptr || (Bucket.WeaponClass && Bucket.WeaponClass->IsChildOf(WeaponClass))))
+		{
+			FindNearestInTree(Bucket, 0, Bucket.Entries.Num(), 0, Origin, Predicate, BestPickup, BestDistSq);
+		}
+	}
+
+	return BestPickup;
+}
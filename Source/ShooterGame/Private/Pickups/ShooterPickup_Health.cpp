@@ -18,6 +18,7 @@ void AShooterPickup_Health::GivePickupTo(class AShooterCharacter* Pawn)
 	if (Pawn)
 	{
 		Pawn->Health = FMath::Min(FMath::TruncToInt(Pawn->Health) + Health, Pawn->GetMaxHealth());
+		Pawn->OnHealthChanged();
 
 		// Fire event for collected health
 		const auto Events = Online::GetEventsInterface();
@@ -8,8 +8,9 @@
 #include "Animation/AnimMontage.h"
 #include "Animation/AnimInstance.h"
 #include "Sound/SoundNodeLocalPlayer.h"
-#include "AudioThread.h"
 #include "Components/PawnNoiseEmitterComponent.h"
+#include "Player/ShooterPauseRelevancy.h"
+#include "Player/ShooterCharacterGrid.h"
 
 static int32 NetVisualizeRelevancyTestPoints = 0;
 FAutoConsoleVariableRef CVarNetVisualizeRelevancyTestPoints(
@@ -28,6 +29,14 @@ FAutoConsoleVariableRef CVarNetEnablePauseRelevancy(
 	TEXT("0: Disable, 1: Enable"),
 	ECVF_Cheat);
 
+DECLARE_CYCLE_STAT(TEXT("ShooterCharacter Tick"), STAT_ShooterCharacterTick, STATGROUP_Character);
+
+/** seconds between health regeneration steps */
+static const float HealthRegenInterval = 0.25f;
+
+/** health regenerated per second */
+static const float HealthRegenPerSecond = 5.0f;
+
 FOnShooterCharacterWeaponChange AShooterCharacter::NotifyWeaponChange;
 
 AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer)
@@ -64,6 +73,8 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 	bIsTargeting = false;
 	bWantsToFire = false;
 	LowHealthPercentage = 0.5f;
+	HitboxHistorySeconds = 1.0f;
+	HitboxHistorySamples = 32;
 
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
@@ -77,6 +88,16 @@ void AShooterCharacter::PostInitializeComponents()
 	{
 		Health = GetMaxHealth();
 		SpawnDefaultInventory();
+
+		if (GetNetMode() != NM_Standalone)
+		{
+			HitboxHistory.Init(GetMesh(), GetCapsuleComponent(), HitboxHistorySeconds, HitboxHistorySamples);
+		}
+
+		if (AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>())
+		{
+			GameMode->GetCharacterGrid().Add(this);
+		}
 	}
 
 	// set initial mesh visibility (3rd person view)
@@ -101,12 +122,29 @@ void AShooterCharacter::PostInitializeComponents()
 			UGameplayStatics::PlaySoundAtLocation(this, RespawnSound, GetActorLocation());
 		}
 	}
+	else
+	{
+		// never rendered here, so its pose is never updated anyway
+		Mesh1P->SetComponentTickEnabled(false);
+	}
 }
 
 void AShooterCharacter::Destroyed()
 {
 	Super::Destroyed();
 	DestroyInventory();
+	RemoveFromCharacterGrid();
+}
+
+void AShooterCharacter::RemoveFromCharacterGrid()
+{
+	if (Role == ROLE_Authority)
+	{
+		if (AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>())
+		{
+			GameMode->GetCharacterGrid().Remove(this);
+		}
+	}
 }
 
 void AShooterCharacter::PawnClientRestart()
@@ -122,6 +160,8 @@ void AShooterCharacter::PawnClientRestart()
 	// set team colors for 1st person view
 	UMaterialInstanceDynamic* Mesh1PMID = Mesh1P->CreateAndSetMaterialInstanceDynamic(0);
 	UpdateTeamColors(Mesh1PMID);
+
+	UpdateLocallyControlledSounds();
 }
 
 void AShooterCharacter::PossessedBy(class AController* InController)
@@ -130,6 +170,31 @@ void AShooterCharacter::PossessedBy(class AController* InController)
 
 	// [server] as soon as PlayerState is assigned, set team colors of this pawn for local player
 	UpdateTeamColorsAllMIDs();
+
+	UpdateLocallyControlledSounds();
+	UpdateHealthRegen();
+}
+
+void AShooterCharacter::UnPossessed()
+{
+	Super::UnPossessed();
+
+	UpdateLocallyControlledSounds();
+	UpdateHealthRegen();
+}
+
+void AShooterCharacter::OnRep_Controller()
+{
+	Super::OnRep_Controller();
+
+	UpdateLocallyControlledSounds();
+	UpdateHealthRegen();
+}
+
+void AShooterCharacter::UpdateLocallyControlledSounds()
+{
+	const APlayerController* PC = Cast<APlayerController>(GetController());
+	USoundNodeLocalPlayer::SetLocallyControlled(this, PC ? PC->IsLocalController() : false);
 }
 
 void AShooterCharacter::OnRep_PlayerState()
@@ -185,7 +250,9 @@ void AShooterCharacter::UpdatePawnMeshes()
 	Mesh1P->MeshComponentUpdateFlag = !bFirstPerson ? EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered : EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
 	Mesh1P->SetOwnerNoSee(!bFirstPerson);
 
-	GetMesh()->MeshComponentUpdateFlag = bFirstPerson ? EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered : EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones;
+	// the server records hitboxes from the bones of the 3rd person mesh, which nobody renders there
+	const bool bRefreshBones = !bFirstPerson || HitboxHistory.IsEnabled();
+	GetMesh()->MeshComponentUpdateFlag = bRefreshBones ? EMeshComponentUpdateFlag::AlwaysTickPoseAndRefreshBones : EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered;
 	GetMesh()->SetOwnerNoSee(bFirstPerson);
 }
 
@@ -291,6 +358,10 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 		{
 			Die(ActualDamage, DamageEvent, EventInstigator, DamageCauser);
 		}
+		else
+		{
+			OnHealthChanged();
+		}
 	}
 
 	return ActualDamage;
@@ -358,6 +429,9 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 	}
 	bIsDying = true;
 
+	// dead characters are no longer targets
+	RemoveFromCharacterGrid();
+
 	FTimerHandle TimerHandle_DeathDestroy;
 	GetWorldTimerManager().SetTimer(TimerHandle_DeathDestroy, this, &AShooterCharacter::OnDeathDestroy, 2.0f, false);
 
@@ -393,6 +467,7 @@ void AShooterCharacter::OnDeath(float KillingDamage, struct FDamageEvent const&
 	{
 		LowHealthWarningPlayer->Stop();
 	}
+	GetWorldTimerManager().ClearTimer(TimerHandle_HealthRegen);
 
 	if (GetMesh())
 	{
@@ -1000,61 +1075,89 @@ void AShooterCharacter::OnReload()
 
 void AShooterCharacter::Tick(float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterCharacterTick);
+
 	Super::Tick(DeltaSeconds);
 
-	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
-	if (MyPC && MyPC->HasHealthRegen())
+	if (Role == ROLE_Authority && IsAlive())
 	{
-		if (this->Health < this->GetMaxHealth())
+		HitboxHistory.Record(GetMesh(), GetCapsuleComponent(), GetWorld()->GetTimeSeconds());
+
+		if (AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>())
 		{
-			this->Health += 5 * DeltaSeconds;
-			if (Health > this->GetMaxHealth())
-			{
-				Health = this->GetMaxHealth();
-			}
+			GameMode->GetCharacterGrid().Update(this);
 		}
 	}
 
-	if (GEngine->UseSound())
+#if ENABLE_DRAW_DEBUG
+	if (NetVisualizeRelevancyTestPoints == 1)
 	{
-		if (LowHealthSound)
+		TArray<FVector, TInlineAllocator<8>> PointsToTest;
+		BuildPauseReplicationCheckPoints(PointsToTest);
+
+		for (FVector PointToTest : PointsToTest)
 		{
-			if ((this->Health > 0 && this->Health < this->GetMaxHealth() * LowHealthPercentage) && (!LowHealthWarningPlayer || !LowHealthWarningPlayer->IsPlaying()))
-			{
-				LowHealthWarningPlayer = UGameplayStatics::SpawnSoundAttached(LowHealthSound, GetRootComponent(),
-					NAME_None, FVector(ForceInit), EAttachLocation::KeepRelativeOffset, true);
-				LowHealthWarningPlayer->SetVolumeMultiplier(0.0f);
-			}
-			else if ((this->Health > this->GetMaxHealth() * LowHealthPercentage || this->Health < 0) && LowHealthWarningPlayer && LowHealthWarningPlayer->IsPlaying())
-			{
-				LowHealthWarningPlayer->Stop();
-			}
-			if (LowHealthWarningPlayer && LowHealthWarningPlayer->IsPlaying())
-			{
-				const float MinVolume = 0.3f;
-				const float VolumeMultiplier = (1.0f - (this->Health / (this->GetMaxHealth() * LowHealthPercentage)));
-				LowHealthWarningPlayer->SetVolumeMultiplier(MinVolume + (1.0f - MinVolume) * VolumeMultiplier);
-			}
+			DrawDebugSphere(GetWorld(), PointToTest, 10.0f, 8, FColor::Red);
 		}
 	}
+#endif
+}
 
-	const APlayerController* PC = Cast<APlayerController>(GetController());
-	const bool bLocallyControlled = (PC ? PC->IsLocalController() : false);
-	const uint32 UniqueID = GetUniqueID();
-	FAudioThread::RunCommandOnAudioThread([UniqueID, bLocallyControlled]()
+void AShooterCharacter::OnHealthChanged()
+{
+	UpdateHealthRegen();
+	UpdateLowHealthWarning();
+}
+
+void AShooterCharacter::OnRep_Health()
+{
+	OnHealthChanged();
+}
+
+void AShooterCharacter::UpdateHealthRegen()
+{
+	AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(Controller);
+	const bool bWantsRegen = MyPC && MyPC->HasHealthRegen() && IsAlive() && Health < GetMaxHealth();
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	if (bWantsRegen && !TimerManager.IsTimerActive(TimerHandle_HealthRegen))
 	{
-		USoundNodeLocalPlayer::GetLocallyControlledActorCache().Add(UniqueID, bLocallyControlled);
-	});
+		TimerManager.SetTimer(TimerHandle_HealthRegen, this, &AShooterCharacter::RegenHealth, HealthRegenInterval, true);
+	}
+	else if (!bWantsRegen)
+	{
+		TimerManager.ClearTimer(TimerHandle_HealthRegen);
+	}
+}
 
-	TArray<FVector> PointsToTest;
-	BuildPauseReplicationCheckPoints(PointsToTest);
+void AShooterCharacter::RegenHealth()
+{
+	Health = FMath::Min(Health + HealthRegenPerSecond * HealthRegenInterval, (float)GetMaxHealth());
+	OnHealthChanged();
+}
 
-	if (NetVisualizeRelevancyTestPoints == 1)
+void AShooterCharacter::UpdateLowHealthWarning()
+{
+	if (GetNetMode() == NM_DedicatedServer || !GEngine->UseSound() || !LowHealthSound)
 	{
-		for (FVector PointToTest : PointsToTest)
-		{
-			DrawDebugSphere(GetWorld(), PointToTest, 10.0f, 8, FColor::Red);
-		}
+		return;
+	}
+
+	if ((this->Health > 0 && this->Health < this->GetMaxHealth() * LowHealthPercentage) && (!LowHealthWarningPlayer || !LowHealthWarningPlayer->IsPlaying()))
+	{
+		LowHealthWarningPlayer = UGameplayStatics::SpawnSoundAttached(LowHealthSound, GetRootComponent(),
+			NAME_None, FVector(ForceInit), EAttachLocation::KeepRelativeOffset, true);
+		LowHealthWarningPlayer->SetVolumeMultiplier(0.0f);
+	}
+	else if ((this->Health > this->GetMaxHealth() * LowHealthPercentage || this->Health < 0) && LowHealthWarningPlayer && LowHealthWarningPlayer->IsPlaying())
+	{
+		LowHealthWarningPlayer->Stop();
+	}
+	if (LowHealthWarningPlayer && LowHealthWarningPlayer->IsPlaying())
+	{
+		const float MinVolume = 0.3f;
+		const float VolumeMultiplier = (1.0f - (this->Health / (this->GetMaxHealth() * LowHealthPercentage)));
+		LowHealthWarningPlayer->SetVolumeMultiplier(MinVolume + (1.0f - MinVolume) * VolumeMultiplier);
 	}
 }
 
@@ -1064,11 +1167,7 @@ void AShooterCharacter::BeginDestroy()
 
 	if (!GExitPurge)
 	{
-		const uint32 UniqueID = GetUniqueID();
-		FAudioThread::RunCommandOnAudioThread([UniqueID]()
-		{
-			USoundNodeLocalPlayer::GetLocallyControlledActorCache().Remove(UniqueID);
-		});
+		USoundNodeLocalPlayer::ClearLocallyControlled(this);
 	}
 }
 
@@ -1122,25 +1221,9 @@ bool AShooterCharacter::IsReplicationPausedForConnection(const FNetViewer& Conne
 		APlayerController* PC = Cast<APlayerController>(ConnectionOwnerNetViewer.InViewer);
 		check(PC);
 
-		FVector ViewLocation;
-		FRotator ViewRotation;
-		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
-
-		FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(LineOfSight), true, PC->GetPawn());
-		CollisionParams.AddIgnoredActor(this);
-
-		TArray<FVector> PointsToTest;
-		BuildPauseReplicationCheckPoints(PointsToTest);
-
-		for (FVector PointToTest : PointsToTest)
-		{
-			if (!GetWorld()->LineTraceTestByChannel(PointToTest, ViewLocation, ECC_Visibility, CollisionParams))
-			{
-				return false;
-			}
-		}
-
-		return true;
+		// Visibility is traced asynchronously and cached per viewer by the game mode, see FShooterPauseRelevancy
+		AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		return GameMode && GameMode->GetPauseRelevancy().IsPaused(this, PC);
 	}
 
 	return false;
@@ -1224,7 +1307,7 @@ void AShooterCharacter::UpdateTeamColorsAllMIDs()
 	}
 }
 
-void AShooterCharacter::BuildPauseReplicationCheckPoints(TArray<FVector>& RelevancyCheckPoints)
+void AShooterCharacter::BuildPauseReplicationCheckPoints(TArray<FVector, TInlineAllocator<8>>& RelevancyCheckPoints)
 {
 	FBoxSphereBounds Bounds = GetCapsuleComponent()->CalcBounds(GetCapsuleComponent()->GetComponentTransform());
 	FBox BoundingBox = Bounds.GetBox();
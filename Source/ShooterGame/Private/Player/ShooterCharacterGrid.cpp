@@ -0,0 +1,80 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterCharacterGrid.h"
+
+FShooterCharacterGrid::FShooterCharacterGrid(float InCellSize)
+	: CellSize(InCellSize)
+	, MinCell(MAX_int32, MAX_int32)
+	, MaxCell(MIN_int32, MIN_int32)
+{
+}
+
+FIntPoint FShooterCharacterGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void FShooterCharacterGrid::Add(AShooterCharacter* Character)
+{
+	if (Character == nullptr || CharacterCells.Contains(Character))
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCell(Character->GetActorLocation());
+	Cells.FindOrAdd(Cell).Add(Character);
+	CharacterCells.Add(Character, Cell);
+
+	MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+	MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+}
+
+void FShooterCharacterGrid::Remove(AShooterCharacter* Character)
+{
+	FIntPoint Cell;
+	if (CharacterCells.RemoveAndCopyValue(Character, Cell))
+	{
+		TArray<AShooterCharacter*>& CellCharacters = Cells.FindChecked(Cell);
+		CellCharacters.RemoveSingleSwap(Character, false);
+		if (CellCharacters.Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void FShooterCharacterGrid::Update(AShooterCharacter* Character)
+{
+	FIntPoint* CurrentCell = CharacterCells.Find(Character);
+	if (CurrentCell == nullptr)
+	{
+		return;
+	}
+
+	const FIntPoint NewCell = GetCell(Character->GetActorLocation());
+	if (NewCell != *CurrentCell)
+	{
+		Remove(Character);
+		Add(Character);
+	}
+}
+
+int32 FShooterCharacterGrid::GatherCell(const FIntPoint& Cell, const FVector& Origin, float MaxDistSq, TArray<FCandidate, TInlineAllocator<32>>& Heap) const
+{
+	const TArray<AShooterCharacter*>* CellCharacters = Cells.Find(Cell);
+	if (CellCharacters == nullptr)
+	{
+		return 0;
+	}
+
+	for (AShooterCharacter* Character : *CellCharacters)
+	{
+		const float DistSq = (Character->GetActorLocation() - Origin).SizeSquared();
+		if (DistSq <= MaxDistSq)
+		{
+			Heap.HeapPush(FCandidate{ Character, DistSq });
+		}
+	}
+	return CellCharacters->Num();
+}
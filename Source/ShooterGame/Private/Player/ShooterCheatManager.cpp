@@ -4,9 +4,26 @@
 #include "Player/ShooterCheatManager.h"
 #include "Online/ShooterPlayerState.h"
 #include "Bots/ShooterAIController.h"
+#include "Player/ShooterHitboxHistory.h"
+#include "Pickups/ShooterPickup_Ammo.h"
+#include "Pickups/ShooterPickupRegistry.h"
+#include "Weapons/ShooterWeapon_Instant.h"
+#include "Weapons/ShooterProjectile.h"
+#include "Weapons/ShooterExplosionBatcher.h"
+#include "UI/ShooterHUD.h"
+#include "ShooterGameInstance.h"
+
+/** Seconds spent running Body, for the Benchmark* cheats */
+static double TimeBenchmark(TFunctionRef<void()> Body)
+{
+	const double Start = FPlatformTime::Seconds();
+	Body();
+	return FPlatformTime::Seconds() - Start;
+}
 
 UShooterCheatManager::UShooterCheatManager(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	KillFeedMessageIndex = 0;
 }
 
 void UShooterCheatManager::ToggleInfiniteAmmo()
@@ -77,4 +94,255 @@ void UShooterCheatManager::SpawnBot()
 		AShooterAIController* ShooterAIController = MyGame->CreateBot(CheatBotNum++);
 		MyGame->RestartPlayer(ShooterAIController);		
 	}
-}
\ No newline at end of file
+}
+
+void UShooterCheatManager::BenchmarkHitboxHistory(int32 NumCharacters, float Seconds, int32 Samples)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AShooterCharacter* const MyPawn = Cast<AShooterCharacter>(MyPC->GetPawn());
+	if (NumCharacters <= 0 || Seconds <= 0.0f)
+	{
+		MyPC->ClientMessage(TEXT("BenchmarkHitboxHistory needs NumCharacters and Seconds above 0"));
+		return;
+	}
+	if (MyPawn == nullptr)
+	{
+		MyPC->ClientMessage(TEXT("BenchmarkHitboxHistory needs a ShooterCharacter pawn"));
+		return;
+	}
+
+	const float TickInterval = 1.0f / 60.0f;
+	const int32 NumTicks = FMath::CeilToInt(Seconds / TickInterval);
+
+	TArray<FShooterHitboxHistory> Histories;
+	Histories.SetNum(NumCharacters);
+	for (FShooterHitboxHistory& History : Histories)
+	{
+		History.Init(MyPawn->GetMesh(), MyPawn->GetCapsuleComponent(), Seconds, Samples);
+	}
+
+	const double RecordTime = TimeBenchmark([&]()
+	{
+		for (int32 TickIdx = 0; TickIdx < NumTicks; ++TickIdx)
+		{
+			for (FShooterHitboxHistory& History : Histories)
+			{
+				History.Record(MyPawn->GetMesh(), MyPawn->GetCapsuleComponent(), TickIdx * TickInterval);
+			}
+		}
+	});
+
+	// one rewound hit check per character and tick, at random times within the history
+	FRandomStream RandomStream(NumCharacters);
+	const FVector HitPoint = MyPawn->GetActorLocation();
+	int32 NumHits = 0;
+	const double RewindTime = TimeBenchmark([&]()
+	{
+		for (int32 TickIdx = 0; TickIdx < NumTicks; ++TickIdx)
+		{
+			for (const FShooterHitboxHistory& History : Histories)
+			{
+				NumHits += History.IsPointNearPose(RandomStream.FRandRange(0.0f, Seconds), HitPoint, 15.0f) ? 1 : 0;
+			}
+		}
+	});
+
+	SIZE_T AllocatedSize = 0;
+	for (const FShooterHitboxHistory& History : Histories)
+	{
+		AllocatedSize += History.GetAllocatedSize();
+	}
+
+	const int32 NumOps = NumTicks * NumCharacters;
+	const FString Result = FString::Printf(TEXT("Hitbox history: %d characters x %.2fs, %d samples: %.1f KB, record %.3f ms/tick (%.2f us per character), rewind %.2f us per check (%d hits)"),
+		NumCharacters, Seconds, Samples, AllocatedSize / 1024.0, RecordTime * 1000.0 / NumTicks, RecordTime * 1000000.0 / NumOps, RewindTime * 1000000.0 / NumOps, NumHits);
+	ReportBenchmark(Result);
+}
+
+void UShooterCheatManager::BenchmarkPickupQueries(int32 NumBots, int32 Iterations)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AShooterCharacter* const MyPawn = Cast<AShooterCharacter>(MyPC->GetPawn());
+	AShooterGameMode* const MyGame = MyPC->GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyPawn == nullptr || MyGame == nullptr || MyGame->LevelPickups.Num() == 0 || NumBots <= 0 || Iterations <= 0)
+	{
+		MyPC->ClientMessage(TEXT("BenchmarkPickupQueries needs a server with level pickups and a ShooterCharacter pawn"));
+		return;
+	}
+
+	FBox PickupBounds(ForceInit);
+	for (const AShooterPickup* Pickup : MyGame->LevelPickups)
+	{
+		PickupBounds += Pickup->GetActorLocation();
+	}
+	PickupBounds = PickupBounds.ExpandBy(1000.0f);
+
+	FRandomStream RandomStream(NumBots);
+	TArray<FVector> BotLocations;
+	for (int32 i = 0; i < NumBots; ++i)
+	{
+		BotLocations.Add(RandomStream.RandPointInBox(PickupBounds));
+	}
+
+	const FShooterPickupRegistry& Registry = MyGame->GetPickupRegistry();
+	int32 NumFound = 0;
+	const double RegistryTime = TimeBenchmark([&]()
+	{
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FVector& BotLocation : BotLocations)
+			{
+				const AShooterPickup* Pickup = Registry.FindNearest(BotLocation, AShooterPickup_Ammo::StaticClass(), AShooterWeapon_Instant::StaticClass(),
+					[MyPawn](AShooterPickup* Candidate) { return Candidate->CanBePickedUp(MyPawn); });
+				NumFound += Pickup ? 1 : 0;
+			}
+		}
+	});
+
+	// the scan UBTTask_FindPickup used to do
+	int32 NumFoundLinear = 0;
+	const double LinearTime = TimeBenchmark([&]()
+	{
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const FVector& BotLocation : BotLocations)
+			{
+				const AShooterPickup_Ammo* BestPickup = nullptr;
+				float BestDistSq = MAX_FLT;
+				for (AShooterPickup* Pickup : MyGame->LevelPickups)
+				{
+					AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(Pickup);
+					if (AmmoPickup && AmmoPickup->IsForWeapon(AShooterWeapon_Instant::StaticClass()) && AmmoPickup->CanBePickedUp(MyPawn))
+					{
+						const float DistSq = (AmmoPickup->GetActorLocation() - BotLocation).SizeSquared();
+						if (DistSq < BestDistSq)
+						{
+							BestDistSq = DistSq;
+							BestPickup = AmmoPickup;
+						}
+					}
+				}
+				NumFoundLinear += BestPickup ? 1 : 0;
+			}
+		}
+	});
+
+	const int32 NumQueries = NumBots * Iterations;
+	const FString Result = FString::Printf(TEXT("Pickup queries: %d bots, %d pickups: registry %.3f us/query (%d found), linear scan %.3f us/query (%d found), %.3f ms per round of bot queries"),
+		NumBots, MyGame->LevelPickups.Num(), RegistryTime * 1000000.0 / NumQueries, NumFound, LinearTime * 1000000.0 / NumQueries, NumFoundLinear, RegistryTime * 1000.0 / Iterations);
+	ReportBenchmark(Result);
+}
+
+void UShooterCheatManager::BenchmarkExplosions(int32 NumExplosions, float Radius, float Spread)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AShooterCharacter* const MyPawn = Cast<AShooterCharacter>(MyPC->GetPawn());
+	AShooterGameMode* const MyGame = MyPC->GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	if (MyPawn == nullptr || MyGame == nullptr || NumExplosions <= 0)
+	{
+		MyPC->ClientMessage(TEXT("BenchmarkExplosions needs a server and a ShooterCharacter pawn"));
+		return;
+	}
+
+	// zero damage explosions around the local pawn, which causes them so it is left alone
+	FRandomStream RandomStream(NumExplosions);
+	TArray<FVector> Origins;
+	for (int32 i = 0; i < NumExplosions; ++i)
+	{
+		Origins.Add(MyPawn->GetActorLocation() + RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, Spread));
+	}
+
+	const TArray<AActor*> NoIgnoreActors;
+	const double ImmediateTime = TimeBenchmark([&]()
+	{
+		for (const FVector& Origin : Origins)
+		{
+			AShooterProjectile::ApplyRadialDamage(MyPawn, 0.0f, Origin, Radius, UDamageType::StaticClass(), NoIgnoreActors, MyPawn, MyPC, true, COLLISION_WEAPON);
+		}
+	});
+
+	FShooterExplosionBatcher& Batcher = MyGame->GetExplosionBatcher();
+	Batcher.Flush();
+	for (const FVector& Origin : Origins)
+	{
+		FShooterExplosion Explosion;
+		Explosion.Origin = Origin;
+		Explosion.BaseDamage = 0.0f;
+		Explosion.MinimumDamage = 0.0f;
+		Explosion.InnerRadius = 0.0f;
+		Explosion.OuterRadius = Radius;
+		Explosion.DamageFalloff = 0.0f;
+		Explosion.DamageTypeClass = UDamageType::StaticClass();
+		Explosion.DamagePreventionChannel = COLLISION_WEAPON;
+		Explosion.DamageCauser = MyPawn;
+		Explosion.InstigatedBy = MyPC;
+		Batcher.Queue(Explosion);
+	}
+	int32 NumQueries = 0;
+	const double BatchedTime = TimeBenchmark([&]() { NumQueries = Batcher.Flush(); });
+
+	const FString Result = FString::Printf(TEXT("Explosions: %d x %.0f radius within %.0f: immediate %.3f ms (%d overlap queries), batched %.3f ms (%d overlap queries)"),
+		NumExplosions, Radius, Spread, ImmediateTime * 1000.0, NumExplosions, BatchedTime * 1000.0, NumQueries);
+	ReportBenchmark(Result);
+}
+
+void UShooterCheatManager::SaturateKillFeed(float Seconds)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AGameStateBase* const MyGameState = MyPC->GetWorld()->GetGameState();
+	if (MyPC->GetShooterHUD() == nullptr || MyGameState == nullptr || MyGameState->PlayerArray.Num() == 0)
+	{
+		MyPC->ClientMessage(TEXT("SaturateKillFeed needs a local HUD and players in the match"));
+		return;
+	}
+
+	const float EndTime = MyPC->GetWorld()->GetTimeSeconds() + Seconds;
+	MyPC->GetWorldTimerManager().SetTimer(TimerHandle_SaturateKillFeed, FTimerDelegate::CreateUObject(this, &UShooterCheatManager::AddKillFeedMessage, EndTime), 1.0f / 60.0f, true);
+}
+
+void UShooterCheatManager::DumpRTPackets()
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	UShooterGameInstance* const MyGameInstance = Cast<UShooterGameInstance>(MyPC->GetGameInstance());
+	if (MyGameInstance)
+	{
+		MyGameInstance->GetRTPacketRouter().DumpCounters(*GLog);
+		MyPC->ClientMessage(TEXT("RT packet counters written to the log"));
+	}
+}
+
+void UShooterCheatManager::ResetRTPackets()
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	UShooterGameInstance* const MyGameInstance = Cast<UShooterGameInstance>(MyPC->GetGameInstance());
+	if (MyGameInstance)
+	{
+		MyGameInstance->GetRTPacketRouter().ResetCounters();
+	}
+}
+
+void UShooterCheatManager::ReportBenchmark(const FString& Result)
+{
+	UE_LOG(LogShooter, Log, TEXT("%s"), *Result);
+	GetOuterAShooterPlayerController()->ClientMessage(Result);
+}
+
+void UShooterCheatManager::AddKillFeedMessage(float EndTime)
+{
+	AShooterPlayerController* const MyPC = GetOuterAShooterPlayerController();
+	AShooterHUD* const MyHUD = MyPC->GetShooterHUD();
+	AGameStateBase* const MyGameState = MyPC->GetWorld()->GetGameState();
+	if (MyHUD == nullptr || MyGameState == nullptr || MyGameState->PlayerArray.Num() == 0 || MyPC->GetWorld()->GetTimeSeconds() > EndTime)
+	{
+		MyPC->GetWorldTimerManager().ClearTimer(TimerHandle_SaturateKillFeed);
+		return;
+	}
+
+	// walk through all killer and victim pairs, the local player is one of them now and then
+	const TArray<APlayerState*>& Players = MyGameState->PlayerArray;
+	AShooterPlayerState* const Killer = Cast<AShooterPlayerState>(Players[KillFeedMessageIndex % Players.Num()]);
+	AShooterPlayerState* const Victim = Cast<AShooterPlayerState>(Players[(KillFeedMessageIndex / Players.Num() + 1) % Players.Num()]);
+	KillFeedMessageIndex++;
+
+	MyHUD->ShowDeathMessage(Killer, Victim, GetDefault<UDamageType>());
+}
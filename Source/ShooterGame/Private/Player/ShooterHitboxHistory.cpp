@@ -0,0 +1,148 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterHitboxHistory.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/BodySetup.h"
+
+FShooterHitboxHistory::FShooterHitboxHistory()
+	: NumBodies(0)
+	, MaxSamples(0)
+	, NumSamples(0)
+	, Head(0)
+	, MinSampleInterval(0.0f)
+{
+}
+
+void FShooterHitboxHistory::Init(const USkeletalMeshComponent* Mesh, const UCapsuleComponent* Capsule, float HistorySeconds, int32 InMaxSamples)
+{
+	BoneIndices.Reset();
+	BodyTransforms.Reset();
+	Radii.Reset();
+	HalfLengths.Reset();
+
+	const UPhysicsAsset* PhysicsAsset = Mesh ? Mesh->GetPhysicsAsset() : nullptr;
+	if (PhysicsAsset)
+	{
+		for (const USkeletalBodySetup* Body : PhysicsAsset->SkeletalBodySetups)
+		{
+			const int32 BoneIndex = Body ? Mesh->GetBoneIndex(Body->BoneName) : INDEX_NONE;
+			if (BoneIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			for (const FKSphylElem& Sphyl : Body->AggGeom.SphylElems)
+			{
+				BoneIndices.Add(BoneIndex);
+				BodyTransforms.Add(Sphyl.GetTransform());
+				Radii.Add(Sphyl.Radius);
+				HalfLengths.Add(Sphyl.Length * 0.5f);
+			}
+		}
+	}
+
+	// no usable physics asset, fall back to the collision capsule
+	if (BoneIndices.Num() == 0 && Capsule)
+	{
+		BoneIndices.Add(INDEX_NONE);
+		BodyTransforms.Add(FTransform::Identity);
+		Radii.Add(Capsule->GetScaledCapsuleRadius());
+		HalfLengths.Add(Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere());
+	}
+
+	NumBodies = BoneIndices.Num();
+	MaxSamples = FMath::Max(InMaxSamples, 2);
+	MinSampleInterval = HistorySeconds / MaxSamples;
+
+	SampleTimes.SetNumUninitialized(MaxSamples);
+	Centers.SetNumUninitialized(MaxSamples * NumBodies);
+	HalfAxes.SetNumUninitialized(MaxSamples * NumBodies);
+
+	NumSamples = 0;
+	Head = 0;
+}
+
+void FShooterHitboxHistory::Record(const USkeletalMeshComponent* Mesh, const UCapsuleComponent* Capsule, float Time)
+{
+	if (NumBodies == 0 || (NumSamples > 0 && Time - SampleTimes[Head] < MinSampleInterval))
+	{
+		return;
+	}
+
+	Head = (Head + 1) % MaxSamples;
+	NumSamples = FMath::Min(NumSamples + 1, MaxSamples);
+	SampleTimes[Head] = Time;
+
+	FVector* SampleCenters = &Centers[Head * NumBodies];
+	FVector* SampleHalfAxes = &HalfAxes[Head * NumBodies];
+	for (int32 BodyIdx = 0; BodyIdx < NumBodies; ++BodyIdx)
+	{
+		const int32 BoneIndex = BoneIndices[BodyIdx];
+		const FTransform BoneTransform = (BoneIndex != INDEX_NONE && Mesh) ? Mesh->GetBoneTransform(BoneIndex) : Capsule->GetComponentTransform();
+		const FTransform BodyTransform = BodyTransforms[BodyIdx] * BoneTransform;
+
+		// sphyls are aligned with their local Z axis
+		SampleCenters[BodyIdx] = BodyTransform.GetLocation();
+		SampleHalfAxes[BodyIdx] = BodyTransform.GetUnitAxis(EAxis::Z) * HalfLengths[BodyIdx];
+	}
+}
+
+float FShooterHitboxHistory::GetOldestTime() const
+{
+	return NumSamples > 0 ? SampleTimes[GetSampleIndex(NumSamples - 1)] : 0.0f;
+}
+
+bool FShooterHitboxHistory::IsPointNearPose(float Time, const FVector& Point, float Tolerance) const
+{
+	if (NumSamples == 0)
+	{
+		return false;
+	}
+
+	// find the samples around Time, clamping to the ends of the history
+	int32 NewerIdx = Head;
+	int32 OlderIdx = Head;
+	for (int32 Age = 1; Age < NumSamples && SampleTimes[NewerIdx] > Time; ++Age)
+	{
+		OlderIdx = GetSampleIndex(Age);
+		if (SampleTimes[OlderIdx] <= Time)
+		{
+			break;
+		}
+		NewerIdx = OlderIdx;
+	}
+
+	const float Span = SampleTimes[NewerIdx] - SampleTimes[OlderIdx];
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? FMath::Clamp((Time - SampleTimes[OlderIdx]) / Span, 0.0f, 1.0f) : 1.0f;
+
+	const FVector* OlderCenters = &Centers[OlderIdx * NumBodies];
+	const FVector* NewerCenters = &Centers[NewerIdx * NumBodies];
+	const FVector* OlderHalfAxes = &HalfAxes[OlderIdx * NumBodies];
+	const FVector* NewerHalfAxes = &HalfAxes[NewerIdx * NumBodies];
+	for (int32 BodyIdx = 0; BodyIdx < NumBodies; ++BodyIdx)
+	{
+		const FVector Center = FMath::Lerp(OlderCenters[BodyIdx], NewerCenters[BodyIdx], Alpha);
+		const FVector HalfAxis = FMath::Lerp(OlderHalfAxes[BodyIdx], NewerHalfAxes[BodyIdx], Alpha);
+		const float MaxDist = Radii[BodyIdx] + Tolerance;
+
+		if (FMath::PointDistToSegmentSquared(Point, Center - HalfAxis, Center + HalfAxis) <= FMath::Square(MaxDist))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+SIZE_T FShooterHitboxHistory::GetAllocatedSize() const
+{
+	return BoneIndices.GetAllocatedSize() + BodyTransforms.GetAllocatedSize() + Radii.GetAllocatedSize() + HalfLengths.GetAllocatedSize()
+		+ SampleTimes.GetAllocatedSize() + Centers.GetAllocatedSize() + HalfAxes.GetAllocatedSize();
+}
+
+void FShooterHitboxHistory::Reset()
+{
+	NumSamples = 0;
+	Head = 0;
+}
@@ -0,0 +1,209 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterPauseRelevancy.h"
+
+DECLARE_STATS_GROUP(TEXT("ShooterPauseRelevancy"), STATGROUP_ShooterPauseRelevancy, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("IsPaused"), STAT_PauseRelevancy_IsPaused, STATGROUP_ShooterPauseRelevancy);
+DECLARE_CYCLE_STAT(TEXT("UpdateFrame"), STAT_PauseRelevancy_UpdateFrame, STATGROUP_ShooterPauseRelevancy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Traces issued"), STAT_PauseRelevancy_Traces, STATGROUP_ShooterPauseRelevancy);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grid early outs"), STAT_PauseRelevancy_NearbyEarlyOut, STATGROUP_ShooterPauseRelevancy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pairs"), STAT_PauseRelevancy_Pairs, STATGROUP_ShooterPauseRelevancy);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Refresh queue"), STAT_PauseRelevancy_Queue, STATGROUP_ShooterPauseRelevancy);
+
+static int32 NetPauseRelevancyTraceBudget = 256;
+FAutoConsoleVariableRef CVarNetPauseRelevancyTraceBudget(
+	TEXT("p.NetPauseRelevancyTraceBudget"),
+	NetPauseRelevancyTraceBudget,
+	TEXT("Maximum number of async visibility traces issued per frame for pause relevancy."),
+	ECVF_Default);
+
+static float NetPauseRelevancyRefreshInterval = 0.2f;
+FAutoConsoleVariableRef CVarNetPauseRelevancyRefreshInterval(
+	TEXT("p.NetPauseRelevancyRefreshInterval"),
+	NetPauseRelevancyRefreshInterval,
+	TEXT("Seconds a pawn/viewer visibility result is reused before it is traced again."),
+	ECVF_Default);
+
+static float NetPauseRelevancyPauseDelay = 0.5f;
+FAutoConsoleVariableRef CVarNetPauseRelevancyPauseDelay(
+	TEXT("p.NetPauseRelevancyPauseDelay"),
+	NetPauseRelevancyPauseDelay,
+	TEXT("Seconds a pawn has to stay occluded before its replication is paused for a viewer."),
+	ECVF_Default);
+
+static float NetPauseRelevancyCellSize = 2000.0f;
+FAutoConsoleVariableRef CVarNetPauseRelevancyCellSize(
+	TEXT("p.NetPauseRelevancyCellSize"),
+	NetPauseRelevancyCellSize,
+	TEXT("Size of the grid cells. A viewer in the same or a neighbouring cell never pauses a pawn. 0 disables the early out."),
+	ECVF_Default);
+
+FShooterPauseRelevancy::FShooterPauseRelevancy(UWorld* InWorld)
+	: World(InWorld)
+	, LastUpdateFrame(0)
+	, LastPruneTime(0.0f)
+{
+}
+
+uint64 FShooterPauseRelevancy::MakeKey(const AShooterCharacter* Pawn, const APlayerController* Viewer)
+{
+	return (uint64(Pawn->GetUniqueID()) << 32) | uint64(Viewer->GetUniqueID());
+}
+
+bool FShooterPauseRelevancy::IsPaused(AShooterCharacter* Pawn, APlayerController* Viewer)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PauseRelevancy_IsPaused);
+
+	if (Viewer->GetPawn() == Pawn)
+	{
+		return false;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Viewer->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Grid level early out: nearby pawns are always relevant, whatever a trace would say
+	if (NetPauseRelevancyCellSize > 0.0f)
+	{
+		const FIntVector PawnCell(Pawn->GetActorLocation() / NetPauseRelevancyCellSize);
+		const FIntVector ViewerCell(ViewLocation / NetPauseRelevancyCellSize);
+		const FIntVector Delta = PawnCell - ViewerCell;
+		if (FMath::Abs(Delta.X) <= 1 && FMath::Abs(Delta.Y) <= 1 && FMath::Abs(Delta.Z) <= 1)
+		{
+			INC_DWORD_STAT(STAT_PauseRelevancy_NearbyEarlyOut);
+			return false;
+		}
+	}
+
+	UpdateFrame();
+
+	const float Now = Pawn->GetWorld()->GetTimeSeconds();
+	const uint64 Key = MakeKey(Pawn, Viewer);
+
+	FVisibilityPair* Pair = Pairs.Find(Key);
+	if (Pair == nullptr)
+	{
+		Pair = &Pairs.Add(Key);
+		Pair->Pawn = Pawn;
+		Pair->Viewer = Viewer;
+		Pair->LastVisibleTime = Now;
+		Pair->LastRefreshTime = -MAX_FLT;
+		Pair->PendingTraces = 0;
+		Pair->bQueued = false;
+	}
+
+	Pair->LastQueryTime = Now;
+
+	if (!Pair->bQueued && Pair->PendingTraces == 0 && Now - Pair->LastRefreshTime >= NetPauseRelevancyRefreshInterval)
+	{
+		Pair->bQueued = true;
+		RefreshQueue.Add(Key);
+	}
+
+	return Now - Pair->LastVisibleTime > NetPauseRelevancyPauseDelay;
+}
+
+void FShooterPauseRelevancy::UpdateFrame()
+{
+	if (LastUpdateFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastUpdateFrame = GFrameCounter;
+
+	SCOPE_CYCLE_COUNTER(STAT_PauseRelevancy_UpdateFrame);
+
+	UWorld* MyWorld = World.Get();
+	if (MyWorld == nullptr)
+	{
+		return;
+	}
+
+	const float Now = MyWorld->GetTimeSeconds();
+
+	// Drop pairs whose pawn or viewer is gone, or that replication stopped asking about (e.g. the pawn became irrelevant)
+	if (Now - LastPruneTime > 1.0f)
+	{
+		LastPruneTime = Now;
+		for (auto It = Pairs.CreateIterator(); It; ++It)
+		{
+			const FVisibilityPair& Pair = It.Value();
+			if (Pair.PendingTraces == 0 && (!Pair.Pawn.IsValid() || !Pair.Viewer.IsValid() || Now - Pair.LastQueryTime > 2.0f))
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	int32 TracesIssued = 0;
+	int32 NumDequeued = 0;
+	while (NumDequeued < RefreshQueue.Num() && TracesIssued < NetPauseRelevancyTraceBudget)
+	{
+		const uint64 Key = RefreshQueue[NumDequeued++];
+		if (FVisibilityPair* Pair = Pairs.Find(Key))
+		{
+			Pair->bQueued = false;
+			TracesIssued += IssueTraces(*Pair, Key);
+		}
+	}
+	RefreshQueue.RemoveAt(0, NumDequeued, false);
+
+	INC_DWORD_STAT_BY(STAT_PauseRelevancy_Traces, TracesIssued);
+	SET_DWORD_STAT(STAT_PauseRelevancy_Pairs, Pairs.Num());
+	SET_DWORD_STAT(STAT_PauseRelevancy_Queue, RefreshQueue.Num());
+}
+
+int32 FShooterPauseRelevancy::IssueTraces(FVisibilityPair& Pair, uint64 Key)
+{
+	AShooterCharacter* Pawn = Pair.Pawn.Get();
+	APlayerController* Viewer = Pair.Viewer.Get();
+	UWorld* MyWorld = World.Get();
+	if (Pawn == nullptr || Viewer == nullptr || MyWorld == nullptr)
+	{
+		return 0;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Viewer->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(LineOfSight), true, Viewer->GetPawn());
+	CollisionParams.AddIgnoredActor(Pawn);
+
+	TArray<FVector, TInlineAllocator<8>> PointsToTest;
+	Pawn->BuildPauseReplicationCheckPoints(PointsToTest);
+
+	FTraceDelegate TraceDelegate = FTraceDelegate::CreateSP(this, &FShooterPauseRelevancy::OnTraceDone, Key);
+	for (const FVector& PointToTest : PointsToTest)
+	{
+		MyWorld->AsyncLineTraceByChannel(EAsyncTraceType::Test, PointToTest, ViewLocation, ECC_Visibility, CollisionParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate);
+	}
+
+	Pair.PendingTraces = PointsToTest.Num();
+	return PointsToTest.Num();
+}
+
+void FShooterPauseRelevancy::OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint64 Key)
+{
+	FVisibilityPair* Pair = Pairs.Find(Key);
+	UWorld* MyWorld = World.Get();
+	if (Pair == nullptr || MyWorld == nullptr)
+	{
+		return;
+	}
+
+	const float Now = MyWorld->GetTimeSeconds();
+
+	// Test traces only report a hit when they are blocked
+	if (Datum.OutHits.Num() == 0)
+	{
+		Pair->LastVisibleTime = Now;
+	}
+
+	if (--Pair->PendingTraces == 0)
+	{
+		Pair->LastRefreshTime = Now;
+	}
+}
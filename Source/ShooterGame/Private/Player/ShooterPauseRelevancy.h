@@ -0,0 +1,70 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+class AShooterCharacter;
+class APlayerController;
+
+/**
+ * Server side pawn to viewer visibility matrix behind AShooterCharacter::IsReplicationPausedForConnection.
+ *
+ * Replication only reads the cached state of a (pawn, viewer) pair. Stale pairs are queued and refreshed with async line traces,
+ * at most p.NetPauseRelevancyTraceBudget traces per frame, so the cost no longer scales with pawns x connections x replication passes.
+ * A pair pauses only after it was occluded for p.NetPauseRelevancyPauseDelay seconds and resumes as soon as one trace reaches the
+ * viewer. Viewers in the same or a neighbouring grid cell never pause the pawn and are not traced at all.
+ */
+class FShooterPauseRelevancy : public TSharedFromThis<FShooterPauseRelevancy>
+{
+public:
+
+	FShooterPauseRelevancy(UWorld* InWorld);
+
+	/** Returns true if the pawn is hidden from the viewer. Never traces synchronously, a refresh is scheduled if the pair is stale. */
+	bool IsPaused(AShooterCharacter* Pawn, APlayerController* Viewer);
+
+private:
+
+	struct FVisibilityPair
+	{
+		TWeakObjectPtr<AShooterCharacter> Pawn;
+		TWeakObjectPtr<APlayerController> Viewer;
+
+		/** Last time a trace reached the viewer. Pairs start out visible. */
+		float LastVisibleTime;
+
+		/** Last time a refresh completed */
+		float LastRefreshTime;
+
+		/** Last time replication asked for this pair. Pairs that are no longer asked for are pruned. */
+		float LastQueryTime;
+
+		/** Traces of the current refresh still in flight */
+		int32 PendingTraces;
+
+		bool bQueued;
+	};
+
+	/** Issues queued refreshes within the trace budget and prunes dead pairs. Runs once per frame, on the first query. */
+	void UpdateFrame();
+
+	/** Starts the async traces of a refresh. Returns the number of traces issued. */
+	int32 IssueTraces(FVisibilityPair& Pair, uint64 Key);
+
+	void OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint64 Key);
+
+	static uint64 MakeKey(const AShooterCharacter* Pawn, const APlayerController* Viewer);
+
+	TWeakObjectPtr<UWorld> World;
+
+	TMap<uint64, FVisibilityPair> Pairs;
+
+	/** Pairs waiting for a refresh, oldest first */
+	TArray<uint64> RefreshQueue;
+
+	uint64 LastUpdateFrame;
+
+	float LastPruneTime;
+};
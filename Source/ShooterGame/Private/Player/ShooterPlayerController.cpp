@@ -18,7 +18,6 @@
 #include "ShooterGameInstance.h"
 #include "ShooterLeaderboards.h"
 #include "Sound/SoundNodeLocalPlayer.h"
-#include "AudioThread.h"
 
 #define  ACH_FRAG_SOMEONE	TEXT("ACH_FRAG_SOMEONE")
 #define  ACH_SOME_KILLS		TEXT("ACH_SOME_KILLS")
@@ -146,13 +145,6 @@ void AShooterPlayerController::TickActor(float DeltaTime, enum ELevelTick TickTy
 			}
 		}
 	}
-
-	const bool bLocallyControlled = IsLocalController();
-	const uint32 UniqueID = GetUniqueID();
-	FAudioThread::RunCommandOnAudioThread([UniqueID, bLocallyControlled]()
-	{
-		USoundNodeLocalPlayer::GetLocallyControlledActorCache().Add(UniqueID, bLocallyControlled);
-	});
 };
 
 void AShooterPlayerController::BeginDestroy()
@@ -162,11 +154,7 @@ void AShooterPlayerController::BeginDestroy()
 
 	if (!GExitPurge)
 	{
-		const uint32 UniqueID = GetUniqueID();
-		FAudioThread::RunCommandOnAudioThread([UniqueID]()
-		{
-			USoundNodeLocalPlayer::GetLocallyControlledActorCache().Remove(UniqueID);
-		});
+		USoundNodeLocalPlayer::ClearLocallyControlled(this);
 	}
 }
 
@@ -174,6 +162,8 @@ void AShooterPlayerController::SetPlayer( UPlayer* InPlayer )
 {
 	Super::SetPlayer( InPlayer );
 
+	USoundNodeLocalPlayer::SetLocallyControlled(this, IsLocalController());
+
 	if (ULocalPlayer* const LocalPlayer = Cast<ULocalPlayer>(Player))
 	{
 		//Build menu only after game is initialized
@@ -623,6 +613,11 @@ void AShooterPlayerController::SetInfiniteClip(bool bEnable)
 void AShooterPlayerController::SetHealthRegen(bool bEnable)
 {
 	bHealthRegen = bEnable;
+
+	if (AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetPawn()))
+	{
+		MyPawn->UpdateHealthRegen();
+	}
 }
 
 void AShooterPlayerController::SetGodMode(bool bEnable)
@@ -538,6 +538,9 @@ void UShooterGameInstance::OnUserCanPlay(const FUniqueNetId& UserId, EUserPrivil
 
 void UShooterGameInstance::CreateNewRTSession()
 {
+	// the network thread must not outlive the session it updates
+	RTNetworkThread.Reset();
+
 	RTListener = MakeShareable(new RTSessionListener(this));
 	RTSession = MakeShareable(GameSparksRT::SessionBuilder()
 		.SetConnectToken(TCHAR_TO_UTF8(*SessionInfo->AccessToken))
@@ -546,7 +549,9 @@ void UShooterGameInstance::CreateNewRTSession()
 		.SetListener(RTListener.Get())
 		.Build());
 
+	RTPacketRouter.BeginSession();
 	RTSession->Start();
+	RTNetworkThread = FShooterRTNetworkThread::Create(*RTSession);
 	AShooterPlayerController_Menu* const MenuPC = Cast<AShooterPlayerController_Menu>(UGameplayStatics::GetPlayerController(GetWorld(), 0));
 	if (MenuPC)
 	{
@@ -654,61 +659,88 @@ if (RTSession->SendRTData(1, GameSparksRT::DeliveryIntent::RELIABLE, data, PeerI
 	UE_LOG(LogOnlineGame, Warning, TEXT("Sent message: %s"), UTF8_TO_TCHAR(MessageText.c_str()));
 }*/
 void UShooterGameInstance::OnPacket(const RTPacket& packet)
+{
+	RTPacketRouter.DispatchGameThread(*this, packet);
+}
+
+void UShooterGameInstance::OnRTChatPacket(const FShooterRTChatPacket& Packet)
 {
 	AShooterPlayerController_Menu* const MenuPC = Cast<AShooterPlayerController_Menu>(UGameplayStatics::GetPlayerController(GetWorld(), 0));
-	if (MenuPC)
+	const RTPlayer* const rtPlayer = GetRTPlayerFromPeerId(Packet.Sender);
+	if (MenuPC && rtPlayer)
 	{
-		switch (packet.OpCode)
-		{
-		case 1:
-			/*for (auto it = SessionInfo->PlayerList.CreateIterator(); it; ++it)
-			{
-				RTPlayer rtPlayer = *it;
-				if (rtPlayer.PeerID == packet.Sender)
-				{
-					MenuPC->OnChatMessageReceived(rtPlayer.PeerID, rtPlayer.DisplayName, FString(UTF8_TO_TCHAR(packet.Data.GetString(1).GetValueOrDefault("").c_str())));
-					break;
-				}
-			}*/
-			break;
-		default:
-			break;
-		}
+		MenuPC->OnChatMessageReceived("Team", rtPlayer->ID, rtPlayer->DisplayName, FString(UTF8_TO_TCHAR(Packet.Message.c_str())));
 	}
 }
 
 void UShooterGameInstance::OnPlayerConnect(int PeerId)
 {
-	TSharedPtr<RTPlayer> player = GetRTPlayerFromPeerId(PeerId);
+	const RTPlayer* player = GetRTPlayerFromPeerId(PeerId);
 	if (player)
 	{
-		OnChatMessageReceived("System", "System", player->DisplayName, "has connected");
+		QueueSystemChatMessage(PendingConnectNames, player->DisplayName);
 	}
 }
 
 void UShooterGameInstance::OnPlayerDisconnect(int PeerId)
 {
-	TSharedPtr<RTPlayer> player = GetRTPlayerFromPeerId(PeerId);
+	const RTPlayer* player = GetRTPlayerFromPeerId(PeerId);
 	if (player)
 	{
-		OnChatMessageReceived("System", "System", player->DisplayName, "has disconnected");
+		QueueSystemChatMessage(PendingDisconnectNames, player->DisplayName);
 	}
 }
 
-TSharedPtr<RTPlayer> UShooterGameInstance::GetRTPlayerFromPeerId(int PeerId)
+void UShooterGameInstance::QueueSystemChatMessage(TArray<FString>& PendingNames, const FString& DisplayName)
 {
-	if (SessionInfo.IsValid())
+	// a player dropping in and out repeatedly is only named once
+	PendingNames.AddUnique(DisplayName);
+
+	// the first message after a quiet period goes out right away, the ones following it are gathered until the period ends
+	if (!GetTimerManager().IsTimerActive(TimerHandle_SystemChat))
 	{
-		for (auto it = SessionInfo->PlayerList.CreateIterator(); it; ++it)
-		{
-			TSharedPtr<RTPlayer> rtPlayer = *it;
-			if (rtPlayer->PeerID == PeerId)
-			{
-				return rtPlayer;
-			}
-		}
+		FlushSystemChatMessages();
 	}
-	return NULL;
+}
+
+void UShooterGameInstance::FlushSystemChatMessages()
+{
+	const float SystemChatInterval = 2.0f;
+
+	const bool bSentConnects = SendSystemChatMessage(PendingConnectNames, TEXT("has connected"), TEXT("have connected"));
+	const bool bSentDisconnects = SendSystemChatMessage(PendingDisconnectNames, TEXT("has disconnected"), TEXT("have disconnected"));
+	if (bSentConnects || bSentDisconnects)
+	{
+		GetTimerManager().SetTimer(TimerHandle_SystemChat, this, &UShooterGameInstance::FlushSystemChatMessages, SystemChatInterval, false);
+	}
+}
+
+bool UShooterGameInstance::SendSystemChatMessage(TArray<FString>& PendingNames, const FString& SingleMessage, const FString& GroupMessage)
+{
+	if (PendingNames.Num() == 0)
+	{
+		return false;
+	}
+
+	const int32 MaxNamesListed = 3;
+	FString Names = PendingNames[0];
+	for (int32 i = 1; i < FMath::Min(PendingNames.Num(), MaxNamesListed); i++)
+	{
+		Names += TEXT(", ") + PendingNames[i];
+	}
+	if (PendingNames.Num() > MaxNamesListed)
+	{
+		Names += FString::Printf(TEXT(" and %d others"), PendingNames.Num() - MaxNamesListed);
+	}
+
+	OnChatMessageReceived("System", "System", Names, PendingNames.Num() == 1 ? SingleMessage : GroupMessage);
+	PendingNames.Reset();
+	return true;
+}
+
+const RTPlayer* UShooterGameInstance::GetRTPlayerFromPeerId(int PeerId) const
+{
+	return SessionInfo.IsValid() ? SessionInfo->FindPlayer(PeerId) : nullptr;
 }
 
 void UShooterGameInstance::Logout(int32 LocalUserNum)
@@ -752,6 +784,7 @@ void UShooterGameInstance::Shutdown()
 {
 	if (RTSession.IsValid())
 	{
+		RTNetworkThread.Reset();
 		RTSession->Stop();
 		RTSession.Reset();
 	}
@@ -1871,7 +1904,14 @@ bool UShooterGameInstance::Tick(float DeltaSeconds)
 {
 	if (RTSession.IsValid())
 	{
-		RTSession->Update();
+		if (RTNetworkThread.IsValid())
+		{
+			RTSession->DispatchCallbacks();
+		}
+		else
+		{
+			RTSession->Update();
+		}
 	}
 
 	// Dedicated server doesn't need to worry about game state
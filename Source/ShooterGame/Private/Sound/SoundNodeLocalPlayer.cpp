@@ -6,7 +6,11 @@
 
 #define LOCTEXT_NAMESPACE "SoundNodeLocalPlayer"
 
-TMap<uint32, bool> USoundNodeLocalPlayer::LocallyControlledActorCache;
+DECLARE_STATS_GROUP(TEXT("ShooterSound"), STATGROUP_ShooterSound, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Local player registry writes"), STAT_LocalPlayerRegistry_Writes, STATGROUP_ShooterSound);
+DECLARE_MEMORY_STAT(TEXT("Local player registry memory"), STAT_LocalPlayerRegistry_Memory, STATGROUP_ShooterSound);
+
+TAtomic<TAtomic<int64>*> USoundNodeLocalPlayer::RegistryChunks[USoundNodeLocalPlayer::RegistryMaxChunks];
 
 USoundNodeLocalPlayer::USoundNodeLocalPlayer(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -14,12 +18,7 @@ USoundNodeLocalPlayer::USoundNodeLocalPlayer(const FObjectInitializer& ObjectIni
 
 void USoundNodeLocalPlayer::ParseNodes(FAudioDevice* AudioDevice, const UPTRINT NodeWaveInstanceHash, FActiveSound& ActiveSound, const FSoundParseParameters& ParseParams, TArray<FWaveInstance*>& WaveInstances)
 {
-	bool bLocallyControlled = false;
-	if (bool* LocallyControlledPtr = LocallyControlledActorCache.Find(ActiveSound.GetOwnerID()))
-	{
-		bLocallyControlled = *LocallyControlledPtr;
-	}
-
+	const bool bLocallyControlled = IsLocallyControlled(ActiveSound.GetOwnerID());
 	const int32 PlayIndex = bLocallyControlled ? 0 : 1;
 
 	if (PlayIndex < ChildNodes.Num() && ChildNodes[PlayIndex])
@@ -28,6 +27,83 @@ void USoundNodeLocalPlayer::ParseNodes(FAudioDevice* AudioDevice, const UPTRINT
 	}
 }
 
+TAtomic<int64>* USoundNodeLocalPlayer::GetRegistryEntry(uint32 OwnerID, bool bCreate)
+{
+	const uint32 ChunkIndex = OwnerID / RegistryChunkSize;
+	if (ChunkIndex >= RegistryMaxChunks)
+	{
+		return nullptr;
+	}
+
+	TAtomic<int64>* Chunk = RegistryChunks[ChunkIndex].Load();
+	if (Chunk == nullptr && bCreate)
+	{
+		check(IsInGameThread());
+		Chunk = new TAtomic<int64>[RegistryChunkSize];
+		for (int32 EntryIndex = 0; EntryIndex < RegistryChunkSize; ++EntryIndex)
+		{
+			Chunk[EntryIndex].Store(0);
+		}
+		INC_MEMORY_STAT_BY(STAT_LocalPlayerRegistry_Memory, RegistryChunkSize * sizeof(TAtomic<int64>));
+
+		// publish after the entries are cleared
+		RegistryChunks[ChunkIndex].Store(Chunk);
+	}
+
+	return Chunk ? &Chunk[OwnerID % RegistryChunkSize] : nullptr;
+}
+
+void USoundNodeLocalPlayer::SetLocallyControlled(const UObject* Owner, bool bLocallyControlled)
+{
+	check(IsInGameThread());
+	if (Owner == nullptr)
+	{
+		return;
+	}
+
+	const uint32 OwnerID = Owner->GetUniqueID();
+	const int64 SerialNumber = GUObjectArray.AllocateSerialNumber(OwnerID);
+	const int64 NewValue = (SerialNumber << 1) | (bLocallyControlled ? 1 : 0);
+
+	// nothing to record for remote owners that were never local
+	TAtomic<int64>* const Entry = GetRegistryEntry(OwnerID, bLocallyControlled);
+	if (Entry && Entry->Load() != NewValue)
+	{
+		Entry->Store(NewValue);
+		INC_DWORD_STAT(STAT_LocalPlayerRegistry_Writes);
+	}
+}
+
+void USoundNodeLocalPlayer::ClearLocallyControlled(const UObject* Owner)
+{
+	check(IsInGameThread());
+	if (Owner == nullptr)
+	{
+		return;
+	}
+
+	const uint32 OwnerID = Owner->GetUniqueID();
+	TAtomic<int64>* const Entry = GetRegistryEntry(OwnerID, false);
+	if (Entry == nullptr)
+	{
+		return;
+	}
+
+	const int64 SerialNumber = GUObjectArray.GetSerialNumber(OwnerID);
+	const int64 Value = Entry->Load();
+	if (Value != 0 && (Value >> 1) == SerialNumber)
+	{
+		Entry->Store(0);
+		INC_DWORD_STAT(STAT_LocalPlayerRegistry_Writes);
+	}
+}
+
+bool USoundNodeLocalPlayer::IsLocallyControlled(uint32 OwnerID)
+{
+	const TAtomic<int64>* const Entry = GetRegistryEntry(OwnerID, false);
+	return Entry && (Entry->Load() & 1) != 0;
+}
+
 #if WITH_EDITOR
 FText USoundNodeLocalPlayer::GetInputPinName(int32 PinIndex) const
 {
@@ -14,6 +14,11 @@
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
+DECLARE_STATS_GROUP(TEXT("ShooterHUD"), STATGROUP_ShooterHUD, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("DrawHUD"), STAT_HUD_Draw, STATGROUP_ShooterHUD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Text layouts"), STAT_HUD_TextLayouts, STATGROUP_ShooterHUD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Text items"), STAT_HUD_TextItems, STATGROUP_ShooterHUD);
+
 const float AShooterHUD::MinHudScale = 0.5f;
 
 AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -25,6 +30,8 @@ AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(Ob
 	NoAmmoNotifyTime = -NoAmmoFadeOutTime;
 	LastKillTime = - KillFadeOutTime;
 	LastEnemyHitTime = -LastEnemyHitDisplayTime;
+	FirstDeathMessage = 0;
+	NumDeathMessages = 0;
 
 	OnPlayerTalkingStateChangedDelegate = FOnPlayerTalkingStateChangedDelegate::CreateUObject(this, &AShooterHUD::OnPlayerTalkingStateChanged);
 
@@ -176,30 +183,36 @@ void AShooterHUD::DrawWeaponHUD()
 			Canvas->DrawIcon(MyWeapon->PrimaryIcon, PriWeapPosX, PriWeapPosY, ScaleUI);
 
 			const float TextOffset = 12;
-			float SizeX, SizeY;
 			float TopTextHeight;
-			FString Text = FString::FromInt(MyWeapon->GetCurrentAmmoInClip());
-
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			const int32 AmmoInClip = MyWeapon->GetCurrentAmmoInClip();
+			if (PrimaryClipText.NeedsUpdate(AmmoInClip))
+			{
+				PrimaryClipText.Set(AmmoInClip, FText::FromString(FString::FromInt(AmmoInClip)));
+			}
+			const FVector2D& TopTextSize = MeasureText(PrimaryClipText, BigFont);
 
 			const float TopTextScale = 0.73f; // of 51pt font
-			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
+			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + TopTextSize.X * TopTextScale) / 2.0f)  * ScaleUI;
 			const float TopTextPosY = Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset - TextOffset / 2.0f) * ScaleUI; 
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = PrimaryClipText.Text;
 			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
-			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
-			TopTextHeight = SizeY * TopTextScale;
-			Text = FString::FromInt(MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip());
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			QueueTextItem( TextItem, TopTextPosX, TopTextPosY );
+			TopTextHeight = TopTextSize.Y * TopTextScale;
+			const int32 SpareAmmo = MyWeapon->GetCurrentAmmo() - AmmoInClip;
+			if (PrimarySpareText.NeedsUpdate(SpareAmmo))
+			{
+				PrimarySpareText.Set(SpareAmmo, FText::FromString(FString::FromInt(SpareAmmo)));
+			}
+			const FVector2D& BottomTextSize = MeasureText(PrimarySpareText, BigFont);
 
 			const float BottomTextScale = 0.49f; // of 51pt font
-			const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * BottomTextScale) / 2.0f) * ScaleUI; 
+			const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + BottomTextSize.X * BottomTextScale) / 2.0f) * ScaleUI; 
 			const float BottomTextPosY = TopTextPosY + (TopTextHeight - 0.8f * TextOffset) * ScaleUI;
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = PrimarySpareText.Text;
 			TextItem.Scale = FVector2D( BottomTextScale*ScaleUI, BottomTextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
-			Canvas->DrawItem( TextItem, BottomTextPosX, BottomTextPosY );
+			QueueTextItem( TextItem, BottomTextPosX, BottomTextPosY );
 
 			// Drawing clip icons
 			Canvas->SetDrawColor(FColor::White);
@@ -295,21 +308,23 @@ void AShooterHUD::DrawWeaponHUD()
 			Canvas->SetDrawColor(FColor::White);
 			Canvas->DrawIcon(SecondaryWeapon->SecondaryIcon, SecWeapPosX, SecWeapPosY, ScaleUI);
 
-			const float TextOffset = 10;
-			float SizeX, SizeY;
 			float TopTextHeight;
-			FString Text = FString::FromInt(SecondaryWeapon->GetCurrentAmmo());
+			const int32 SecondaryAmmo = SecondaryWeapon->GetCurrentAmmo();
+			if (SecondaryAmmoText.NeedsUpdate(SecondaryAmmo))
+			{
+				SecondaryAmmoText.Set(SecondaryAmmo, FText::FromString(FString::FromInt(SecondaryAmmo)));
+			}
+			const FVector2D& TopTextSize = MeasureText(SecondaryAmmoText, BigFont);
 
-			Canvas->StrLen(BigFont,Text, SizeX, SizeY);
 			const float TopTextScale = 0.53f; // of 51pt font
-			TopTextHeight = SizeY * TopTextScale;
+			TopTextHeight = TopTextSize.Y * TopTextScale;
 
-			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (SecClipBoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
+			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (SecClipBoxWidth + TopTextSize.X * TopTextScale) / 2.0f)  * ScaleUI;
 			const float TopTextPosY = SecWeapBgPosY + (SecondaryWeapBg.VL - TopTextHeight) / 2.0f * ScaleUI; 
 
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = SecondaryAmmoText.Text;
 			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
-			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
+			QueueTextItem( TextItem, TopTextPosX, TopTextPosY );
 		}
 		// END OF SECONDARY WEAPON
 	}
@@ -349,43 +364,46 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 	{
 		FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 		TextItem.EnableShadow( FLinearColor::Black );
-		float SizeX, SizeY;
 		float TextScale = 0.57f;
-		FString Text;
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.Scale = FVector2D( TextScale*ScaleUI, TextScale*ScaleUI );
 		if (MyGameState->GetMatchState() == MatchState::WaitingToStart)
 		{
+			if (WarmupText.NeedsUpdate(MyGameState->RemainingTime))
+			{
+				WarmupText.Set(MyGameState->RemainingTime, FText::FromString(LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime)));
+			}
 			TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-			Text = LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime);
 			TextItem.SetColor( HUDLight );
-			TextItem.Text = FText::FromString( Text );			
-			AddMatchInfoString(TextItem);
+			AddMatchInfoString(TextItem, WarmupText);
 		}
 		else if (MyGameState->GetMatchState() == MatchState::InProgress)
 		{
-			Text = GetTimeString(MyGameState->RemainingTime);
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			if (TimerText.NeedsUpdate(MyGameState->RemainingTime))
+			{
+				TimerText.Set(MyGameState->RemainingTime, FText::FromString(GetTimeString(MyGameState->RemainingTime)));
+			}
+			const FVector2D& TimerSize = MeasureText(TimerText, BigFont);
 
 			TextItem.SetColor( HUDDark );
-			TextItem.Text = FText::FromString( Text );
-			TextItem.Position = FVector2D( TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
-				TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
-			Canvas->DrawItem(TextItem);
+			TextItem.Text = TimerText.Text;
+			QueueTextItem(TextItem, TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
+				TimerPosY + (TimePlaceBg.VL * ScaleUI - TimerSize.Y * TextScale * ScaleUI) / 2 );
 		}
 
 		float BoxWidth = 45.0f * ScaleUI;
-		Text = FString();
 		AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(PlayerOwner);
 		if (MyPC && MyGameState && MatchState == EShooterMatchState::Playing)
 		{
 			AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyPC->PlayerState);
 			if (MyPlayerState)
 			{
+				int32 MyPos = 0;
+				int32 NumPlaces = 0;
 				if (MyGameState->NumTeams > 1) // team based game
 				{
 					int32 MyTeam = MyPlayerState->GetTeamNum();
-					int32 MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
+					MyPos = FMath::Max(1, MyGameState->TeamScores.Num());
 					for (int32 i=0; i < MyGameState->TeamScores.Num(); i++)
 					{
 						if (MyGameState->TeamScores.Num() > MyTeam &&
@@ -394,36 +412,36 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 							MyPos--;
 						}
 					}
-					int32 NumTeams = 0;
 					for (int32 i=0; i < MyGameState->NumTeams; i++)
 					{
-						RankedPlayerMap PlayerStateMap;
-						MyGameState->GetRankedMap(i,PlayerStateMap);
-						if(PlayerStateMap.Num() > 0)
+						if (MyGameState->GetNumRankedPlayers(i) > 0)
 						{
-							NumTeams++;
+							NumPlaces++;
 						}
 					}
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, NumTeams);
 				}
 				else // free for all
 				{
-					RankedPlayerMap PlayerStateMap;
-					MyGameState->GetRankedMap(0,PlayerStateMap);
-					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
+					const int32 MyRank = MyGameState->GetPlayerRank(MyPlayerState);
+					MyPos = MyRank != INDEX_NONE ? MyRank + 1 : 0;
+					NumPlaces = MyGameState->GetNumRankedPlayers(0);
+				}
+
+				const int32 PositionKey = (MyPos << 16) | (NumPlaces & 0xffff);
+				if (PositionText.NeedsUpdate(PositionKey))
+				{
+					PositionText.Set(PositionKey, FText::FromString(FString::Printf(TEXT("%d/%d"), MyPos, NumPlaces)));
 				}
-				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+				const FVector2D& PositionSize = MeasureText(PositionText, BigFont);
 				Canvas->DrawIcon(PlaceIcon,
-					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (SizeX * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
+					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (PositionSize.X * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
 					TimerPosY + (TimePlaceBg.VL - PlaceIcon.VL) / 2.0f * ScaleUI, ScaleUI);
 
-				TextItem.Text = FText::FromString( Text);
+				TextItem.Text = PositionText.Text;
 				TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 				TextItem.FontRenderInfo = ShadowedFont;
-				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + SizeX * TextScale * ScaleUI),
-					TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+				QueueTextItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + PositionSize.X * TextScale * ScaleUI),
+					TimerPosY + (TimePlaceBg.VL * ScaleUI - PositionSize.Y * TextScale * ScaleUI) / 2 );
 			}
 		}
 	}
@@ -447,32 +465,31 @@ void AShooterHUD::DrawKills()
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 
-	float SizeX, SizeY;
-	FString Text = LOCTEXT("Kills", "KILLS:").ToString();
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+	if (KillsLabelText.NeedsUpdate(0))
+	{
+		KillsLabelText.Set(0, LOCTEXT("Kills", "KILLS:"));
+	}
+	const FVector2D& LabelSize = MeasureText(KillsLabelText, BigFont);
 
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = KillsLabelText.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 	TextItem.FontRenderInfo = ShadowedFont;
 	TextItem.SetColor(HUDDark);
-	Canvas->DrawItem( TextItem, KillsPosX + Offset * ScaleUI + KillsIcon.UL * 1.5f * ScaleUI,
-		KillsPosY + (KillsBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+	QueueTextItem( TextItem, KillsPosX + Offset * ScaleUI + KillsIcon.UL * 1.5f * ScaleUI,
+		KillsPosY + (KillsBg.VL * ScaleUI - LabelSize.Y * TextScale * ScaleUI) / 2 );
 
-	if (MyPlayerState)
-	{
-		Text = FString::FromInt(MyPlayerState->GetKills());
-	}
-	else 
+	const int32 NumKills = MyPlayerState->GetKills();
+	if (KillsText.NeedsUpdate(NumKills))
 	{
-		Text = FString("0");
+		KillsText.Set(NumKills, FText::FromString(FString::FromInt(NumKills)));
 	}
 	TextScale = 0.88f;
 	float BoxWidth = 135.0f * ScaleUI;
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-	TextItem.Text = FText::FromString( Text );
+	const FVector2D& KillsSize = MeasureText(KillsText, BigFont);
+	TextItem.Text = KillsText.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
-	Canvas->DrawItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + SizeX * TextScale * ScaleUI) /2,
-		KillsPosY + (KillsBg.VL* ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
+	QueueTextItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + KillsSize.X * TextScale * ScaleUI) /2,
+		KillsPosY + (KillsBg.VL* ScaleUI - KillsSize.Y * TextScale * ScaleUI) / 2 );
 
 }
 
@@ -488,6 +505,8 @@ void AShooterHUD::NotifyEnemyHit()
 
 void AShooterHUD::DrawHUD()
 {
+	SCOPE_CYCLE_COUNTER(STAT_HUD_Draw);
+
 	Super::DrawHUD();
 	if (Canvas == nullptr)
 	{
@@ -515,8 +534,9 @@ void AShooterHUD::DrawHUD()
 	}
 
 
-	// Empty the info item array
-	InfoItems.Empty();
+	// Empty the info item array, keeping its memory for the next frame
+	InfoItems.Reset();
+	QueuedTextItems.Reset();
 	float TextScale = 1.0f;
 	// enforce min
 	ScaleUI = FMath::Max(ScaleUI, MinHudScale);
@@ -542,26 +562,32 @@ void AShooterHUD::DrawHUD()
 	// net mode
 	if (GetNetMode() != NM_Standalone)
 	{
-		FString NetModeDesc = (GetNetMode() == NM_Client) ? TEXT("Client") : TEXT("Server");
+		FNamedOnlineSession* Session = nullptr;
 		IOnlineSubsystem * OnlineSubsystem = IOnlineSubsystem::Get();
 		if(OnlineSubsystem)
 		{
 			IOnlineSessionPtr SessionSubsystem = OnlineSubsystem->GetSessionInterface();
 			if(SessionSubsystem.IsValid())
 			{
-				FNamedOnlineSession * Session = SessionSubsystem->GetNamedSession(NAME_GameSession);
-				if(Session)
-				{
-					NetModeDesc += TEXT("\nSession: ");
-					NetModeDesc += Session->SessionInfo->GetSessionId().ToString();
-				}
+				Session = SessionSubsystem->GetNamedSession(NAME_GameSession);
 			}
-
 		}
 
-		NetModeDesc += FString::Printf( TEXT( "\nVersion: %i, %s, %s" ), FNetworkVersion::GetNetworkCompatibleChangelist(), UTF8_TO_TCHAR(__DATE__), UTF8_TO_TCHAR(__TIME__) );
+		// the session id doesn't change while the session exists
+		const int32 NetModeKey = GetNetMode() * 2 + (Session ? 1 : 0);
+		if (NetModeText.NeedsUpdate(NetModeKey))
+		{
+			FString NetModeDesc = (GetNetMode() == NM_Client) ? TEXT("Client") : TEXT("Server");
+			if (Session)
+			{
+				NetModeDesc += TEXT("\nSession: ");
+				NetModeDesc += Session->SessionInfo->GetSessionId().ToString();
+			}
+			NetModeDesc += FString::Printf( TEXT( "\nVersion: %i, %s, %s" ), FNetworkVersion::GetNetworkCompatibleChangelist(), UTF8_TO_TCHAR(__DATE__), UTF8_TO_TCHAR(__TIME__) );
+			NetModeText.Set(NetModeKey, FText::FromString(NetModeDesc));
+		}
 
-		DrawDebugInfoString(NetModeDesc, Canvas->OrgX + Offset*ScaleUI, Canvas->OrgY + 5*Offset*ScaleUI, true, true, HUDLight);
+		DrawDebugInfoString(NetModeText, Canvas->OrgX + Offset*ScaleUI, Canvas->OrgY + 5*Offset*ScaleUI, true, true, HUDLight);
 	}
 
 	DrawMatchTimerAndPosition();
@@ -582,14 +608,16 @@ void AShooterHUD::DrawHUD()
 		else
 		{
 			// respawn
-			FString Text = LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN").ToString();
+			if (RespawnText.NeedsUpdate(0))
+			{
+				RespawnText.Set(0, LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN"));
+			}
 			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDLight);
-			AddMatchInfoString(TextItem);
+			AddMatchInfoString(TextItem, RespawnText);
 		}
 
 		DrawDeathMessages();
@@ -603,31 +631,33 @@ void AShooterHUD::DrawHUD()
 		const float CurrentTime = GetWorld()->GetTimeSeconds();
 		if (CurrentTime - NoAmmoNotifyTime >= 0 && CurrentTime - NoAmmoNotifyTime <= NoAmmoFadeOutTime)
 		{
-			FString Text = FString();
-
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - NoAmmoNotifyTime) / NoAmmoFadeOutTime);
-			Text = LOCTEXT("NoAmmo", "NO AMMO").ToString();
+			if (NoAmmoText.NeedsUpdate(0))
+			{
+				NoAmmoText.Set(0, LOCTEXT("NoAmmo", "NO AMMO"));
+			}
 			
 			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(FLinearColor(0.75f, 0.125f, 0.125f, Alpha ));
-			AddMatchInfoString(TextItem);			
+			AddMatchInfoString(TextItem, NoAmmoText);
 		}
 	}
 
 	// Render the info messages such as wating to respawn - these will be drawn below any 'killed player' message.
 	ShowInfoItems(MessageOffset, 1.0f);
-	
+
+	FlushTextItems();
 }
 
-void AShooterHUD::DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor)
+void AShooterHUD::DrawDebugInfoString(FHUDCachedText& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor)
 {
 #if !UE_BUILD_SHIPPING
-	float SizeX, SizeY;
-	Canvas->StrLen(NormalFont, Text, SizeX, SizeY);
+	const FVector2D& TextSize = MeasureText(Text, NormalFont);
+	const float SizeX = TextSize.X;
+	const float SizeY = TextSize.Y;
 
 	const float UsePosX = bAlignLeft ? PosX : PosX - SizeX;
 	const float UsePosY = bAlignTop ? PosY : PosY - SizeY;
@@ -644,14 +674,49 @@ void AShooterHUD::DrawDebugInfoString(const FString& Text, float PosX, float Pos
 	TileItem.BlendMode = SE_BLEND_Translucent;
 	Canvas->DrawItem( TileItem );
 
-	FCanvasTextItem TextItem( FVector2D( UsePosX, UsePosY), FText::FromString( Text ), NormalFont, TextColor );
+	FCanvasTextItem TextItem( FVector2D::ZeroVector, Text.Text, NormalFont, TextColor );
 	TextItem.EnableShadow( FLinearColor::Black );
 	TextItem.FontRenderInfo = ShadowedFont;
 	TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-	Canvas->DrawItem( TextItem );
+	QueueTextItem( TextItem, UsePosX, UsePosY );
 #endif
 }
 
+const FVector2D& AShooterHUD::MeasureText(FHUDCachedText& CachedText, UFont* Font)
+{
+	if (CachedText.MeasuredFont != Font)
+	{
+		INC_DWORD_STAT(STAT_HUD_TextLayouts);
+		Canvas->StrLen(Font, CachedText.Text.ToString(), CachedText.Size.X, CachedText.Size.Y);
+		CachedText.MeasuredFont = Font;
+	}
+	return CachedText.Size;
+}
+
+void AShooterHUD::QueueTextItem(const FCanvasTextItem& TextItem, float X, float Y)
+{
+	FCanvasTextItem& QueuedItem = QueuedTextItems[QueuedTextItems.Add(TextItem)];
+	QueuedItem.Position = FVector2D(X, Y);
+}
+
+void AShooterHUD::FlushTextItems()
+{
+	INC_DWORD_STAT_BY(STAT_HUD_TextItems, QueuedTextItems.Num());
+
+	// icons were drawn as they came and batch by texture, group the text by font so its glyphs batch too.
+	// No text of the HUD overlaps other text, the order between fonts doesn't matter.
+	QueuedTextItems.StableSort([](const FCanvasTextItem& A, const FCanvasTextItem& B)
+	{
+		return A.Font < B.Font;
+	});
+
+	for (FCanvasTextItem& TextItem : QueuedTextItems)
+	{
+		Canvas->DrawItem(TextItem);
+	}
+	QueuedTextItems.Reset();
+}
+
 void AShooterHUD::DrawCrosshair()
 {
 	AShooterPlayerController* PCOwner = Cast<AShooterPlayerController>(PlayerOwner);
@@ -761,37 +826,43 @@ void AShooterHUD::DrawDeathMessages()
 	const FColor RedTeamColor = FColor(152, 70, 70, 255);
 	const FColor OwnerColor = HUDLight;
 
-	const FString KilledText = LOCTEXT("killed"," killed ").ToString();
-	FVector2D KilledTextSize(0.0f, 0.0f);
+	if (KilledText.NeedsUpdate(0))
+	{
+		KilledText.Set(0, LOCTEXT("killed"," killed "));
+	}
+	const FVector2D& KilledTextSize = MeasureText(KilledText, NormalFont);
 
+	// expired messages are always the oldest
 	const float GameTime = GetWorld()->GetTimeSeconds();
+	while (NumDeathMessages > 0 && DeathMessages[FirstDeathMessage].HideTime <= GameTime)
+	{
+		FirstDeathMessage = (FirstDeathMessage + 1) % MaxDeathMessages;
+		NumDeathMessages--;
+	}
+
 	const float LinePadding = 6.0f;
 	const float BoxPadding = 2.0f;
 	const float MaxLineX = 300.0f;
 	const float InitialX = Offset * 2.0f * ScaleUI;
 	const float InitialY = DeathMsgsPosY + (DeathMessagesBg.VL - Offset * 2.5f) * ScaleUI ;
 
-	// draw messages
+	// draw messages, newest at the bottom
 	float CurrentY = InitialY;
 
-	Canvas->StrLen(NormalFont, KilledText, KilledTextSize.X, KilledTextSize.Y);
-
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
-	for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
+	for (int32 i = NumDeathMessages - 1; i >= 0; i--)
 	{
-		const FDeathMessage& Message = DeathMessages[i];
+		FDeathMessage& Message = DeathMessages[(FirstDeathMessage + i) % MaxDeathMessages];
 		float CurrentX = InitialX;
-		FVector2D KillerSize(0.0f, 0.0f);
-		FVector2D VictimNameSize(0.0f, 0.0f);
 		float TextScale = 1.00f;
-		Canvas->StrLen(NormalFont, Message.KillerDesc, KillerSize.X, KillerSize.Y);
+		const FVector2D& KillerSize = MeasureText(Message.KillerDesc, NormalFont);
 		TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.SetColor(Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
 
-		TextItem.Text = FText::FromString( Message.KillerDesc );
-		Canvas->DrawItem(TextItem, CurrentX, CurrentY);
+		TextItem.Text = Message.KillerDesc.Text;
+		QueueTextItem(TextItem, CurrentX, CurrentY);
 		CurrentX += KillerSize.X * TextScale * ScaleUI;
 		
 		if (Message.DamageType.IsValid())
@@ -805,27 +876,25 @@ void AShooterHUD::DrawDeathMessages()
 		}
 		else
 		{
-			TextItem.Text = FText::FromString( KilledText );
+			TextItem.Text = KilledText.Text;
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDDark);
-			Canvas->DrawItem( TextItem, CurrentX, CurrentY );
+			QueueTextItem( TextItem, CurrentX, CurrentY );
 
 			CurrentX += KilledTextSize.X * TextScale * ScaleUI;
 		}
 			
 		TextItem.SetColor(Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));		
 
-		Canvas->StrLen(NormalFont, Message.VictimDesc, VictimNameSize.X, VictimNameSize.Y);
-		TextItem.Text = FText::FromString( Message.VictimDesc );
-		Canvas->DrawItem( TextItem, CurrentX, CurrentY );
+		TextItem.Text = Message.VictimDesc.Text;
+		QueueTextItem( TextItem, CurrentX, CurrentY );
 		CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
 	}
 }
 
 void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState, class AShooterPlayerState* VictimPlayerState, const UDamageType* KillerDamageType)
 {
-	const int32 MaxDeathMessages = 5;
 	const float MessageDuration = 10.0f;
 
 	if (GetWorld()->GetGameState())
@@ -835,14 +904,20 @@ void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState,
 
 		if (DefGame && KillerPlayerState && VictimPlayerState && MyPlayerState)
 		{
-			if (DeathMessages.Num() >= MaxDeathMessages)
+			// when the ring is full the new message takes the place of the oldest
+			FDeathMessage& NewMessage = DeathMessages[(FirstDeathMessage + NumDeathMessages) % MaxDeathMessages];
+			if (NumDeathMessages == MaxDeathMessages)
+			{
+				FirstDeathMessage = (FirstDeathMessage + 1) % MaxDeathMessages;
+			}
+			else
 			{
-				DeathMessages.RemoveAt(0, 1, false);
+				NumDeathMessages++;
 			}
 
-			FDeathMessage NewMessage;
-			NewMessage.KillerDesc = KillerPlayerState->GetShortPlayerName();
-			NewMessage.VictimDesc = VictimPlayerState->GetShortPlayerName();
+			NewMessage = FDeathMessage();
+			NewMessage.KillerDesc.Set(0, FText::FromString(KillerPlayerState->GetShortPlayerName()));
+			NewMessage.VictimDesc.Set(0, FText::FromString(VictimPlayerState->GetShortPlayerName()));
 			NewMessage.KillerTeamNum = KillerPlayerState->GetTeamNum();
 			NewMessage.VictimTeamNum = VictimPlayerState->GetTeamNum();
 			NewMessage.bKillerIsOwner = MyPlayerState == KillerPlayerState;
@@ -851,11 +926,10 @@ void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState,
 			NewMessage.DamageType = MakeWeakObjectPtr(const_cast<UShooterDamageType*>(Cast<const UShooterDamageType>(KillerDamageType)));
 			NewMessage.HideTime = GetWorld()->GetTimeSeconds() + MessageDuration;
 
-			DeathMessages.Add(NewMessage);
 			if (KillerPlayerState == MyPlayerState && VictimPlayerState != MyPlayerState)
 			{
 				LastKillTime = GetWorld()->GetTimeSeconds();
-				CenteredKillMessage = FText::FromString(NewMessage.VictimDesc);
+				CenteredKillMessage.Set(0, NewMessage.VictimDesc.Text);
 			}
 		}
 	}
@@ -1123,9 +1197,11 @@ bool AShooterHUD::IsMatchOver() const
 	return GetMatchState() == EShooterMatchState::Lost || GetMatchState() == EShooterMatchState::Won;
 }
 
-void AShooterHUD::AddMatchInfoString(const FCanvasTextItem InInfoItem )
+void AShooterHUD::AddMatchInfoString(FCanvasTextItem InInfoItem, FHUDCachedText& InfoText)
 {
-	InfoItems.Add(InInfoItem);
+	InInfoItem.Text = InfoText.Text;
+	const FVector2D& TextSize = MeasureText(InfoText, InInfoItem.Font);
+	InfoItems.Add(FHUDInfoItem{ InInfoItem, TextSize });
 }
 
 float AShooterHUD::ShowInfoItems(float YOffset, float TextScale)
@@ -1135,12 +1211,11 @@ float AShooterHUD::ShowInfoItems(float YOffset, float TextScale)
 
 	for (int32 iItem = 0; iItem < InfoItems.Num() ; iItem++)
 	{
-		float X = 0.0f;
-		float SizeX, SizeY; 
-		Canvas->StrLen(InfoItems[iItem].Font, InfoItems[iItem].Text.ToString(), SizeX, SizeY);
-		X = CanvasCentre - ( SizeX * InfoItems[iItem].Scale.X)/2.0f;
-		Canvas->DrawItem(InfoItems[iItem], X, Y);
-		Y += SizeY * InfoItems[iItem].Scale.Y;
+		const FCanvasTextItem& TextItem = InfoItems[iItem].TextItem;
+		const FVector2D& TextSize = InfoItems[iItem].TextSize;
+		const float X = CanvasCentre - ( TextSize.X * TextItem.Scale.X)/2.0f;
+		QueueTextItem(TextItem, X, Y);
+		Y += TextSize.Y * TextItem.Scale.Y;
 	}
 	return Y;
 }
@@ -1156,21 +1231,21 @@ float AShooterHUD::DrawRecentlyKilledPlayer()
 		{
 			FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark);
 			TextItem.EnableShadow(FLinearColor::Black);
-			float SizeX, SizeY;
 			float TextScale = 0.71f;
-			FString Text = CenteredKillMessage.ToString();
 
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - LastKillTime) / KillFadeOutTime);
 			TextItem.Font = BigFont;
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			const FVector2D& TextSize = MeasureText(CenteredKillMessage, BigFont);
+			const float SizeX = TextSize.X;
+			const float SizeY = TextSize.Y;
 			Canvas->SetDrawColor(255, 255, 255, 255 * Alpha);
 			Canvas->DrawIcon(KilledIcon, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f,
 				DrawPos - (Offset * 4 - SizeY / 2 * TextScale + KilledIcon.VL / 2) * ScaleUI, ScaleUI);
 			TextItem.SetColor(FColor(HUDLight.R, HUDLight.G, HUDLight.B, HUDLight.A*Alpha));
-			TextItem.Text = FText::FromString(Text);
+			TextItem.Text = CenteredKillMessage.Text;
 			TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 			LastYPos = (DrawPos - (Offset * 4 * ScaleUI)) + SizeY;
-			Canvas->DrawItem(TextItem, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f + KilledIcon.UL * ScaleUI,
+			QueueTextItem(TextItem, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f + KilledIcon.UL * ScaleUI,
 				DrawPos - ( Offset * 4 * ScaleUI));
 		}
 	}
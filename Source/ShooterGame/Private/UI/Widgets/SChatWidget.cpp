@@ -9,6 +9,12 @@
 #define CHAT_BOX_HEIGHT 192.0f
 #define CHAT_BOX_PADDING 20.0f
 
+DECLARE_STATS_GROUP(TEXT("ShooterChat"), STATGROUP_ShooterChat, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lines added"), STAT_Chat_Added, STATGROUP_ShooterChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lines reused"), STAT_Chat_Reused, STATGROUP_ShooterChat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rows generated"), STAT_Chat_RowsGenerated, STATGROUP_ShooterChat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Lines"), STAT_Chat_Lines, STATGROUP_ShooterChat);
+
 void SChatWidget::Construct(const FArguments& InArgs, const FLocalPlayerContext& InContext)
 {
 	ShooterHUDPCTrackerBase::Init(InContext);
@@ -80,6 +86,11 @@ void SChatWidget::Construct(const FArguments& InArgs, const FLocalPlayerContext&
 	SetEntryVisibility( LastVisibility );	
 }
 
+SChatWidget::~SChatWidget()
+{
+	DEC_DWORD_STAT_BY(STAT_Chat_Lines, ChatHistory.Num());
+}
+
 
 FSlateColor SChatWidget::GetBorderColor() const
 {
@@ -113,13 +124,34 @@ FSlateColor SChatWidget::GetStyleColor( const FLinearColor& InColor ) const
 
 void SChatWidget::AddChatLine(const FText& ChatString, bool SetFocus)
 {
-	ChatHistory.Add(MakeShareable(new FChatLine(ChatString)));
+	INC_DWORD_STAT(STAT_Chat_Added);
+
+	TSharedPtr<FChatLine> ChatLine;
+	if (ChatHistory.Num() >= MaxChatLines)
+	{
+		// reuse the oldest line, and its row if the list view still has one
+		ChatLine = ChatHistory[0];
+		ChatHistory.RemoveAt(0, 1, false);
+		ChatLine->ChatString = ChatString;
+
+		TSharedPtr<STextBlock> TextBlock = ChatLine->TextBlock.Pin();
+		if (TextBlock.IsValid())
+		{
+			TextBlock->SetText(ChatString);
+		}
+		INC_DWORD_STAT(STAT_Chat_Reused);
+	}
+	else
+	{
+		ChatLine = MakeShareable(new FChatLine(ChatString));
+		INC_DWORD_STAT(STAT_Chat_Lines);
+	}
+	ChatHistory.Add(ChatLine);
 
+	// the list view only refreshes when lines change
 	if(ChatHistoryListView.IsValid())
 	{
-		FChatLine* LastLine  = ChatHistory[ChatHistory.Num() - 1].Get();
-		UE_LOG(LogOnline, Warning, TEXT("request scroll last=%s"), *LastLine->ChatString.ToString());
-		ChatHistoryListView->RequestScrollIntoView(ChatHistory[ChatHistory.Num() - 1]);
+		ChatHistoryListView->RequestScrollIntoView(ChatLine);
 	}
 	
 	FSlateApplication::Get().PlaySound(ChatStyle->RxMessgeSound);
@@ -228,14 +260,19 @@ FReply SChatWidget::OnFocusReceived( const FGeometry& MyGeometry, const FFocusEv
 
 TSharedRef<ITableRow> SChatWidget::GenerateChatRow(TSharedPtr<FChatLine> ChatLine, const TSharedRef<STableViewBase>& OwnerTable)
 {
+	INC_DWORD_STAT(STAT_Chat_RowsGenerated);
+
+	TSharedRef<STextBlock> TextBlock = SNew(STextBlock)
+		.Text(ChatLine->ChatString)
+		.Font(ChatFont)
+		.ColorAndOpacity(this, &SChatWidget::GetChatLineColor)
+		.WrapTextAt(CHAT_BOX_WIDTH - CHAT_BOX_PADDING);
+	ChatLine->TextBlock = TextBlock;
+
 	return
 		SNew(STableRow< TSharedPtr< FChatLine> >, OwnerTable )
 		[
-			SNew(STextBlock)
-			.Text(ChatLine->ChatString)
-			.Font(ChatFont)
-			.ColorAndOpacity(this, &SChatWidget::GetChatLineColor)
-			.WrapTextAt(CHAT_BOX_WIDTH - CHAT_BOX_PADDING)
+			TextBlock
 		];
 }
 
@@ -29,6 +29,8 @@ public:
 	/** Needed for every widget */
 	void Construct(const FArguments& InArgs, const FLocalPlayerContext& InContext);
 
+	~SChatWidget();
+
 	/** Gets the visibility of the entry widget. */
 	EVisibility GetEntryVisibility() const;
 
@@ -40,7 +42,7 @@ public:
 	void SetEntryVisibility( TAttribute<EVisibility> InVisibility );
 
 	/** 
-	 * Add a new chat line.
+	 * Add a new chat line. Beyond MaxChatLines the oldest line is reused for it.
 	 *
 	 * @param	ChatString		String to add.
 	 * @param	SetFocus		Should the window be given focus
@@ -57,6 +59,9 @@ protected:
 		// Source string of this chat message.
 		FText ChatString;
 
+		// Text block of the row the list view generated for this line, if it has one.
+		TWeakPtr<STextBlock> TextBlock;
+
 		FChatLine(const FText& InChatString)
 			: ChatString(InChatString)
 		{
@@ -112,7 +117,10 @@ protected:
 	/** The chat history list view. */
 	TSharedPtr< SListView< TSharedPtr< FChatLine> > > ChatHistoryListView;
 
-	/** The array of chat history. */
+	/** Most chat lines kept in ChatHistory. */
+	static const int32 MaxChatLines = 64;
+
+	/** The array of chat history, oldest first. */
 	TArray< TSharedPtr< FChatLine> > ChatHistory;
 
 	/** Should this chatbox be kept visible. */
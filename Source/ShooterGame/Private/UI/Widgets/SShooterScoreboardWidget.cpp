@@ -18,6 +18,14 @@
 
 #define	NORM_PADDING	(FMargin(5))
 
+SShooterScoreboardWidget::~SShooterScoreboardWidget()
+{
+	if (AShooterGameState* const MyGameState = GameState.Get())
+	{
+		MyGameState->OnPlayerStatsChange.Remove(PlayerStatsChangeHandle);
+	}
+}
+
 void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 {
 	ScoreboardStyle = &FShooterStyle::Get().GetWidgetStyle<FShooterScoreboardStyle>("DefaultShooterScoreboardStyle");
@@ -25,13 +33,18 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 	PCOwner = InArgs._PCOwner;
 	ScoreboardTint = FLinearColor(0.0f,0.0f,0.0f,0.4f);
 	ScoreBoxWidth = 140.0f;
+	PlayerRowHeight = 36.0f;
+	MaxVisibleRows = 16;
 	ScoreCountUpTime = 2.0f;
 
 	ScoreboardStartTime = FPlatformTime::Seconds();
 	MatchState = InArgs._MatchState.Get();
 
-	UpdatePlayerStateMaps();
-	
+	PlayerRowStyle = FCoreStyle::Get().GetWidgetStyle<FTableRowStyle>("TableView.Row");
+	PlayerRowStyle
+		.SetEvenRowBackgroundHoveredBrush(PlayerRowStyle.EvenRowBackgroundBrush)
+		.SetOddRowBackgroundHoveredBrush(PlayerRowStyle.OddRowBackgroundBrush);
+
 	Columns.Add(FColumnData(LOCTEXT("KillsColumn", "Kills"),
 		ScoreboardStyle->KillStatColor,
 		FOnGetPlayerStateAttribute::CreateSP(this, &SShooterScoreboardWidget::GetAttributeValue_Kills)));
@@ -44,6 +57,17 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 		ScoreboardStyle->ScoreStatColor,
 		FOnGetPlayerStateAttribute::CreateSP(this, &SShooterScoreboardWidget::GetAttributeValue_Score)));
 
+	// the rows only change when the game state reports a change, nothing is polled while the scoreboard is shown
+	if (PCOwner.IsValid())
+	{
+		GameState = PCOwner->GetWorld()->GetGameState<AShooterGameState>();
+		if (GameState.IsValid())
+		{
+			PlayerStatsChangeHandle = GameState->OnPlayerStatsChange.AddSP(this, &SShooterScoreboardWidget::OnPlayerStatsChange);
+		}
+	}
+	SyncAllTeams();
+
 	TSharedPtr<SHorizontalBox> HeaderCols;
 
 	const TSharedRef<SVerticalBox> ScoreboardGrid = SNew(SVerticalBox)
@@ -151,12 +175,12 @@ FText SShooterScoreboardWidget::GetMatchRestartText() const
 {
 	if (PCOwner.IsValid() && (PCOwner->GetWorld() != NULL ))
 	{
-		AShooterGameState* const GameState = PCOwner->GetWorld()->GetGameState<AShooterGameState>();
-		if (GameState)
+		AShooterGameState* const MyGameState = PCOwner->GetWorld()->GetGameState<AShooterGameState>();
+		if (MyGameState)
 		{
-			if (GameState->RemainingTime > 0)
+			if (MyGameState->RemainingTime > 0)
 			{
-				return FText::Format(LOCTEXT("MatchRestartTimeString", "New match begins in: {0}"), FText::AsNumber(GameState->RemainingTime));
+				return FText::Format(LOCTEXT("MatchRestartTimeString", "New match begins in: {0}"), FText::AsNumber(MyGameState->RemainingTime));
 			}
 			else
 			{
@@ -187,7 +211,7 @@ FText SShooterScoreboardWidget::GetMatchOutcomeText() const
 void SShooterScoreboardWidget::UpdateScoreboardGrid()
 {
 	ScoreboardData->ClearChildren();
-	for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
+	for (uint8 TeamNum = 0; TeamNum < Teams.Num(); TeamNum++)
 	{
 		//Player rows from each team
 		ScoreboardData->AddSlot() .AutoHeight()
@@ -195,7 +219,7 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 				MakePlayerRows(TeamNum)
 			];
 		//If we have more than one team, we are playing team based game mode, add totals
-		if (PlayerStateMaps.Num() > 1 && PlayerStateMaps[TeamNum].Num() > 0)
+		if (Teams.Num() > 1)
 		{
 			// Horizontal Ruler
 			ScoreboardData->AddSlot() .AutoHeight() .Padding(NORM_PADDING)
@@ -203,6 +227,7 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 					SNew(SBorder)
 					.Padding(1)
 					.BorderImage(&ScoreboardStyle->ItemBorderBrush)
+					.Visibility(this, &SShooterScoreboardWidget::GetTeamTotalsVisibility, TeamNum)
 				];
 			ScoreboardData->AddSlot() .AutoHeight()
 				[
@@ -261,47 +286,183 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 	}
 }
 
-void SShooterScoreboardWidget::UpdatePlayerStateMaps()
+void SShooterScoreboardWidget::OnPlayerStatsChange(AShooterPlayerState* PlayerState)
 {
-	if (PCOwner.IsValid())
+	AShooterGameState* const MyGameState = GameState.Get();
+	if (MyGameState == nullptr || PlayerState == nullptr)
+	{
+		return;
+	}
+
+	if (FMath::Max(MyGameState->NumTeams, 1) != Teams.Num())
+	{
+		SyncAllTeams();
+		UpdateScoreboardGrid();
+		return;
+	}
+
+	UpdatePlayerRow(MyGameState, PlayerState);
+}
+
+void SShooterScoreboardWidget::UpdatePlayerRow(const AShooterGameState* MyGameState, AShooterPlayerState* PlayerState)
+{
+	const int32 Rank = MyGameState->GetPlayerRank(PlayerState);
+	const int32 TeamNum = PlayerState->GetTeamNum();
+	const bool bDisplayed = Rank != INDEX_NONE && Teams.IsValidIndex(TeamNum) && ShouldPlayerBeDisplayed(PlayerState);
+
+	const FScoreboardPlayerRowPtr Row = PlayerRows.FindRef(PlayerState);
+	if (!Row.IsValid())
 	{
-		AShooterGameState* const GameState = PCOwner->GetWorld()->GetGameState<AShooterGameState>();
-		if (GameState)
+		if (bDisplayed)
 		{
-			bool bRequiresWidgetUpdate = false;
-			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
-			LastTeamPlayerCount.Reset();
-			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
-			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
-			{
-				LastTeamPlayerCount[i] = PlayerStateMaps[i].Num();
-			}
+			SyncTeamRows(TeamNum);
+		}
+		return;
+	}
 
-			PlayerStateMaps.Reset();
-			PlayerStateMaps.AddZeroed(NumTeams);
-		
-			for (int32 i = 0; i < NumTeams; i++)
-			{
-				GameState->GetRankedMap(i, PlayerStateMaps[i]);
+	if (!bDisplayed || Row->TeamNum != TeamNum || Row->Rank != Rank)
+	{
+		// ranks of the players it passed changed as well
+		const uint8 OldTeamNum = Row->TeamNum;
+		SyncTeamRows(OldTeamNum);
+		if (bDisplayed && TeamNum != OldTeamNum)
+		{
+			SyncTeamRows(TeamNum);
+		}
+		return;
+	}
 
-				if (LastTeamPlayerCount.Num() > 0 && PlayerStateMaps[i].Num() != LastTeamPlayerCount[i])
-				{
-					bRequiresWidgetUpdate = true;
-				}
-			}
-			if (bRequiresWidgetUpdate)
+	// same place, only the texts of the row change
+	RefreshRowValues(*Row);
+	UpdateTeamTotal(TeamNum);
+}
+
+void SShooterScoreboardWidget::RefreshRowValues(FScoreboardPlayerRow& Row) const
+{
+	AShooterPlayerState* const PlayerState = Row.PlayerState.Get();
+	if (PlayerState == nullptr)
+	{
+		return;
+	}
+
+	const FString PlayerName = PlayerState->GetShortPlayerName();
+	if (!Row.PlayerName.ToString().Equals(PlayerName, ESearchCase::CaseSensitive))
+	{
+		Row.PlayerName = FText::FromString(PlayerName);
+	}
+
+	for (int32 ColIdx = 0; ColIdx < Columns.Num(); ColIdx++)
+	{
+		const int32 Value = Columns[ColIdx].AttributeGetter.Execute(PlayerState);
+		if (Value != Row.Values[ColIdx] || Row.ValueTexts[ColIdx].IsEmpty())
+		{
+			Row.Values[ColIdx] = Value;
+			Row.ValueTexts[ColIdx] = FText::AsNumber(Value);
+		}
+	}
+}
+
+void SShooterScoreboardWidget::SyncTeamRows(uint8 TeamNum)
+{
+	AShooterGameState* const MyGameState = GameState.Get();
+	if (MyGameState == nullptr || !Teams.IsValidIndex(TeamNum))
+	{
+		return;
+	}
+
+	FScoreboardTeam& Team = Teams[TeamNum];
+	const TArray<FScoreboardPlayerRowPtr> OldRows = Team.Rows;
+	for (const FScoreboardPlayerRowPtr& Row : OldRows)
+	{
+		Row->Rank = INDEX_NONE;
+	}
+
+	// the game state keeps the ranking, rows are only picked up in its order
+	Team.Rows.Reset();
+	const int32 NumPlayers = MyGameState->GetNumRankedPlayers(TeamNum);
+	for (int32 Rank = 0; Rank < NumPlayers; ++Rank)
+	{
+		AShooterPlayerState* const PlayerState = MyGameState->GetRankedPlayer(TeamNum, Rank);
+		if (!ShouldPlayerBeDisplayed(PlayerState))
+		{
+			continue;
+		}
+
+		FScoreboardPlayerRowPtr& Row = PlayerRows.FindOrAdd(PlayerState);
+		if (!Row.IsValid())
+		{
+			Row = MakeShareable(new FScoreboardPlayerRow());
+			Row->PlayerState = PlayerState;
+			Row->Values.SetNumZeroed(Columns.Num());
+			Row->ValueTexts.SetNum(Columns.Num());
+		}
+		else if (Row->TeamNum != TeamNum && Teams.IsValidIndex(Row->TeamNum) && Teams[Row->TeamNum].Rows.Remove(Row) > 0 && Teams[Row->TeamNum].ListView.IsValid())
+		{
+			// still listed by its previous team
+			Teams[Row->TeamNum].ListView->RequestListRefresh();
+		}
+
+		Row->TeamNum = TeamNum;
+		Row->Rank = Rank;
+		RefreshRowValues(*Row);
+		Team.Rows.Add(Row);
+	}
+
+	// forget players that left the team
+	for (const FScoreboardPlayerRowPtr& Row : OldRows)
+	{
+		if (Row->Rank == INDEX_NONE && PlayerRows.FindRef(Row->PlayerState) == Row)
+		{
+			PlayerRows.Remove(Row->PlayerState);
+		}
+	}
+
+	UpdateTeamTotal(TeamNum);
+
+	if (Team.ListView.IsValid() && Team.Rows != OldRows)
+	{
+		Team.ListBox->SetHeightOverride(FMath::Min(Team.Rows.Num(), MaxVisibleRows) * PlayerRowHeight);
+		Team.ListView->RequestListRefresh();
+
+		for (const FScoreboardPlayerRowPtr& Row : Team.Rows)
+		{
+			if (IsSelectedPlayer(Row))
 			{
-				UpdateScoreboardGrid();
+				Team.ListView->RequestScrollIntoView(Row);
+				break;
 			}
 		}
 	}
+}
+
+void SShooterScoreboardWidget::UpdateTeamTotal(uint8 TeamNum)
+{
+	FScoreboardTeam& Team = Teams[TeamNum];
+
+	int32 Total = 0;
+	for (const FScoreboardPlayerRowPtr& Row : Team.Rows)
+	{
+		Total += Row->Values.Last();
+	}
 
-	UpdateSelectedPlayer();
+	if (Total != Team.Total || Team.TotalText.IsEmpty())
+	{
+		Team.Total = Total;
+		Team.TotalText = FText::AsNumber(Total);
+	}
 }
 
-void SShooterScoreboardWidget::Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime )
+void SShooterScoreboardWidget::SyncAllTeams()
 {
-	UpdatePlayerStateMaps();
+	PlayerRows.Reset();
+	Teams.Reset();
+
+	AShooterGameState* const MyGameState = GameState.Get();
+	Teams.AddDefaulted(MyGameState ? FMath::Max(MyGameState->NumTeams, 1) : 0);
+	for (uint8 TeamNum = 0; TeamNum < Teams.Num(); TeamNum++)
+	{
+		SyncTeamRows(TeamNum);
+	}
 }
 
 bool SShooterScoreboardWidget::SupportsKeyboardFocus() const
@@ -369,12 +530,12 @@ void SShooterScoreboardWidget::PlaySound(const FSlateSound& SoundToPlay) const
 	}
 }
 
-FReply SShooterScoreboardWidget::OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, const FTeamPlayer TeamPlayer)
+FReply SShooterScoreboardWidget::OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, FScoreboardPlayerRowPtr Row)
 {
 #if INTERACTIVE_SCOREBOARD
-	if( !(SelectedPlayer == TeamPlayer) )
+	if( !IsSelectedPlayer(Row) )
 	{
-		SelectedPlayer = TeamPlayer;
+		SelectedPlayer = Row->PlayerState;
 		PlaySound(ScoreboardStyle->PlayerChangeSound);
 	}
 #endif
@@ -383,49 +544,15 @@ FReply SShooterScoreboardWidget::OnMouseOverPlayer(const FGeometry& Geometry, co
 
 void SShooterScoreboardWidget::OnSelectedPlayerPrev()
 {
-	// Make sure we have a valid index to start with
-	if( !SelectedPlayer.IsValid() && !SetSelectedPlayerUs())
-	{
-		return;
-	}
-
-	// We don't want to decrease the player Id, we want to find the current one in the list and then select the one before it
-	int32 PrevPlayerId = -1;
-	for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[SelectedPlayer.TeamNum]); PlayerIt; ++PlayerIt)	// This would be easier with a .ReverseIterator call
-	{
-		const int32 PlayerId = PlayerIt.Key();
-		if( PlayerId == SelectedPlayer.PlayerId )
-		{
-			break;
-		}
-		PrevPlayerId = PlayerId;
-	}
-
-	if( PrevPlayerId == -1 )
-	{
-		// If the id is still invalid, that means the current selection was first in their team, try the previous team...
-		SelectedPlayer.TeamNum--;
-		if (!PlayerStateMaps.IsValidIndex(SelectedPlayer.TeamNum))
-		{
-			// If there isn't a previous team, move to the last team
-			SelectedPlayer.TeamNum = PlayerStateMaps.Num() - 1;
-			check(PlayerStateMaps.IsValidIndex(SelectedPlayer.TeamNum));
-		}
-
-		// We want the last player in the team
-		for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[SelectedPlayer.TeamNum]); PlayerIt; ++PlayerIt)	// This would be easier with a .Last call
-		{
-			const int32 PlayerId = PlayerIt.Key();
-			PrevPlayerId = PlayerId;
-		}
-	}
-
-	check( SelectedPlayer.PlayerId != -1 );
-	SelectedPlayer.PlayerId = PrevPlayerId;
-	PlaySound(ScoreboardStyle->PlayerChangeSound);
+	MoveSelectedPlayer(-1);
 }
 
 void SShooterScoreboardWidget::OnSelectedPlayerNext()
+{
+	MoveSelectedPlayer(1);
+}
+
+void SShooterScoreboardWidget::MoveSelectedPlayer(int32 Offset)
 {
 	// Make sure we have a valid index to start with
 	if( !SelectedPlayer.IsValid() && !SetSelectedPlayerUs())
@@ -433,58 +560,35 @@ void SShooterScoreboardWidget::OnSelectedPlayerNext()
 		return;
 	}
 
-	// We don't want to increase the player Id, we want to find the current one in the list and then select the one after
-	bool bNext = false;
-	for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[SelectedPlayer.TeamNum]); PlayerIt; ++PlayerIt)
+	// players of all teams in display order, previous of the first is the last one of the last team
+	TArray<FScoreboardPlayerRowPtr> AllRows;
+	int32 SelectedIndex = INDEX_NONE;
+	for (const FScoreboardTeam& Team : Teams)
 	{
-		const int32 PlayerId = PlayerIt.Key();
-		if( PlayerId == SelectedPlayer.PlayerId )
-		{
-			bNext = true;
-		}
-		else if( bNext == true )
+		for (const FScoreboardPlayerRowPtr& Row : Team.Rows)
 		{
-			SelectedPlayer.PlayerId = PlayerId;
-			PlaySound(ScoreboardStyle->PlayerChangeSound);
-
-			bNext = false;
-			break;
+			if (Row->PlayerState == SelectedPlayer)
+			{
+				SelectedIndex = AllRows.Num();
+			}
+			AllRows.Add(Row);
 		}
 	}
 
-	if( bNext == true )
+	if (SelectedIndex == INDEX_NONE)
 	{
-		// If next is still true, our current selection was last in their team, try the next team...
-		SelectedPlayer.TeamNum++;
-		if (!PlayerStateMaps.IsValidIndex(SelectedPlayer.TeamNum))
-		{
-			// If there isn't a next team, move to the first team
-			SelectedPlayer.TeamNum = 0;
-			check(PlayerStateMaps.IsValidIndex(SelectedPlayer.TeamNum));
-		}
-
-		SelectedPlayer.PlayerId = 0;
-		PlaySound(ScoreboardStyle->PlayerChangeSound);
+		return;
 	}
+
+	const FScoreboardPlayerRowPtr& NewRow = AllRows[(SelectedIndex + Offset + AllRows.Num()) % AllRows.Num()];
+	SelectedPlayer = NewRow->PlayerState;
+	Teams[NewRow->TeamNum].ListView->RequestScrollIntoView(NewRow);
+	PlaySound(ScoreboardStyle->PlayerChangeSound);
 }
 
 void SShooterScoreboardWidget::ResetSelectedPlayer()
 {
-	SelectedPlayer = FTeamPlayer();
-}
-
-void SShooterScoreboardWidget::UpdateSelectedPlayer()
-{
-	// Make sure the selected player is still valid...
-	if( SelectedPlayer.IsValid() )
-	{
-		const AShooterPlayerState* PlayerState = GetSortedPlayerState(SelectedPlayer);
-		if( !PlayerState )
-		{
-			// Player is no longer valid, reset (note: reset implies 'us' in IsSelectedPlayer and IsPlayerSelectedAndValid)
-			ResetSelectedPlayer();
-		}
-	}
+	SelectedPlayer = nullptr;
 }
 
 bool SShooterScoreboardWidget::SetSelectedPlayerUs()
@@ -494,37 +598,24 @@ bool SShooterScoreboardWidget::SetSelectedPlayerUs()
 	// Set the owner player to be the default focused one
 	if( APlayerController* const PC = PCOwner.Get() )
 	{
-		for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
+		AShooterPlayerState* const PlayerState = Cast<AShooterPlayerState>(PC->PlayerState);
+		if( PlayerState && PlayerRows.Contains(PlayerState) )
 		{
-			for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[TeamNum]); PlayerIt; ++PlayerIt)
-			{
-				const TWeakObjectPtr<AShooterPlayerState> PlayerState = PlayerIt.Value();
-				if( PlayerState.IsValid() && PC->PlayerState && PC->PlayerState == PlayerState.Get() )
-				{
-					SelectedPlayer = FTeamPlayer(TeamNum, PlayerIt.Key());
-					return true;
-				}
-			}
+			SelectedPlayer = PlayerState;
+			return true;
 		}
 	}
 	return false;
 }
 
-bool SShooterScoreboardWidget::IsSelectedPlayer(const FTeamPlayer& TeamPlayer) const
+bool SShooterScoreboardWidget::IsSelectedPlayer(const FScoreboardPlayerRowPtr& Row) const
 {
 	if( !SelectedPlayer.IsValid() )
 	{
 		// If not explicitly set, test to see if the owner player was passed.
-		if( IsOwnerPlayer(TeamPlayer) )
-		{
-			return true;
-		}
-	}
-	else if( SelectedPlayer == TeamPlayer )
-	{
-		return true;
+		return IsOwnerPlayer(Row);
 	}
-	return false;
+	return SelectedPlayer == Row->PlayerState;
 }
 
 bool SShooterScoreboardWidget::IsPlayerSelectedAndValid() const
@@ -539,9 +630,9 @@ bool SShooterScoreboardWidget::IsPlayerSelectedAndValid() const
 			return OwnerNetId.IsValid();
 		}
 	}
-	else if( const AShooterPlayerState* PlayerState = GetSortedPlayerState(SelectedPlayer) ) 
+	else
 	{
-		const TSharedPtr<const FUniqueNetId>& PlayerId = PlayerState->UniqueId.GetUniqueNetId();
+		const TSharedPtr<const FUniqueNetId>& PlayerId = SelectedPlayer->UniqueId.GetUniqueNetId();
 		return PlayerId.IsValid();
 	}
 #endif
@@ -561,21 +652,16 @@ bool SShooterScoreboardWidget::ProfileUIOpened() const
 		const TSharedPtr<const FUniqueNetId>& OwnerNetId = PCOwner->PlayerState->UniqueId.GetUniqueNetId();
 		check( OwnerNetId.IsValid() );
 
-		const TSharedPtr<const FUniqueNetId>& PlayerId = ( !SelectedPlayer.IsValid() ? OwnerNetId : GetSortedPlayerState(SelectedPlayer)->UniqueId.GetUniqueNetId() );
+		const TSharedPtr<const FUniqueNetId>& PlayerId = ( !SelectedPlayer.IsValid() ? OwnerNetId : SelectedPlayer->UniqueId.GetUniqueNetId() );
 		check( PlayerId.IsValid() );
 		return ShooterUIHelpers::Get().ProfileOpenedUI(*OwnerNetId.Get(), *PlayerId.Get(), NULL);
 	}
 	return false;
 }
 
-EVisibility SShooterScoreboardWidget::PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const
-{
-	return GetSortedPlayerState(TeamPlayer) ? EVisibility::Visible : EVisibility::Collapsed;
-}
-
-EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const
+EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(FScoreboardPlayerRowPtr Row) const
 {
-	AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
+	const AShooterPlayerState* PlayerState = Row->PlayerState.Get();
 	if (PlayerState)
 	{
 		for (int32 i = 0; i < PlayersTalkingThisFrame.Num(); ++i)
@@ -589,39 +675,31 @@ EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(const FTeamPlayer Te
 	return EVisibility::Hidden;
 }
 
-FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const
+FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(FScoreboardPlayerRowPtr Row) const
 {
-	const bool bIsSelected = IsSelectedPlayer(TeamPlayer);
+	const bool bIsSelected = IsSelectedPlayer(Row);
 	const int32 RedTeam = 0;
 	const float BaseValue = bIsSelected == true ? 0.15f : 0.0f;
 	const float AlphaValue = bIsSelected == true ? 1.0f : 0.3f;
-	float RedValue = TeamPlayer.TeamNum == RedTeam ? 0.25f : 0.0f;
-	float BlueValue = TeamPlayer.TeamNum != RedTeam ? 0.25f : 0.0f;
+	float RedValue = Row->TeamNum == RedTeam ? 0.25f : 0.0f;
+	float BlueValue = Row->TeamNum != RedTeam ? 0.25f : 0.0f;
 	return FLinearColor(BaseValue + RedValue, BaseValue, BaseValue + BlueValue, AlphaValue);
 }
 
-FText SShooterScoreboardWidget::GetPlayerName(const FTeamPlayer TeamPlayer) const
+FText SShooterScoreboardWidget::GetPlayerName(FScoreboardPlayerRowPtr Row) const
 {
-	const AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	if (PlayerState)
-	{
-		return FText::FromString(PlayerState->GetShortPlayerName());
-	}
-
-	return FText::GetEmpty();
+	return Row->PlayerName;
 }
 
-bool SShooterScoreboardWidget::ShouldPlayerBeDisplayed(const FTeamPlayer TeamPlayer) const
+bool SShooterScoreboardWidget::ShouldPlayerBeDisplayed(const AShooterPlayerState* PlayerState) const
 {
-	const AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	
 	return PlayerState != nullptr && !PlayerState->bOnlySpectator;
 }
 
-FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlayer) const
+FSlateColor SShooterScoreboardWidget::GetPlayerColor(FScoreboardPlayerRowPtr Row) const
 {
 	// If this is the owner players row, tint the text color to show ourselves more clearly
-	if( IsOwnerPlayer(TeamPlayer) )
+	if( IsOwnerPlayer(Row) )
 	{
 		return FSlateColor(FLinearColor::Yellow);
 	}
@@ -630,10 +708,10 @@ FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlaye
 	return TextStyle.ColorAndOpacity;
 }
 
-FSlateColor SShooterScoreboardWidget::GetColumnColor(const FTeamPlayer TeamPlayer, uint8 ColIdx) const
+FSlateColor SShooterScoreboardWidget::GetColumnColor(FScoreboardPlayerRowPtr Row, uint8 ColIdx) const
 {
 	// If this is the owner players row, tint the text color to show ourselves more clearly
-	if( IsOwnerPlayer(TeamPlayer) )
+	if( IsOwnerPlayer(Row) )
 	{
 		return FSlateColor(FLinearColor::Yellow);
 	}
@@ -642,35 +720,34 @@ FSlateColor SShooterScoreboardWidget::GetColumnColor(const FTeamPlayer TeamPlaye
 	return Columns[ColIdx].Color;
 }
 
-bool SShooterScoreboardWidget::IsOwnerPlayer(const FTeamPlayer& TeamPlayer) const
+bool SShooterScoreboardWidget::IsOwnerPlayer(const FScoreboardPlayerRowPtr& Row) const
 {
-	return ( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == GetSortedPlayerState(TeamPlayer) );
+	return ( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == Row->PlayerState.Get() );
 }
 
-FText SShooterScoreboardWidget::GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const
+FText SShooterScoreboardWidget::GetStat(FScoreboardPlayerRowPtr Row, uint8 ColIdx) const
 {
-	int32 StatTotal = 0;
-	if (TeamPlayer.PlayerId != SpecialPlayerIndex::All)
+	// count up at the end of the match, the cached text otherwise
+	if (MatchState > EShooterMatchState::Playing && FPlatformTime::Seconds() - ScoreboardStartTime < ScoreCountUpTime)
 	{
-		AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-		if (PlayerState)
-		{
-			StatTotal = Getter.Execute(PlayerState);
-		}
-	} 
-	else
+		return FText::AsNumber(LerpForCountup(Row->Values[ColIdx]));
+	}
+	return Row->ValueTexts[ColIdx];
+}
+
+FText SShooterScoreboardWidget::GetTeamTotal(uint8 TeamNum) const
+{
+	const FScoreboardTeam& Team = Teams[TeamNum];
+	if (MatchState > EShooterMatchState::Playing && FPlatformTime::Seconds() - ScoreboardStartTime < ScoreCountUpTime)
 	{
-		for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[TeamPlayer.TeamNum]); PlayerIt; ++PlayerIt)
-		{
-			AShooterPlayerState* PlayerState = PlayerIt.Value().Get();
-			if (PlayerState)
-			{
-				StatTotal += Getter.Execute(PlayerState);
-			}
-		}
+		return FText::AsNumber(LerpForCountup(Team.Total));
 	}
+	return Team.TotalText;
+}
 
-	return FText::AsNumber(LerpForCountup(StatTotal));
+EVisibility SShooterScoreboardWidget::GetTeamTotalsVisibility(uint8 TeamNum) const
+{
+	return Teams[TeamNum].Rows.Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
 int32 SShooterScoreboardWidget::LerpForCountup(int32 ScoreValue) const
@@ -691,6 +768,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 	TSharedPtr<SHorizontalBox> TotalsRow;
 
 	SAssignNew(TotalsRow, SHorizontalBox)
+	.Visibility(this, &SShooterScoreboardWidget::GetTeamTotalsVisibility, TeamNum)
 	+SHorizontalBox::Slot() .Padding(NORM_PADDING)
 	[
 		SNew(SBorder)
@@ -739,7 +817,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 			.HAlign(HAlign_Center)
 			[
 				SNew(STextBlock)
-				.Text(this, &SShooterScoreboardWidget::GetStat, Columns.Last().AttributeGetter, FTeamPlayer(TeamNum, SpecialPlayerIndex::All))
+				.Text(this, &SShooterScoreboardWidget::GetTeamTotal, TeamNum)
 				.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.HeaderTextStyle")
 			]
 		]
@@ -748,27 +826,34 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 	return TotalsRow.ToSharedRef();
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRows(uint8 TeamNum) const
+TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRows(uint8 TeamNum)
 {
-	TSharedRef<SVerticalBox> PlayerRows = SNew(SVerticalBox);
+	FScoreboardTeam& Team = Teams[TeamNum];
 
-	for (int32 PlayerIndex=0; PlayerIndex < PlayerStateMaps[TeamNum].Num(); PlayerIndex++ )
-	{
-		FTeamPlayer TeamPlayer(TeamNum, PlayerIndex);
+	// only the rows in view are generated, and regenerated when the order of the team changes
+	SAssignNew(Team.ListBox, SBox)
+	.HeightOverride(FMath::Min(Team.Rows.Num(), MaxVisibleRows) * PlayerRowHeight)
+	[
+		SAssignNew(Team.ListView, SListView<FScoreboardPlayerRowPtr>)
+		.ItemHeight(PlayerRowHeight)
+		.SelectionMode(ESelectionMode::None)
+		.ListItemsSource(&Team.Rows)
+		.OnGenerateRow(this, &SShooterScoreboardWidget::MakePlayerRow)
+	];
 
-		if (ShouldPlayerBeDisplayed(TeamPlayer))
+	for (const FScoreboardPlayerRowPtr& Row : Team.Rows)
+	{
+		if (IsSelectedPlayer(Row))
 		{
-			PlayerRows->AddSlot().AutoHeight()
-				[
-					MakePlayerRow(TeamPlayer)
-				];
+			Team.ListView->RequestScrollIntoView(Row);
+			break;
 		}
 	}
 
-	return PlayerRows;
+	return Team.ListBox.ToSharedRef();
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& TeamPlayer) const
+TSharedRef<ITableRow> SShooterScoreboardWidget::MakePlayerRow(FScoreboardPlayerRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable) const
 {
 	// Make the padding here slightly smaller than NORM_PADDING, to fit in more players
 	const FMargin Pad = FMargin(5,1);
@@ -780,7 +865,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 	[
 		SNew(SImage)
 		.Image(FShooterStyle::Get().GetBrush("ShooterGame.Speaker"))
-		.Visibility(this, &SShooterScoreboardWidget::SpeakerIconVisibility, TeamPlayer)
+		.Visibility(this, &SShooterScoreboardWidget::SpeakerIconVisibility, Row)
 	];
 
 	//first autosized row with player name
@@ -790,15 +875,14 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 		.Padding(Pad)
 		.HAlign(HAlign_Right)
 		.VAlign(VAlign_Center)
-		.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-		.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-		.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
+		.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, Row)
+		.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, Row)
 		.BorderImage(&ScoreboardStyle->ItemBorderBrush)
 		[
 			SNew(STextBlock)
-			.Text(this, &SShooterScoreboardWidget::GetPlayerName, TeamPlayer)
+			.Text(this, &SShooterScoreboardWidget::GetPlayerName, Row)
 			.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-			.ColorAndOpacity(this, &SShooterScoreboardWidget::GetPlayerColor, TeamPlayer)
+			.ColorAndOpacity(this, &SShooterScoreboardWidget::GetPlayerColor, Row)
 		]
 	];
 	//attributes rows (kills, deaths, score/captures)
@@ -811,9 +895,8 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 			.Padding(Pad)
 			.VAlign(VAlign_Center)
 			.HAlign(HAlign_Center)
-			.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-			.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-			.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
+			.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, Row)
+			.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, Row)
 			.BorderImage(&ScoreboardStyle->ItemBorderBrush)
 			[
 				SNew(SBox)
@@ -821,24 +904,19 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 				.HAlign(HAlign_Center)
 				[
 					SNew(STextBlock)
-					.Text(this, &SShooterScoreboardWidget::GetStat, Columns[ColIdx].AttributeGetter, TeamPlayer)
+					.Text(this, &SShooterScoreboardWidget::GetStat, Row, ColIdx)
 					.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-					.ColorAndOpacity(this, &SShooterScoreboardWidget::GetColumnColor, TeamPlayer, ColIdx)
+					.ColorAndOpacity(this, &SShooterScoreboardWidget::GetColumnColor, Row, ColIdx)
 				]
 			]
 		];
 	}
-	return PlayerRow.ToSharedRef();
-}
-
-AShooterPlayerState* SShooterScoreboardWidget::GetSortedPlayerState(const FTeamPlayer& TeamPlayer) const
-{
-	if (PlayerStateMaps.IsValidIndex(TeamPlayer.TeamNum) && PlayerStateMaps[TeamPlayer.TeamNum].Contains(TeamPlayer.PlayerId))
-	{
-		return PlayerStateMaps[TeamPlayer.TeamNum].FindRef(TeamPlayer.PlayerId).Get();
-	}
-	
-	return NULL;
+	return SNew(STableRow<FScoreboardPlayerRowPtr>, OwnerTable)
+		.Style(&PlayerRowStyle)
+		.ShowSelection(false)
+		[
+			PlayerRow.ToSharedRef()
+		];
 }
 
 int32 SShooterScoreboardWidget::GetAttributeValue_Kills(AShooterPlayerState* PlayerState) const
@@ -7,11 +7,6 @@
 
 DECLARE_DELEGATE_RetVal_OneParam(int32, FOnGetPlayerStateAttribute, AShooterPlayerState*);
 
-namespace SpecialPlayerIndex
-{
-	const int32 All = -1;
-}
-
 struct FColumnData
 {
 	/** Column name */
@@ -37,41 +32,62 @@ struct FColumnData
 	}
 };
 
-struct FTeamPlayer
+/** scoreboard line of a player, refreshed when the game state reports a change of that player */
+struct FScoreboardPlayerRow
 {
-	/** The team the player belongs to */
+	/** the player */
+	TWeakObjectPtr<AShooterPlayerState> PlayerState;
+
+	/** team the row is listed in */
 	uint8 TeamNum;
-		
-	/** The number within that team */
-	int32 PlayerId;
+
+	/** position in the team ranking */
+	int32 Rank;
+
+	/** cached short player name */
+	FText PlayerName;
+
+	/** cached stat of each column */
+	TArray<int32> Values;
+
+	/** cached text of each stat */
+	TArray<FText> ValueTexts;
 
 	/** defaults */
-	FTeamPlayer()
+	FScoreboardPlayerRow()
 		: TeamNum(0)
-		, PlayerId(SpecialPlayerIndex::All)
+		, Rank(INDEX_NONE)
 	{
 	}
+};
 
-	FTeamPlayer(uint8 InTeamNum, int32 InPlayerId)
-		: TeamNum(InTeamNum)
-		, PlayerId(InPlayerId)
-	{
-	}
+typedef TSharedPtr<FScoreboardPlayerRow> FScoreboardPlayerRowPtr;
 
-	/** comparator */
-	bool operator==( const FTeamPlayer& Other ) const
-	{
-		return (TeamNum == Other.TeamNum && PlayerId == Other.PlayerId);
-	}
+/** displayed players of a team, in ranking order */
+struct FScoreboardTeam
+{
+	/** rows listed by the team view */
+	TArray<FScoreboardPlayerRowPtr> Rows;
+
+	/** virtualized view of Rows */
+	TSharedPtr<SListView<FScoreboardPlayerRowPtr>> ListView;
+
+	/** sized to the rows, up to MaxVisibleRows */
+	TSharedPtr<SBox> ListBox;
+
+	/** sum of the last column */
+	int32 Total;
 
-	/** check to see if we have valid player data */
-	bool IsValid() const
+	/** cached text of Total */
+	FText TotalText;
+
+	/** defaults */
+	FScoreboardTeam()
+		: Total(0)
 	{
-		return !(*this == FTeamPlayer());
 	}
 };
 
-
 //class declare
 class SShooterScoreboardWidget : public SBorder
 {
@@ -85,12 +101,12 @@ class SShooterScoreboardWidget : public SBorder
 
 	SLATE_END_ARGS()
 
+	/** stops listening to the game state */
+	~SShooterScoreboardWidget();
+
 	/** needed for every widget */
 	void Construct(const FArguments& InArgs);
 
-	/** update PlayerState maps with every tick when scoreboard is shown */
-	virtual void Tick( const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime ) override;
-
 	/** if we want to receive focus */
 	virtual bool SupportsKeyboardFocus() const override;
 
@@ -105,53 +121,65 @@ class SShooterScoreboardWidget : public SBorder
 
 protected:
 
-	/** updates widgets when players leave or join */
+	/** builds the team views, totals and match outcome */
 	void UpdateScoreboardGrid();
 
 	/** makes total row widget */
 	TSharedRef<SWidget> MakeTotalsRow(uint8 TeamNum) const;
 
-	/** makes player rows */
-	TSharedRef<SWidget> MakePlayerRows(uint8 TeamNum) const;
+	/** makes the list view of a team */
+	TSharedRef<SWidget> MakePlayerRows(uint8 TeamNum);
+
+	/** makes player row, called by the list view for rows scrolling into view */
+	TSharedRef<ITableRow> MakePlayerRow(FScoreboardPlayerRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable) const;
 
-	/** makes player row */
-	TSharedRef<SWidget> MakePlayerRow(const FTeamPlayer& TeamPlayer) const;
+	/** [game state event] a player joined, left, or its stats, name or team changed */
+	void OnPlayerStatsChange(AShooterPlayerState* PlayerState);
 
-	/** updates PlayerState maps to display accurate scores */
-	void UpdatePlayerStateMaps();
+	/** re-reads the row of the player, or the rows of its team if its place in the ranking changed */
+	void UpdatePlayerRow(const AShooterGameState* MyGameState, AShooterPlayerState* PlayerState);
 
-	/** gets ranked map for specific team */
-	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;
+	/** re-reads name and stats of the row, formatting only the texts of values that changed */
+	void RefreshRowValues(FScoreboardPlayerRow& Row) const;
 
-	/** gets PlayerState for specific team and player */
-	AShooterPlayerState* GetSortedPlayerState(const FTeamPlayer& TeamPlayer) const;
+	/** refills the rows of a team in ranking order, keeping the rows of players that are still in it */
+	void SyncTeamRows(uint8 TeamNum);
 
-	/** get player visibility */
-	EVisibility PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const;
+	/** sums the last column of a team */
+	void UpdateTeamTotal(uint8 TeamNum);
+
+	/** rebuilds every team from the game state */
+	void SyncAllTeams();
 
 	/** get speaker icon visibility */
-	EVisibility SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const;
+	EVisibility SpeakerIconVisibility(FScoreboardPlayerRowPtr Row) const;
 
 	/** get scoreboard border color */
-	FSlateColor GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const;
+	FSlateColor GetScoreboardBorderColor(FScoreboardPlayerRowPtr Row) const;
 
 	/** get player name */
-	FText GetPlayerName(const FTeamPlayer TeamPlayer) const;
+	FText GetPlayerName(FScoreboardPlayerRowPtr Row) const;
 
 	/** get whether or not the player should be displayed on the scoreboard */
-	bool ShouldPlayerBeDisplayed(const FTeamPlayer TeamPlayer) const;
+	bool ShouldPlayerBeDisplayed(const AShooterPlayerState* PlayerState) const;
 
 	/** get player color */
-	FSlateColor GetPlayerColor(const FTeamPlayer TeamPlayer) const;
+	FSlateColor GetPlayerColor(FScoreboardPlayerRowPtr Row) const;
 
 	/** get the column color */
-	FSlateColor GetColumnColor(const FTeamPlayer TeamPlayer, uint8 ColIdx) const;
+	FSlateColor GetColumnColor(FScoreboardPlayerRowPtr Row, uint8 ColIdx) const;
 
 	/** checks to see if the specified player is the owner */
-	bool IsOwnerPlayer(const FTeamPlayer& TeamPlayer) const;
+	bool IsOwnerPlayer(const FScoreboardPlayerRowPtr& Row) const;
+
+	/** get the stat of a column for a player */
+	FText GetStat(FScoreboardPlayerRowPtr Row, uint8 ColIdx) const;
 
-	/** get specific stat for team number and optionally player */
-	FText GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const;
+	/** get the team total */
+	FText GetTeamTotal(uint8 TeamNum) const;
+
+	/** totals are hidden for teams without players */
+	EVisibility GetTeamTotalsVisibility(uint8 TeamNum) const;
 
 	/** linear interpolated score for match outcome animation */
 	int32 LerpForCountup(int32 ScoreValue) const;
@@ -175,7 +203,7 @@ protected:
 	void PlaySound(const FSlateSound& SoundToPlay) const;
 
 	/** handle the mouse moving over scoreboard entry */
-	FReply OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, const FTeamPlayer TeamPlayer);
+	FReply OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, FScoreboardPlayerRowPtr Row);
 
 	/** called when the previous player wants to be selected */
 	void OnSelectedPlayerPrev();
@@ -183,17 +211,17 @@ protected:
 	/** called when the next player wants to be selected */
 	void OnSelectedPlayerNext();
 
+	/** moves the selection by Offset rows across teams, wrapping around */
+	void MoveSelectedPlayer(int32 Offset);
+
 	/** resets the selected player to be that of the local user */
 	void ResetSelectedPlayer();
 
-	/** makes sure the selected player is valid */
-	void UpdateSelectedPlayer();
-
 	/** sets the currently selected player to be ourselves */
 	bool SetSelectedPlayerUs();
 
 	/** checks to see if the specified player is the selected one */
-	bool IsSelectedPlayer(const FTeamPlayer& TeamPlayer) const;
+	bool IsSelectedPlayer(const FScoreboardPlayerRowPtr& Row) const;
 
 	/** is there a valid selected item */
 	bool IsPlayerSelectedAndValid() const;
@@ -210,20 +238,32 @@ protected:
 	/** width of scoreboard item */
 	int32 ScoreBoxWidth;
 
+	/** height of a player row */
+	float PlayerRowHeight;
+
+	/** rows a team shows before its view scrolls */
+	int32 MaxVisibleRows;
+
 	/** scoreboard count up time */
 	float ScoreCountUpTime;
 
 	/** when the scoreboard was brought up. */
 	double ScoreboardStartTime;
 
-	/** the player currently selected in the scoreboard */
-	FTeamPlayer SelectedPlayer;
+	/** the player currently selected in the scoreboard, nullptr for the owner */
+	TWeakObjectPtr<AShooterPlayerState> SelectedPlayer;
+
+	/** displayed players by team */
+	TArray<FScoreboardTeam> Teams;
 
-	/** the Ranked PlayerState map...cleared every frame */
-	TArray<RankedPlayerMap> PlayerStateMaps;
+	/** rows of the displayed players */
+	TMap<TWeakObjectPtr<AShooterPlayerState>, FScoreboardPlayerRowPtr> PlayerRows;
 
-	/** player count in each team in the last tick */
-	TArray<int32> LastTeamPlayerCount;
+	/** game state the scoreboard listens to */
+	TWeakObjectPtr<AShooterGameState> GameState;
+
+	/** OnPlayerStatsChange registration */
+	FDelegateHandle PlayerStatsChangeHandle;
 
 	/** holds talking player data */
 	TArray<TPair<TSharedRef<const FUniqueNetId>, bool>> PlayersTalkingThisFrame;
@@ -234,6 +274,9 @@ protected:
 	/** stat columns data */
 	TArray<FColumnData> Columns;
 
+	/** player rows without hover highlight */
+	FTableRowStyle PlayerRowStyle;
+
 	/** get state of current match */
 	EShooterMatchState::Type MatchState;
 
@@ -0,0 +1,210 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterExplosionBatcher.h"
+#include "Player/ShooterCharacter.h"
+#include "Player/ShooterCharacterMovement.h"
+
+DECLARE_STATS_GROUP(TEXT("ShooterExplosions"), STATGROUP_ShooterExplosions, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Flush"), STAT_Explosions_Flush, STATGROUP_ShooterExplosions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosions"), STAT_Explosions_Explosions, STATGROUP_ShooterExplosions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlap queries"), STAT_Explosions_Overlaps, STATGROUP_ShooterExplosions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Visibility traces"), STAT_Explosions_Traces, STATGROUP_ShooterExplosions);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damaged actors"), STAT_Explosions_Victims, STATGROUP_ShooterExplosions);
+
+static int32 ExplosionBatching = 1;
+FAutoConsoleVariableRef CVarExplosionBatching(
+	TEXT("p.ExplosionBatching"),
+	ExplosionBatching,
+	TEXT("1: projectile radial damage is resolved once per frame, with one overlap query per cluster of explosions. 0: resolved immediately."),
+	ECVF_Default);
+
+static float ExplosionClusterRadius = 2500.0f;
+FAutoConsoleVariableRef CVarExplosionClusterRadius(
+	TEXT("p.ExplosionClusterRadius"),
+	ExplosionClusterRadius,
+	TEXT("Largest radius of the sphere enclosing a cluster of explosions that share an overlap query."),
+	ECVF_Default);
+
+FShooterExplosionBatcher::FShooterExplosionBatcher(UWorld* InWorld)
+	: World(InWorld)
+	, bIsFlushing(false)
+{
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FShooterExplosionBatcher::OnWorldPostActorTick);
+}
+
+FShooterExplosionBatcher::~FShooterExplosionBatcher()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+}
+
+void FShooterExplosionBatcher::Queue(const FShooterExplosion& Explosion)
+{
+	Pending.Add(Explosion);
+
+	if (ExplosionBatching == 0 && !bIsFlushing)
+	{
+		Flush();
+	}
+}
+
+void FShooterExplosionBatcher::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == World.Get() && Pending.Num() > 0)
+	{
+		Flush();
+	}
+}
+
+int32 FShooterExplosionBatcher::Flush()
+{
+	SCOPE_CYCLE_COUNTER(STAT_Explosions_Flush);
+
+	UWorld* const MyWorld = World.Get();
+	if (MyWorld == nullptr)
+	{
+		Pending.Reset();
+		return 0;
+	}
+
+	// explosions queued by the damage below wait for the next flush
+	check(!bIsFlushing);
+	TGuardValue<bool> FlushGuard(bIsFlushing, true);
+
+	Swap(Pending, Processing);
+	INC_DWORD_STAT_BY(STAT_Explosions_Explosions, Processing.Num());
+
+	// group explosions whose spheres touch, as long as the cluster stays small enough for one query to be worth it
+	Clusters.Reset();
+	for (int32 ExplosionIdx = 0; ExplosionIdx < Processing.Num(); ++ExplosionIdx)
+	{
+		const FShooterExplosion& Explosion = Processing[ExplosionIdx];
+		const FSphere ExplosionBounds(Explosion.Origin, Explosion.OuterRadius);
+
+		FCluster* TargetCluster = nullptr;
+		for (FCluster& Cluster : Clusters)
+		{
+			if (Cluster.Channel == Explosion.DamagePreventionChannel && Cluster.Bounds.Intersects(ExplosionBounds))
+			{
+				FSphere MergedBounds = Cluster.Bounds;
+				MergedBounds += ExplosionBounds;
+				if (MergedBounds.W <= ExplosionClusterRadius)
+				{
+					Cluster.Bounds = MergedBounds;
+					TargetCluster = &Cluster;
+					break;
+				}
+			}
+		}
+
+		if (TargetCluster == nullptr)
+		{
+			TargetCluster = &Clusters[Clusters.AddDefaulted()];
+			TargetCluster->Bounds = ExplosionBounds;
+			TargetCluster->Channel = Explosion.DamagePreventionChannel;
+		}
+		TargetCluster->Explosions.Add(ExplosionIdx);
+	}
+
+	// gather everything first, so damage (and deaths) of this batch can't change what the other explosions see
+	Victims.Reset();
+	for (const FCluster& Cluster : Clusters)
+	{
+		Overlaps.Reset();
+		FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(ExplosionCluster), false);
+		MyWorld->OverlapMultiByChannel(Overlaps, Cluster.Bounds.Center, FQuat::Identity, Cluster.Channel, FCollisionShape::MakeSphere(Cluster.Bounds.W), SphereParams);
+		INC_DWORD_STAT(STAT_Explosions_Overlaps);
+
+		if (Overlaps.Num() > 0)
+		{
+			for (int32 ExplosionIdx : Cluster.Explosions)
+			{
+				GatherVictims(Processing[ExplosionIdx], ExplosionIdx);
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_Explosions_Victims, Victims.Num());
+	FRadialDamageEvent DmgEvent;
+	for (const FVictim& Victim : Victims)
+	{
+		AActor* const Actor = Victim.Actor;
+		if (!IsValid(Actor) || !Actor->bCanBeDamaged)
+		{
+			continue;
+		}
+
+		const FShooterExplosion& Explosion = Processing[Victim.ExplosionIdx];
+
+		DmgEvent.DamageTypeClass = Explosion.DamageTypeClass ? Explosion.DamageTypeClass : TSubclassOf<UDamageType>(UDamageType::StaticClass());
+		DmgEvent.Origin = Explosion.Origin;
+		DmgEvent.Params = FRadialDamageParams(Explosion.BaseDamage, Explosion.MinimumDamage, Explosion.InnerRadius, Explosion.OuterRadius, Explosion.DamageFalloff);
+		DmgEvent.ComponentHits.Reset();
+		DmgEvent.ComponentHits.Add(Victim.Hit);
+
+		if (AShooterCharacter* ShooterChar = Cast<AShooterCharacter>(Actor))
+		{
+			UShooterCharacterMovement* CharacterMovementComp = Cast<UShooterCharacterMovement>(ShooterChar->GetMovementComponent());
+			CharacterMovementComp->SetCatchAir(true);
+		}
+		Actor->TakeDamage(Explosion.BaseDamage, DmgEvent, Explosion.InstigatedBy.Get(), Explosion.DamageCauser.Get());
+	}
+
+	const int32 NumQueries = Clusters.Num();
+	Processing.Reset();
+	return NumQueries;
+}
+
+void FShooterExplosionBatcher::GatherVictims(const FShooterExplosion& Explosion, int32 ExplosionIdx)
+{
+	UWorld* const MyWorld = World.Get();
+	AActor* const DamageCauser = Explosion.DamageCauser.Get();
+	AActor* const IgnoreActor = Explosion.IgnoreActor.Get();
+	const float RadiusSq = FMath::Square(Explosion.OuterRadius);
+	const int32 FirstVictim = Victims.Num();
+
+	FCollisionQueryParams LineParams(SCENE_QUERY_STAT(ComponentIsVisibleFrom), true, DamageCauser);
+	LineParams.AddIgnoredActor(IgnoreActor);
+	FCollisionResponseParams LineResponseParams(ECR_Block);
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AActor* const OverlapActor = Overlap.GetActor();
+		UPrimitiveComponent* const OverlapComp = Overlap.GetComponent();
+		if (!IsValid(OverlapActor) || !IsValid(OverlapComp) || OverlapActor == DamageCauser || OverlapActor == IgnoreActor)
+		{
+			continue;
+		}
+
+		if (!FMath::SphereAABBIntersection(Explosion.Origin, RadiusSq, OverlapComp->Bounds.GetBox()))
+		{
+			continue;
+		}
+
+		// one damaging component per actor is enough
+		bool bAlreadyHit = false;
+		for (int32 VictimIdx = FirstVictim; VictimIdx < Victims.Num() && !bAlreadyHit; ++VictimIdx)
+		{
+			bAlreadyHit = Victims[VictimIdx].Actor == OverlapActor;
+		}
+		if (bAlreadyHit)
+		{
+			continue;
+		}
+
+		FVector TraceStart = Explosion.Origin;
+		const FVector TraceEnd = OverlapComp->Bounds.Origin;
+		if (TraceStart == TraceEnd)
+		{
+			// tiny nudge so LineTraceSingle doesn't early out with no hits
+			TraceStart.Z += 0.01f;
+		}
+
+		INC_DWORD_STAT(STAT_Explosions_Traces);
+		FHitResult Hit;
+		if (MyWorld->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, Explosion.DamagePreventionChannel, LineParams, LineResponseParams) && Hit.Component == OverlapComp)
+		{
+			Victims.Add(FVictim{ ExplosionIdx, OverlapActor, Hit });
+		}
+	}
+}
@@ -5,6 +5,7 @@
 #include "Particles/ParticleSystemComponent.h"
 #include "Effects/ShooterExplosionEffect.h"
 #include "Player/ShooterCharacter.h"
+#include "Weapons/ShooterExplosionBatcher.h"
 
 AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -46,8 +47,14 @@ AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializ
 void AShooterProjectile::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
+	InitProjectile();
+}
+
+void AShooterProjectile::InitProjectile()
+{
 	MovementComp->ProjectileGravityScale = ProjectileGravityScale;
 	// Note: the MoveIgnoreActors and IgnoreActorWhenMoving functions only work if the collision comp isn't simulating physics. what's with that?
+	CollisionComp->ClearMoveIgnoreActors();
 	CollisionComp->MoveIgnoreActors.Add(Instigator);
 	CollisionComp->IgnoreActorWhenMoving(Instigator, true);
 	
@@ -65,12 +72,56 @@ void AShooterProjectile::PostInitializeComponents()
 	if (bExplodeOnImpact)
 	{
 		SetLifeSpan(WeaponConfig.ProjectileLife);
-		MovementComp->OnProjectileStop.AddDynamic(this, &AShooterProjectile::OnImpact);
+		MovementComp->OnProjectileStop.AddUniqueDynamic(this, &AShooterProjectile::OnImpact);
 	}
 	MyController = GetInstigatorController();
 	ProjectileSpawnLocation = GetActorLocation();
 }
 
+void AShooterProjectile::LifeSpanExpired()
+{
+	if (!FShooterActorPool::Release(this))
+	{
+		Super::LifeSpanExpired();
+	}
+}
+
+void AShooterProjectile::OnAcquiredFromPool()
+{
+	bExploded = false;
+
+	// stopping on impact or parking detached the movement from the collision
+	MovementComp->SetUpdatedComponent(CollisionComp);
+	MovementComp->Activate(true);
+	InitProjectile();
+
+	if (ParticleComp->bAutoActivate)
+	{
+		ParticleComp->Activate(true);
+	}
+
+	UAudioComponent* ProjAudioComp = FindComponentByClass<UAudioComponent>();
+	if (ProjAudioComp && ProjAudioComp->bAutoActivate)
+	{
+		ProjAudioComp->Play();
+	}
+}
+
+void AShooterProjectile::OnReleasedToPool()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	MovementComp->StopMovementImmediately();
+	MovementComp->SetUpdatedComponent(nullptr);
+	MovementComp->Deactivate();
+	ParticleComp->DeactivateImmediate();
+
+	UAudioComponent* ProjAudioComp = FindComponentByClass<UAudioComponent>();
+	if (ProjAudioComp)
+	{
+		ProjAudioComp->Stop();
+	}
+}
+
 void AShooterProjectile::InitVelocity(FVector& ShootDire)
 {
 	ShootDirection = ShootDire;
@@ -141,18 +192,38 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 			// ignore this actor when applying radial damage
 			IgnoreActors.Add(ImpactActor);
 		}
-		// apply radial damage to other actors
-		ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, Impact.ImpactPoint, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, IgnoreActors, this, MyController.Get(), true, COLLISION_WEAPON);
+		// apply radial damage to other actors, batched with the other explosions of this frame on the server
+		AShooterGameMode* const GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		if (GameMode)
+		{
+			FShooterExplosion Explosion;
+			Explosion.Origin = Impact.ImpactPoint;
+			Explosion.BaseDamage = WeaponConfig.ExplosionDamage;
+			Explosion.MinimumDamage = 0.f;
+			Explosion.InnerRadius = 0.f;
+			Explosion.OuterRadius = WeaponConfig.ExplosionRadius;
+			Explosion.DamageFalloff = 0.f;
+			Explosion.DamageTypeClass = WeaponConfig.DamageType;
+			Explosion.DamagePreventionChannel = COLLISION_WEAPON;
+			Explosion.DamageCauser = this;
+			Explosion.IgnoreActor = ImpactActor;
+			Explosion.InstigatedBy = MyController;
+			GameMode->GetExplosionBatcher().Queue(Explosion);
+		}
+		else
+		{
+			ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, Impact.ImpactPoint, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, IgnoreActors, this, MyController.Get(), true, COLLISION_WEAPON);
+		}
 	}
 
 	if (ExplosionTemplate)
 	{
 		FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), NudgedImpactLocation);
-		AShooterExplosionEffect* const EffectActor = GetWorld()->SpawnActorDeferred<AShooterExplosionEffect>(ExplosionTemplate, SpawnTransform);
+		AShooterExplosionEffect* const EffectActor = FShooterActorPool::BeginSpawn<AShooterExplosionEffect>(this, ExplosionTemplate, SpawnTransform);
 		if (EffectActor)
 		{
 			EffectActor->SurfaceHit = Impact;
-			UGameplayStatics::FinishSpawningActor(EffectActor, SpawnTransform);
+			FShooterActorPool::FinishSpawn(EffectActor, SpawnTransform);
 		}
 	}
 
@@ -735,13 +735,19 @@ FVector AShooterWeapon::GetMuzzleDirection() const
 	return UseMesh->GetSocketRotation(MuzzleAttachPoint).Vector();
 }
 
-FHitResult AShooterWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace) const
+FCollisionQueryParams AShooterWeapon::GetWeaponTraceParams() const
 {
-
-	// Perform trace to retrieve hit info
 	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WeaponTrace), true, Instigator);
 	TraceParams.bTraceAsyncScene = true;
 	TraceParams.bReturnPhysicalMaterial = true;
+	return TraceParams;
+}
+
+FHitResult AShooterWeapon::WeaponTrace(const FVector& StartTrace, const FVector& EndTrace) const
+{
+
+	// Perform trace to retrieve hit info
+	const FCollisionQueryParams TraceParams = GetWeaponTraceParams();
 
 	FHitResult Hit(ForceInit);
 	GetWorld()->LineTraceSingleByChannel(Hit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
@@ -749,6 +755,19 @@ FHitResult AShooterWeapon::WeaponTrace(const FVector& StartTrace, const FVector&
 	return Hit;
 }
 
+void AShooterWeapon::AsyncWeaponTrace(const FVector& StartTrace, const FVector& EndTrace, EShooterTracePriority::Type Priority, const FOnWeaponTraceDone& Callback) const
+{
+	AShooterGameState* const MyGameState = GetWorld()->GetGameState<AShooterGameState>();
+	if (MyGameState)
+	{
+		MyGameState->GetWeaponTraces().RequestTrace(StartTrace, EndTrace, GetWeaponTraceParams(), Priority, Callback);
+	}
+	else
+	{
+		Callback.ExecuteIfBound(WeaponTrace(StartTrace, EndTrace));
+	}
+}
+
 void AShooterWeapon::SetOwningPawn(AShooterCharacter* NewOwner)
 {
 	if (MyPawn != NewOwner)
@@ -0,0 +1,147 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Weapons/ShooterWeaponTraces.h"
+
+DECLARE_STATS_GROUP(TEXT("ShooterWeaponTraces"), STATGROUP_ShooterWeaponTraces, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gameplay traces"), STAT_WeaponTraces_Gameplay, STATGROUP_ShooterWeaponTraces);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cosmetic traces"), STAT_WeaponTraces_Cosmetic, STATGROUP_ShooterWeaponTraces);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred"), STAT_WeaponTraces_Deferred, STATGROUP_ShooterWeaponTraces);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dropped"), STAT_WeaponTraces_Dropped, STATGROUP_ShooterWeaponTraces);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("In flight"), STAT_WeaponTraces_InFlight, STATGROUP_ShooterWeaponTraces);
+
+static int32 WeaponTraceAsync = 1;
+FAutoConsoleVariableRef CVarWeaponTraceAsync(
+	TEXT("p.WeaponTraceAsync"),
+	WeaponTraceAsync,
+	TEXT("1: weapon traces are async, results are processed the next frame. 0: traced synchronously."),
+	ECVF_Default);
+
+static int32 WeaponTraceBudget = 64;
+FAutoConsoleVariableRef CVarWeaponTraceBudget(
+	TEXT("p.WeaponTraceBudget"),
+	WeaponTraceBudget,
+	TEXT("Weapon traces per frame before cosmetic traces are deferred. Gameplay traces are never deferred but count against it."),
+	ECVF_Default);
+
+static int32 WeaponTraceMaxDeferFrames = 2;
+FAutoConsoleVariableRef CVarWeaponTraceMaxDeferFrames(
+	TEXT("p.WeaponTraceMaxDeferFrames"),
+	WeaponTraceMaxDeferFrames,
+	TEXT("Frames a deferred cosmetic weapon trace may wait for budget before it is dropped."),
+	ECVF_Default);
+
+FShooterWeaponTraces::FShooterWeaponTraces(UWorld* InWorld)
+	: World(InWorld)
+	, NextRequestId(0)
+	, NumIssuedThisFrame(0)
+{
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FShooterWeaponTraces::OnWorldPostActorTick);
+}
+
+FShooterWeaponTraces::~FShooterWeaponTraces()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+}
+
+void FShooterWeaponTraces::RequestTrace(const FVector& Start, const FVector& End, const FCollisionQueryParams& Params, EShooterTracePriority::Type Priority, const FOnWeaponTraceDone& Callback)
+{
+	if (Priority == EShooterTracePriority::Gameplay)
+	{
+		INC_DWORD_STAT(STAT_WeaponTraces_Gameplay);
+		IssueTrace(Start, End, Params, Callback);
+	}
+	else if (NumIssuedThisFrame < WeaponTraceBudget && Deferred.Num() == 0)
+	{
+		INC_DWORD_STAT(STAT_WeaponTraces_Cosmetic);
+		IssueTrace(Start, End, Params, Callback);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_WeaponTraces_Deferred);
+		Deferred.Add(FDeferredTrace{ Start, End, Params, Callback, GFrameCounter });
+	}
+}
+
+void FShooterWeaponTraces::IssueTrace(const FVector& Start, const FVector& End, const FCollisionQueryParams& Params, const FOnWeaponTraceDone& Callback)
+{
+	UWorld* const MyWorld = World.Get();
+	if (MyWorld == nullptr)
+	{
+		return;
+	}
+
+	++NumIssuedThisFrame;
+
+	if (WeaponTraceAsync == 0)
+	{
+		FHitResult Hit(ForceInit);
+		MyWorld->LineTraceSingleByChannel(Hit, Start, End, COLLISION_WEAPON, Params);
+		Callback.ExecuteIfBound(Hit);
+		return;
+	}
+
+	if (!TraceDelegate.IsBound())
+	{
+		TraceDelegate = FTraceDelegate::CreateSP(this, &FShooterWeaponTraces::OnTraceDone);
+	}
+
+	const uint32 RequestId = NextRequestId++;
+	InFlight.Add(RequestId, Callback);
+	INC_DWORD_STAT(STAT_WeaponTraces_InFlight);
+
+	MyWorld->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, COLLISION_WEAPON, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, RequestId);
+}
+
+void FShooterWeaponTraces::OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FOnWeaponTraceDone Callback;
+	if (!InFlight.RemoveAndCopyValue(Datum.UserData, Callback))
+	{
+		return;
+	}
+	DEC_DWORD_STAT(STAT_WeaponTraces_InFlight);
+
+	if (Datum.OutHits.Num() > 0)
+	{
+		Callback.ExecuteIfBound(Datum.OutHits[0]);
+	}
+	else
+	{
+		FHitResult Miss(ForceInit);
+		Miss.TraceStart = Datum.Start;
+		Miss.TraceEnd = Datum.End;
+		Callback.ExecuteIfBound(Miss);
+	}
+}
+
+void FShooterWeaponTraces::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != World.Get())
+	{
+		return;
+	}
+
+	NumIssuedThisFrame = 0;
+
+	int32 NumHandled = 0;
+	for (; NumHandled < Deferred.Num(); ++NumHandled)
+	{
+		// copy, a synchronous trace may run callbacks that defer more traces
+		const FDeferredTrace Trace = Deferred[NumHandled];
+		if (GFrameCounter - Trace.RequestFrame > (uint64)FMath::Max(WeaponTraceMaxDeferFrames, 0))
+		{
+			INC_DWORD_STAT(STAT_WeaponTraces_Dropped);
+			continue;
+		}
+
+		if (NumIssuedThisFrame >= WeaponTraceBudget)
+		{
+			break;
+		}
+
+		INC_DWORD_STAT(STAT_WeaponTraces_Cosmetic);
+		IssueTrace(Trace.Start, Trace.End, Trace.Params, Trace.Callback);
+	}
+	Deferred.RemoveAt(0, NumHandled, false);
+}
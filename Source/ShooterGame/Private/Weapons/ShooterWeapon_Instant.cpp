@@ -25,12 +25,21 @@ void AShooterWeapon_Instant::FireWeapon()
 	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
 	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
 
-	const FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
-	ProcessInstantHit(Impact, StartTrace, ShootDir, RandomSeed, CurrentSpread);
+	AsyncWeaponTrace(StartTrace, EndTrace, EShooterTracePriority::Gameplay,
+		FOnWeaponTraceDone::CreateUObject(this, &AShooterWeapon_Instant::OnFireTraceDone, StartTrace, ShootDir, RandomSeed, CurrentSpread));
 
 	CurrentFiringSpread = FMath::Min(InstantConfig.FiringSpreadMax, CurrentFiringSpread + InstantConfig.FiringSpreadIncrement);
 }
 
+void AShooterWeapon_Instant::OnFireTraceDone(const FHitResult& Impact, FVector Origin, FVector ShootDir, int32 RandomSeed, float ReticleSpread)
+{
+	// the weapon may have been dropped while the trace was in flight
+	if (MyPawn)
+	{
+		ProcessInstantHit(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+	}
+}
+
 bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult& Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
 	return true;
@@ -52,6 +61,8 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 		{
 			if (CurrentState != EWeaponState::Idle)
 			{
+				const AShooterCharacter* HitCharacter = Cast<AShooterCharacter>(Impact.GetActor());
+
 				if (Impact.GetActor() == NULL)
 				{
 					if (Impact.bBlockingHit)
@@ -65,6 +76,18 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 				{
 					ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 				}
+				// rewind characters to the time the shooter saw them
+				else if (HitCharacter && HitCharacter->GetHitboxHistory().HasSamples())
+				{
+					if (IsHitInHitboxHistory(HitCharacter, Impact))
+					{
+						ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
+					}
+					else
+					{
+						UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (outside rewound hitboxes)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
+					}
+				}
 				else
 				{
 					// Get the component bounding box
@@ -107,6 +130,17 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult& Im
 	}
 }
 
+bool AShooterWeapon_Instant::IsHitInHitboxHistory(const AShooterCharacter* HitCharacter, const FHitResult& Impact) const
+{
+	// The shooter saw the target about one round trip ago: half a trip for the target's movement to reach the shooter and half for the hit to come back
+	const APlayerState* ShooterPlayerState = Instigator ? Instigator->PlayerState : nullptr;
+	const float RoundTripTime = ShooterPlayerState ? ShooterPlayerState->ExactPing * 0.001f : 0.0f;
+	const float RewindTime = FMath::Min(RoundTripTime, InstantConfig.MaxHitboxRewindTime);
+	const float ClientTime = GetWorld()->GetTimeSeconds() - RewindTime;
+
+	return HitCharacter->GetHitboxHistory().IsPointNearPose(ClientTime, Impact.ImpactPoint, InstantConfig.HitboxRewindTolerance);
+}
+
 bool AShooterWeapon_Instant::ServerNotifyMiss_Validate(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
 	return true;
@@ -253,7 +287,12 @@ void AShooterWeapon_Instant::SimulateInstantHit(const FVector& ShotOrigin, int32
 	const FVector ShootDir = WeaponRandomStream.VRandCone(AimDir, ConeHalfAngle, ConeHalfAngle);
 	const FVector EndTrace = StartTrace + ShootDir * InstantConfig.WeaponRange;
 
-	FHitResult Impact = WeaponTrace(StartTrace, EndTrace);
+	AsyncWeaponTrace(StartTrace, EndTrace, EShooterTracePriority::Cosmetic,
+		FOnWeaponTraceDone::CreateUObject(this, &AShooterWeapon_Instant::OnSimulatedTraceDone, EndTrace));
+}
+
+void AShooterWeapon_Instant::OnSimulatedTraceDone(const FHitResult& Impact, FVector EndTrace)
+{
 	if (Impact.bBlockingHit)
 	{
 		SpawnImpactEffects(Impact);
@@ -269,27 +308,32 @@ void AShooterWeapon_Instant::SpawnImpactEffects(const FHitResult& Impact)
 {
 	if (ImpactTemplate && Impact.bBlockingHit)
 	{
-		FHitResult UseImpact = Impact;
-
 		// trace again to find component lost during replication
 		if (!Impact.Component.IsValid())
 		{
 			const FVector StartTrace = Impact.ImpactPoint + Impact.ImpactNormal * 10.0f;
 			const FVector EndTrace = Impact.ImpactPoint - Impact.ImpactNormal * 10.0f;
-			FHitResult Hit = WeaponTrace(StartTrace, EndTrace);
-			UseImpact = Hit;
+			AsyncWeaponTrace(StartTrace, EndTrace, EShooterTracePriority::Cosmetic,
+				FOnWeaponTraceDone::CreateUObject(this, &AShooterWeapon_Instant::SpawnImpactEffect, Impact));
 		}
-
-		FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint);
-		AShooterImpactEffect* EffectActor = GetWorld()->SpawnActorDeferred<AShooterImpactEffect>(ImpactTemplate, SpawnTransform);
-		if (EffectActor)
+		else
 		{
-			EffectActor->SurfaceHit = UseImpact;
-			UGameplayStatics::FinishSpawningActor(EffectActor, SpawnTransform);
+			SpawnImpactEffect(Impact, Impact);
 		}
 	}
 }
 
+void AShooterWeapon_Instant::SpawnImpactEffect(const FHitResult& SurfaceHit, FHitResult Impact)
+{
+	FTransform const SpawnTransform(Impact.ImpactNormal.Rotation(), Impact.ImpactPoint);
+	AShooterImpactEffect* EffectActor = FShooterActorPool::BeginSpawn<AShooterImpactEffect>(this, ImpactTemplate, SpawnTransform);
+	if (EffectActor)
+	{
+		EffectActor->SurfaceHit = SurfaceHit;
+		FShooterActorPool::FinishSpawn(EffectActor, SpawnTransform);
+	}
+}
+
 void AShooterWeapon_Instant::SpawnTrailEffect(const FVector& EndPoint)
 {
 	if (TrailFX)
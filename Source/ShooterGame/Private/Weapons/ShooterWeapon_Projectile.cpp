@@ -77,14 +77,12 @@ bool AShooterWeapon_Projectile::ServerFireProjectile_Validate(FVector Origin, FV
 void AShooterWeapon_Projectile::ServerFireProjectile_Implementation(FVector Origin, FVector_NetQuantizeNormal ShootDir)
 {
 	FTransform SpawnTM(ShootDir.Rotation(), Origin);
-	AShooterProjectile* Projectile = Cast<AShooterProjectile>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ProjectileConfig.ProjectileClass, SpawnTM));
+	AShooterProjectile* Projectile = FShooterActorPool::BeginSpawn<AShooterProjectile>(this, ProjectileConfig.ProjectileClass, SpawnTM, this, Instigator);
 	if (Projectile)
 	{
-		Projectile->Instigator = Instigator;
-		Projectile->SetOwner(this);
 		Projectile->InitVelocity(ShootDir);
 
-		UGameplayStatics::FinishSpawningActor(Projectile, SpawnTM);
+		FShooterActorPool::FinishSpawn(Projectile, SpawnTM);
 	}
 }
 
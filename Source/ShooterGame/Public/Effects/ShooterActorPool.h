@@ -0,0 +1,100 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "ShooterActorPool.generated.h"
+
+UINTERFACE(meta=(CannotImplementInterfaceInBlueprint))
+class UShooterPoolableActor : public UInterface
+{
+	GENERATED_UINTERFACE_BODY()
+};
+
+/** Actors implementing this are recycled by FShooterActorPool instead of being destroyed */
+class IShooterPoolableActor
+{
+	GENERATED_IINTERFACE_BODY()
+
+public:
+
+	/** [reused actor] the actor left the pool, properties set between BeginSpawn and FinishSpawn are in place. Replaces BeginPlay. */
+	virtual void OnAcquiredFromPool() = 0;
+
+	/** the actor was hidden and parked, stop timers and anything else still running */
+	virtual void OnReleasedToPool() = 0;
+};
+
+/** Number of instances of a class spawned into the pool when the match starts */
+USTRUCT()
+struct FShooterActorPoolWarmUp
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TSoftClassPtr<AActor> ActorClass;
+
+	UPROPERTY()
+	int32 Count;
+
+	FShooterActorPoolWarmUp()
+		: Count(0)
+	{
+	}
+};
+
+/**
+ * Per world free lists of short lived actors (impact and explosion effects, projectiles), owned by the game state.
+ *
+ * Spawn through BeginSpawn / FinishSpawn, which behave like a deferred spawn but hand out a parked actor of the class when
+ * there is one, and give actors back with Release instead of destroying them. Parked actors are hidden, without collision
+ * and without actor or component tick. Only classes implementing IShooterPoolableActor are pooled, and replicated ones
+ * only in standalone games: a recycled replicated actor would keep its channel and its clients would miss the reset.
+ */
+class SHOOTERGAME_API FShooterActorPool
+{
+public:
+
+	FShooterActorPool(UWorld* InWorld);
+
+	/** Returns the pool of the world, nullptr until its game state exists */
+	static FShooterActorPool* Get(const UObject* WorldContextObject);
+
+	/** Takes a parked actor of the class or starts a deferred spawn, through the pool of the world if there is one */
+	static AActor* BeginSpawn(const UObject* WorldContextObject, UClass* ActorClass, const FTransform& Transform, AActor* Owner = nullptr, APawn* Instigator = nullptr);
+
+	template<typename T>
+	static T* BeginSpawn(const UObject* WorldContextObject, TSubclassOf<T> ActorClass, const FTransform& Transform, AActor* Owner = nullptr, APawn* Instigator = nullptr)
+	{
+		return Cast<T>(BeginSpawn(WorldContextObject, *ActorClass, Transform, Owner, Instigator));
+	}
+
+	/** Finishes the spawn of a new actor, or calls OnAcquiredFromPool on a recycled one */
+	static void FinishSpawn(AActor* Actor, const FTransform& Transform);
+
+	/** Parks the actor for reuse. Returns false if it can't be pooled, the caller destroys it then. */
+	static bool Release(AActor* Actor);
+
+	/** Spawns Count parked instances of the class */
+	void WarmUp(UClass* ActorClass, int32 Count);
+
+	/** True while WarmUp spawns, effects don't play then */
+	bool IsWarmingUp() const { return bWarmingUp; }
+
+	bool CanPool(UClass* ActorClass) const;
+
+	int32 NumParked() const;
+
+private:
+
+	AActor* Acquire(UClass* ActorClass, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+
+	bool Park(AActor* Actor);
+
+	TWeakObjectPtr<UWorld> World;
+
+	TMap<UClass*, TArray<TWeakObjectPtr<AActor>>> FreeLists;
+
+	bool bWarmingUp;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ShooterTypes.h"
+#include "Effects/ShooterActorPool.h"
 #include "ShooterExplosionEffect.generated.h"
 
 //
@@ -10,7 +11,7 @@
 // Each explosion type should be defined as separate blueprint
 //
 UCLASS(Abstract, Blueprintable)
-class AShooterExplosionEffect : public AActor
+class AShooterExplosionEffect : public AActor, public IShooterPoolableActor
 {
 	GENERATED_UCLASS_BODY()
 
@@ -43,12 +44,23 @@ public:
 	/** update fading light */
 	virtual void Tick(float DeltaSeconds) override;
 
+	/** replay explosion */
+	virtual void OnAcquiredFromPool() override;
+
+	virtual void OnReleasedToPool() override;
+
 protected:
 	/** spawn explosion */
 	virtual void BeginPlay() override;
 
+	/** spawn particles, sound and decal, restart the light fade */
+	void PlayEffect();
+
 private:
 
+	/** when the explosion started, the light fades from there */
+	float StartTime;
+
 	/** Point light component name */
 	FName ExplosionLightComponentName;
 
@@ -3,14 +3,16 @@
 #pragma once
 
 #include "ShooterTypes.h"
+#include "Effects/ShooterActorPool.h"
 #include "ShooterImpactEffect.generated.h"
 
 //
 // Spawnable effect for weapon hit impact - NOT replicated to clients
 // Each impact type should be defined as separate blueprint
+// Everything happens on spawn, so the actor goes straight back to the FShooterActorPool
 //
 UCLASS(Abstract, Blueprintable)
-class AShooterImpactEffect : public AActor
+class AShooterImpactEffect : public AActor, public IShooterPoolableActor
 {
 	GENERATED_UCLASS_BODY()
 
@@ -97,8 +99,19 @@ class AShooterImpactEffect : public AActor
 	/** spawn effect */
 	virtual void PostInitializeComponents() override;
 
+	/** back to the pool */
+	virtual void BeginPlay() override;
+
+	/** replay effect */
+	virtual void OnAcquiredFromPool() override;
+
+	virtual void OnReleasedToPool() override;
+
 protected:
 
+	/** spawn particles, sound and decal for SurfaceHit */
+	void PlayEffect();
+
 	/** get FX for material type */
 	UParticleSystem* GetImpactFX(TEnumAsByte<EPhysicalSurface> SurfaceType) const;
 
@@ -23,7 +23,41 @@ public:
 	FString MatchID;
 	int PeerId;
 	FString PlayerId;
-	TArray<TSharedPtr<RTPlayer>> PlayerList;
 
 	~RTSessionInfo();
+
+	/** Players of the session, in no particular order */
+	const TArray<TSharedPtr<RTPlayer>>& GetPlayerList() const { return PlayerList; }
+
+	/** Adds a player, replacing the one with the same peer id */
+	void AddPlayer(const TSharedPtr<RTPlayer>& Player);
+
+	/** Removes the player with the peer id, if there is one */
+	void RemovePlayer(int InPeerId);
+
+	/**
+	 * Returns the player with the peer id, or nullptr. Constant time for peer ids below MaxIndexedPeerId.
+	 * Doesn't touch reference counts, the pointer is valid until the player is removed.
+	 */
+	RTPlayer* FindPlayer(int InPeerId) const
+	{
+		if (InPeerId >= 0 && InPeerId < PlayerIndexByPeerId.Num())
+		{
+			const int32 PlayerIndex = PlayerIndexByPeerId[InPeerId];
+			return PlayerIndex != INDEX_NONE ? PlayerList[PlayerIndex].Get() : nullptr;
+		}
+		return (InPeerId < 0 || InPeerId >= MaxIndexedPeerId) ? FindPlayerSlow(InPeerId) : nullptr;
+	}
+
+private:
+
+	/** Peer ids are small numbers handed out by the RT server, larger ones are looked up by scanning PlayerList */
+	enum { MaxIndexedPeerId = 256 };
+
+	RTPlayer* FindPlayerSlow(int InPeerId) const;
+
+	TArray<TSharedPtr<RTPlayer>> PlayerList;
+
+	/** Index in PlayerList by peer id, INDEX_NONE for peer ids without player */
+	TArray<int32> PlayerIndexByPeerId;
 };
\ No newline at end of file
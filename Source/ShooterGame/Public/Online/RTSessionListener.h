@@ -21,5 +21,6 @@ public:
 	void OnPlayerDisconnect(int peerId) override;
 	void OnReady(bool ready) override;
 	void OnPacket(const GameSparks::RT::RTPacket& packet) override;
+	bool OnPacketReceived(const GameSparks::RT::RTPacket& packet) override;
 	~RTSessionListener();
 };
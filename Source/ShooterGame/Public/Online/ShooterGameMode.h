@@ -9,6 +9,30 @@ class AShooterAIController;
 class AShooterPlayerState;
 class AShooterPickup;
 class FUniqueNetId;
+class FShooterPauseRelevancy;
+class FShooterCharacterGrid;
+class FShooterPickupRegistry;
+class FShooterExplosionBatcher;
+
+/** Spawn points a team and controller type may use, with their danger scores for the current frame */
+struct FShooterSpawnCandidates
+{
+	/** indices into AShooterGameMode::SpawnPoints that pass IsSpawnpointAllowed */
+	TArray<int32> SpawnIndices;
+
+	/** per candidate, recomputed once per frame for all respawns of that frame */
+	TArray<float> Danger;
+	TArray<bool> bOccupied;
+
+	uint64 ScoreFrame = 0;
+};
+
+/** Where and when a pawn died, spawns near recent deaths are avoided */
+struct FShooterRecentDeath
+{
+	FVector Location;
+	float Time;
+};
 
 UCLASS(config=Game)
 class AShooterGameMode : public AGameMode
@@ -106,6 +130,18 @@ protected:
 	/** Handle for efficient management of DefaultTimer timer */
 	FTimerHandle TimerHandle_DefaultTimer;
 
+	/** created on first use by GetPauseRelevancy */
+	TSharedPtr<FShooterPauseRelevancy> PauseRelevancy;
+
+	/** created on first use by GetCharacterGrid */
+	TSharedPtr<FShooterCharacterGrid> CharacterGrid;
+
+	/** created on first use by GetPickupRegistry */
+	TSharedPtr<FShooterPickupRegistry> PickupRegistry;
+
+	/** created on first use by GetExplosionBatcher */
+	TSharedPtr<FShooterExplosionBatcher> ExplosionBatcher;
+
 	bool bNeedsBotCreation;
 
 	bool bAllowBots;		
@@ -128,6 +164,35 @@ protected:
 	/** check if player should use spawnpoint */
 	virtual bool IsSpawnpointPreferred(APlayerStart* SpawnPoint, AController* Player) const;
 
+	/** radius around a spawn point in which enemies and recent deaths count as danger */
+	float SpawnDangerRadius;
+
+	/** seconds a death keeps making nearby spawn points dangerous */
+	float SpawnDeathMemory;
+
+	/** all player starts of the map, gathered on the first spawn and again after one of them went away */
+	UPROPERTY(Transient)
+	TArray<APlayerStart*> SpawnPoints;
+
+	/** "Play from Here" start, always used in PIE */
+	UPROPERTY(Transient)
+	APlayerStart* PIESpawnPoint;
+
+	bool bSpawnPointsGathered;
+
+	/** allowed spawn points, keyed by team number and whether the controller is a bot. IsSpawnpointAllowed overrides must only depend on those. */
+	TMap<FIntPoint, FShooterSpawnCandidates> SpawnCandidates;
+
+	/** ring of the last deaths, written at RecentDeathIndex */
+	TArray<FShooterRecentDeath> RecentDeaths;
+	int32 RecentDeathIndex;
+
+	/** returns the allowed spawn points of the player's team and controller type, building them on first use */
+	FShooterSpawnCandidates& GetSpawnCandidates(AController* Player);
+
+	/** scores enemy proximity, recent deaths and occupancy of every candidate */
+	void ScoreSpawnCandidates(FShooterSpawnCandidates& Candidates, AController* Player) const;
+
 	/** Returns game session class to use */
 	virtual TSubclassOf<AGameSession> GetGameSessionClass() const override;	
 
@@ -144,6 +209,18 @@ public:
 	/** get the name of the bots count option used in server travel URL */
 	static FString GetBotsCountOptionName();
 
+	/** pawn to viewer visibility cache used for pause relevancy */
+	FShooterPauseRelevancy& GetPauseRelevancy();
+
+	/** spatial index of the live characters, used for AI target acquisition */
+	FShooterCharacterGrid& GetCharacterGrid();
+
+	/** index of LevelPickups by class, weapon type and location */
+	FShooterPickupRegistry& GetPickupRegistry();
+
+	/** resolves the radial damage of the projectile explosions of a frame together */
+	FShooterExplosionBatcher& GetExplosionBatcher();
+
 	UPROPERTY()
 	TArray<AShooterPickup*> LevelPickups;
 
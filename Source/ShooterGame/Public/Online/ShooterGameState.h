@@ -2,11 +2,16 @@
 
 #pragma once
 
+#include "Effects/ShooterActorPool.h"
+#include "Weapons/ShooterWeaponTraces.h"
+#include "Online/ShooterPlayerRanking.h"
 #include "ShooterGameState.generated.h"
 
 /** ranked PlayerState map, created from the GameState */
 typedef TMap<int32, TWeakObjectPtr<AShooterPlayerState> > RankedPlayerMap; 
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnShooterPlayerStatsChange, AShooterPlayerState*);
+
 UCLASS()
 class AShooterGameState : public AGameState
 {
@@ -53,5 +58,52 @@ public:
 	/** gets ranked PlayerState map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
 
+	/** 0 based position of the player in its team, INDEX_NONE if it has no team */
+	int32 GetPlayerRank(const AShooterPlayerState* PlayerState) const;
+
+	/** number of players ranked in a team */
+	int32 GetNumRankedPlayers(int32 TeamIndex) const;
+
+	/** player at the 0 based position of the team, nullptr past the last one */
+	AShooterPlayerState* GetRankedPlayer(int32 TeamIndex, int32 Rank) const;
+
+	/** re-ranks the player after its score, team or player id changed and tells listeners of OnPlayerStatsChange. Returns false if none of them did. */
+	bool UpdatePlayerRanking(AShooterPlayerState* PlayerState);
+
+	/** tells listeners of OnPlayerStatsChange about a change that doesn't affect the ranking (kills, deaths, name) */
+	void NotifyPlayerStatsChanged(AShooterPlayerState* PlayerState);
+
+	/** [server and client] a player joined or left the ranking, or its team, score, kills, deaths or name changed */
+	FOnShooterPlayerStatsChange OnPlayerStatsChange;
+
+	// Begin AGameStateBase interface
+	virtual void AddPlayerState(APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(APlayerState* PlayerState) override;
+	// End AGameStateBase interface
+
 	void RequestFinishAndExitToMainMenu();
+
+	/** recycles effect and projectile actors of this world */
+	FShooterActorPool& GetActorPool();
+
+	/** budgeted async traces of the weapons of this world */
+	FShooterWeaponTraces& GetWeaponTraces();
+
+protected:
+
+	/** actors spawned into the pool on BeginPlay */
+	UPROPERTY(config)
+	TArray<FShooterActorPoolWarmUp> ActorPoolWarmUp;
+
+	/** created on first use by GetActorPool */
+	TSharedPtr<FShooterActorPool> ActorPool;
+
+	/** created on first use by GetWeaponTraces */
+	TSharedPtr<FShooterWeaponTraces> WeaponTraces;
+
+	/** players of PlayerArray by team and score */
+	FShooterPlayerRanking PlayerRanking;
+
+	/** warms up the actor pool */
+	virtual void BeginPlay() override;
 };
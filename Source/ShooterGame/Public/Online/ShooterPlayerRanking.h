@@ -0,0 +1,73 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AShooterPlayerState;
+
+/**
+ * Players of every team ordered by score, kept up to date by the game state as player states join, leave, change team or score.
+ *
+ * Each team is an array sorted by descending score, ties broken by player id. A player's rank is a binary search for its
+ * (score, id) key, so it is O(log n) and nothing is sorted or copied when the HUD or scoreboard asks. Player ids are 0 until
+ * the server assigns them or they replicate, so equal keys are possible and the player is looked up among them by pointer. Moving a player after a
+ * score change shifts the entries between its old and new rank, which for match sized teams is a few pointers.
+ */
+class SHOOTERGAME_API FShooterPlayerRanking
+{
+public:
+
+	/** Starts ranking the player with its current team and score */
+	void Add(AShooterPlayerState* PlayerState);
+
+	void Remove(const AShooterPlayerState* PlayerState);
+
+	/** Moves a ranked player to the place of its current team, score and player id. Returns false if none of them changed. */
+	bool Update(AShooterPlayerState* PlayerState);
+
+	/** 0 based rank of the player within its team, INDEX_NONE if it isn't ranked */
+	int32 GetRank(const AShooterPlayerState* PlayerState) const;
+
+	int32 GetNumPlayers(int32 TeamIndex) const;
+
+	/** Player at the 0 based rank of the team */
+	AShooterPlayerState* GetPlayer(int32 TeamIndex, int32 Rank) const;
+
+private:
+
+	struct FKey
+	{
+		int32 TeamIndex;
+		int32 Score;
+		int32 PlayerId;
+
+		/** true if this ranks before Other */
+		bool RanksBefore(const FKey& Other) const
+		{
+			return Score != Other.Score ? Score > Other.Score : PlayerId < Other.PlayerId;
+		}
+	};
+
+	struct FEntry
+	{
+		FKey Key;
+		AShooterPlayerState* PlayerState;
+	};
+
+	static FKey MakeKey(const AShooterPlayerState* PlayerState);
+
+	/** Index of the first entry of the team that doesn't rank before Key */
+	int32 LowerBound(const FKey& Key) const;
+
+	/** Index of the player's entry among the entries with its key, INDEX_NONE if it isn't there */
+	int32 Find(const FKey& Key, const AShooterPlayerState* PlayerState) const;
+
+	void Insert(const FKey& Key, AShooterPlayerState* PlayerState);
+
+	/** Ranked entries per team */
+	TArray<TArray<FEntry>> Teams;
+
+	/** Key every ranked player was inserted with */
+	TMap<const AShooterPlayerState*, FKey> Keys;
+};
@@ -4,6 +4,9 @@
 
 #include "ShooterPlayerState.generated.h"
 
+class AShooterPlayerState;
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnShooterPlayerStateScoreChange, AShooterPlayerState*);
+
 UCLASS()
 class AShooterPlayerState : public APlayerState
 {
@@ -21,10 +24,22 @@ class AShooterPlayerState : public APlayerState
 	 */
 	virtual void ClientInitialize(class AController* InController) override;
 
+	/** re-rank once the game session assigned our player id */
+	virtual void RegisterPlayerWithSession(bool bWasFromInvite) override;
+
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** re-rank on clients */
+	virtual void OnRep_Score() override;
+
+	/** update the scoreboard */
+	virtual void OnRep_PlayerName() override;
+
 	// End APlayerState interface
 
+	/** re-rank on clients once the player id replicated, it has no rep notify. Other updates are left to their rep notifies. */
+	virtual void PostNetReceive() override;
+
 	/**
 	 * Set new team and update pawn. Also updates player character team colors.
 	 *
@@ -74,6 +89,10 @@ class AShooterPlayerState : public APlayerState
 	UFUNCTION()
 	void OnRep_TeamColor();
 
+	/** [client] kills or deaths changed, update the scoreboard */
+	UFUNCTION()
+	void OnRep_Stats();
+
 	//We don't need stats about amount of ammo fired to be server authenticated, so just increment these with local functions
 	void AddBulletsFired(int32 NumBullets);
 	void AddRocketsFired(int32 NumRockets);
@@ -83,21 +102,33 @@ class AShooterPlayerState : public APlayerState
 	void SetQuitter(bool bInQuitter);
 
 	virtual void CopyProperties(class APlayerState* PlayerState) override;
+
+	/** Global notification when kills, deaths or score of a player change on the server. Needed for replication graph. */
+	SHOOTERGAME_API static FOnShooterPlayerStateScoreChange NotifyScoreChange;
 protected:
 
 	/** Set the mesh colors based on the current teamnum variable */
 	void UpdateTeamColors();
 
+	/** tell the game state our score or team changed */
+	void UpdateRanking();
+
+	/** tell the game state our kills, deaths or name changed */
+	void NotifyStatsChanged();
+
 	/** team number */
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_TeamColor)
 	int32 TeamNumber;
 
+	/** [client] PlayerId the last PostNetReceive re-ranked with */
+	int32 RankedPlayerId;
+
 	/** number of kills */
-	UPROPERTY(Transient, Replicated)
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_Stats)
 	int32 NumKills;
 
 	/** number of deaths */
-	UPROPERTY(Transient, Replicated)
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_Stats)
 	int32 NumDeaths;
 
 	/** number of bullets fired this match */
@@ -0,0 +1,40 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+namespace GameSparks { namespace RT { class IRTSession; } }
+
+/**
+ * Services the connection of an RT session at p.RTNetworkTickRate on its own thread.
+ *
+ * The thread only calls IRTSession::UpdateConnection, which reads the reliable connection and keeps the session connected.
+ * Listener callbacks are still invoked on the game thread by IRTSession::DispatchCallbacks, except for the opcodes that
+ * FShooterRTPacketRouter handles on receive. Must be destroyed before the session is stopped.
+ */
+class FShooterRTNetworkThread : public FRunnable
+{
+public:
+
+	FShooterRTNetworkThread(GameSparks::RT::IRTSession& InSession);
+	virtual ~FShooterRTNetworkThread();
+
+	/** Creates the thread for the session, null if p.RTNetworkTickRate is 0 and the session is updated by the game instance tick */
+	static TUniquePtr<FShooterRTNetworkThread> Create(GameSparks::RT::IRTSession& Session);
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	GameSparks::RT::IRTSession& Session;
+
+	FThreadSafeBool bStopping;
+
+	FRunnableThread* Thread;
+};
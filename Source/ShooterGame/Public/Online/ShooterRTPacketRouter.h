@@ -0,0 +1,114 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "Containers/Queue.h"
+#include <GameSparksRT/RTData.hpp>
+#include <string>
+
+class UShooterGameInstance;
+
+/** Opcodes of the game's RT packets */
+namespace EShooterRTOpCode
+{
+	enum Type
+	{
+		/** team chat line, FShooterRTChatPacket */
+		Chat = 1,
+
+		/** opcodes are below this */
+		Max = 64,
+	};
+}
+
+namespace EShooterRTThread
+{
+	enum Type
+	{
+		/** from RTSession::Update in the game instance tick */
+		GameThread,
+		/** on the RT socket thread as soon as the packet arrives, no UObjects there */
+		ReceiveThread,
+	};
+}
+
+/** Team chat line, EShooterRTOpCode::Chat */
+struct FShooterRTChatPacket
+{
+	/** Peer id of the sender */
+	int32 Sender;
+
+	/** UTF-8 message */
+	std::string Message;
+
+	static bool Decode(const GameSparks::RT::RTPacket& Packet, FShooterRTChatPacket& OutPacket);
+};
+
+/** Packets of one opcode, updated from both threads */
+struct FShooterRTOpCodeCounters
+{
+	TAtomic<int64> Packets;
+
+	/** Payload bytes */
+	TAtomic<int64> Bytes;
+
+	/** Packets that didn't decode */
+	TAtomic<int64> Dropped;
+
+	/** Time spent decoding and handling */
+	TAtomic<int64> HandlerCycles;
+};
+
+/**
+ * Routes the RT packets of the session to the game instance by opcode.
+ *
+ * Handlers are registered at compile time in the table in ShooterRTPacketRouter.cpp. Each entry decodes the RTData of the
+ * packet straight into its packet struct and passes that to a game instance function, either on the game thread or, for
+ * latency sensitive opcodes, on the RT socket thread.
+ */
+class FShooterRTPacketRouter
+{
+public:
+
+	FShooterRTPacketRouter();
+
+	/** [RT socket thread] Handles the packet if its opcode is handled there, returns false to queue it for the game thread */
+	bool DispatchReceiveThread(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet);
+
+	/** Handles the packet if its opcode is handled on the game thread */
+	void DispatchGameThread(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet);
+
+	/** Logs the counters of every opcode that received packets and the receive to handler latency */
+	void DumpCounters(FOutputDevice& Ar) const;
+
+	/** Clears the counters, on the game thread */
+	void ResetCounters();
+
+	/** Forgets the packets of the previous session and clears the counters, before the new session is started */
+	void BeginSession();
+
+private:
+
+	void Dispatch(UShooterGameInstance& GameInstance, const GameSparks::RT::RTPacket& Packet, int32 HandlerIndex);
+
+	/** Index in the handler table by opcode, INDEX_NONE without handler */
+	int32 HandlerIndexByOpCode[EShooterRTOpCode::Max];
+
+	FShooterRTOpCodeCounters Counters[EShooterRTOpCode::Max];
+
+	/** Packets with an opcode without handler */
+	TAtomic<int64> UnhandledPackets;
+
+	/**
+	 * Receive time of the packets queued for the game thread, oldest first. The SDK queues packets in the order they pass
+	 * DispatchReceiveThread, so DispatchGameThread pops the time of the packet it gets.
+	 */
+	TQueue<uint64, EQueueMode::Mpsc> ReceiveCycles;
+
+	/** Receive to game thread handler latency, game thread only */
+	int64 NumQueuedPackets;
+	uint64 QueuedCycles;
+	uint64 MaxQueuedCycles;
+};
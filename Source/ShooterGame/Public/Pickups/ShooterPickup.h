@@ -20,6 +20,9 @@ protected:
 	/** initial setup */
 	virtual void BeginPlay() override;
 
+	/** unregisters from the game mode's pickup lists */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	/** FX component */
 	UPROPERTY(VisibleDefaultsOnly, Category=Effects)
@@ -75,6 +78,9 @@ protected:
 	/** show effects when pickup appears */
 	virtual void OnRespawned();
 
+	/** [server] tells the game mode's pickup registry whether we can be picked up */
+	void UpdatePickupRegistry();
+
 	/** blueprint event: pickup disappears */
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnPickedUpEvent();
@@ -0,0 +1,62 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AShooterPickup;
+
+/**
+ * Server side index of the level pickups, owned by the game mode.
+ *
+ * Pickups are bucketed by class and, for ammo, by weapon type. Every bucket is a k-d tree of the (static) pickup locations, so a
+ * nearest pickup query visits O(log n) pickups and does not allocate. Pickups register in BeginPlay, flag themselves
+ * available or taken from OnRespawned / OnPickedUp and unregister in EndPlay, so the registry never holds a destroyed pickup.
+ */
+class SHOOTERGAME_API FShooterPickupRegistry
+{
+public:
+
+	void Add(AShooterPickup* Pickup, bool bIsActive);
+
+	void Remove(const AShooterPickup* Pickup);
+
+	/** Marks the pickup as available (respawned) or taken */
+	void SetActive(AShooterPickup* Pickup, bool bIsActive);
+
+	/**
+	 * Returns the closest available pickup of PickupClass (or a subclass) that passes Predicate, nullptr if there is none.
+	 * For ammo pickups WeaponClass restricts the search to pickups for that weapon class or its subclasses.
+	 */
+	AShooterPickup* FindNearest(const FVector& Origin, UClass* PickupClass, UClass* WeaponClass, TFunctionRef<bool(AShooterPickup*)> Predicate) const;
+
+	int32 Num() const { return PickupLocations.Num(); }
+
+private:
+
+	struct FEntry
+	{
+		FVector Location;
+		AShooterPickup* Pickup;
+		bool bIsActive;
+	};
+
+	struct FBucket
+	{
+		UClass* PickupClass;
+		UClass* WeaponClass;
+
+		/** k-d tree in array form: the median of a range is its node, split on X, Y, Z by depth */
+		TArray<FEntry> Entries;
+	};
+
+	/** Reorders the range into a k-d tree and refreshes PickupLocations for it */
+	void BuildTree(int32 BucketIdx, int32 Begin, int32 End, int32 Depth);
+
+	static void FindNearestInTree(const FBucket& Bucket, int32 Begin, int32 End, int32 Depth, const FVector& Origin, TFunctionRef<bool(AShooterPickup*)> Predicate, AShooterPickup*& BestPickup, float& BestDistSq);
+
+	TArray<FBucket> Buckets;
+
+	/** Bucket and entry of every pickup, for SetActive and Remove */
+	TMap<const AShooterPickup*, FIntPoint> PickupLocations;
+};
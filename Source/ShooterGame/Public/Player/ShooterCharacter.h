@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ShooterTypes.h"
+#include "ShooterHitboxHistory.h"
 #include "ShooterCharacter.generated.h"
 
 class UPawnNoiseEmitterComponent;
@@ -33,6 +34,12 @@ public:
 	/** [server] perform PlayerState related setup */
 	virtual void PossessedBy(class AController* C) override;
 
+	/** [server] local control of sounds ends with the controller */
+	virtual void UnPossessed() override;
+
+	/** [client] update local control of sounds */
+	virtual void OnRep_Controller() override;
+
 	/** [client] perform PlayerState related setup */
 	virtual void OnRep_PlayerState() override;
 
@@ -259,6 +266,9 @@ public:
 
 	/** Update the team color of all player meshes. */
 	void UpdateTeamColorsAllMIDs();
+
+	/** hitbox poses recorded on the server for lag compensated hit validation */
+	const FShooterHitboxHistory& GetHitboxHistory() const { return HitboxHistory; }
 private:
 
 	/** pawn mesh: 1st person view */
@@ -303,6 +313,17 @@ protected:
 	/** when low health effects should start */
 	float LowHealthPercentage;
 
+	/** seconds of hitbox poses kept on the server for lag compensated hit validation */
+	UPROPERTY(EditDefaultsOnly, Category = HitVerification)
+		float HitboxHistorySeconds;
+
+	/** number of poses kept in the hitbox history, bounds its memory */
+	UPROPERTY(EditDefaultsOnly, Category = HitVerification)
+		int32 HitboxHistorySamples;
+
+	/** hitbox poses of the last HitboxHistorySeconds, server only */
+	FShooterHitboxHistory HitboxHistory;
+
 	/** Base turn rate, in deg/sec. Other scaling may affect final turn rate. */
 	float BaseTurnRate;
 
@@ -358,6 +379,25 @@ private:
 	/** Whether or not the character is moving (based on movement input). */
 	bool IsMoving();
 
+	/** [server] stops the character from being found by AI target queries */
+	void RemoveFromCharacterGrid();
+
+	/** records in the local player sound registry whether this pawn is locally controlled */
+	void UpdateLocallyControlledSounds();
+
+	/** [client] update the low health warning */
+	UFUNCTION()
+	void OnRep_Health();
+
+	/** regeneration step, from TimerHandle_HealthRegen */
+	void RegenHealth();
+
+	/** plays the low health warning while health is low, louder as it gets lower */
+	void UpdateLowHealthWarning();
+
+	/** Handle for efficient management of RegenHealth timer */
+	FTimerHandle TimerHandle_HealthRegen;
+
 	//////////////////////////////////////////////////////////////////////////
 	// Damage & death
 
@@ -368,9 +408,15 @@ public:
 		uint32 bIsDying : 1;
 
 	// Current health of the Pawn
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = Health)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, ReplicatedUsing = OnRep_Health, Category = Health)
 		float Health;
 
+	/** health was changed, update regeneration and the low health warning */
+	void OnHealthChanged();
+
+	/** starts or stops regenerating health, depending on the controller's cheat, health and death */
+	void UpdateHealthRegen();
+
 	int32 PickedUpCoinAmount;
 
 	/** Take damage, handle death */
@@ -400,6 +446,10 @@ public:
 
 	/** Called on the actor right before replication occurs */
 	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+
+	/** Builds list of points to check for pausing replication for a connection, used by FShooterPauseRelevancy */
+	void BuildPauseReplicationCheckPoints(TArray<FVector, TInlineAllocator<8>>& RelevancyCheckPoints);
+
 protected:
 	/** notification when killed, for both the server and client. */
 	virtual void OnDeath(float KillingDamage, struct FDamageEvent const& DamageEvent, class APawn* InstigatingPawn, class AActor* DamageCauser);
@@ -444,9 +494,6 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 		void ServerSetTargeting(bool bNewTargeting);
 
-	/** Builds list of points to check for pausing replication for a connection*/
-	void BuildPauseReplicationCheckPoints(TArray<FVector>& RelevancyCheckPoints);
-
 protected:
 	/** Returns Mesh1P subobject **/
 	FORCEINLINE USkeletalMeshComponent* GetMesh1P() const { return Mesh1P; }
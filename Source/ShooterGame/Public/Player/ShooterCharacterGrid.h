@@ -0,0 +1,145 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AShooterCharacter;
+
+/**
+ * Uniform 2D grid of the live characters of a world, used by the AI for target acquisition. Server only, owned by the game mode.
+ *
+ * Characters register when they are initialized, move between cells from their tick and leave when they die or are destroyed.
+ * Queries walk rings of cells outwards from the origin and hand out characters closest first, so a search can stop at the
+ * first acceptable one instead of testing every pawn of the world.
+ */
+class SHOOTERGAME_API FShooterCharacterGrid
+{
+public:
+
+	explicit FShooterCharacterGrid(float InCellSize = 1000.0f);
+
+	void Add(AShooterCharacter* Character);
+	void Remove(AShooterCharacter* Character);
+
+	/** Moves the character to the cell of its current location. Cheap if it did not change cells. */
+	void Update(AShooterCharacter* Character);
+
+	bool Contains(const AShooterCharacter* Character) const { return CharacterCells.Contains(Character); }
+
+	int32 Num() const { return CharacterCells.Num(); }
+
+	/**
+	 * Calls Visitor(Character, DistSq) for every registered character within MaxDistance of Origin, closest first,
+	 * until the visitor returns true. Returns the character the visitor stopped at, or nullptr.
+	 */
+	template<typename VisitorType>
+	AShooterCharacter* VisitByDistance(const FVector& Origin, float MaxDistance, VisitorType Visitor) const;
+
+	/** Fills OutCharacters with up to K characters passing Predicate, closest first */
+	template<typename PredicateType>
+	void FindNearest(const FVector& Origin, int32 K, PredicateType Predicate, TArray<AShooterCharacter*>& OutCharacters) const
+	{
+		OutCharacters.Reset();
+		if (K > 0)
+		{
+			VisitByDistance(Origin, MAX_FLT, [&](AShooterCharacter* Character, float DistSq)
+			{
+				if (Predicate(Character))
+				{
+					OutCharacters.Add(Character);
+				}
+				return OutCharacters.Num() >= K;
+			});
+		}
+	}
+
+private:
+
+	struct FCandidate
+	{
+		AShooterCharacter* Character;
+		float DistSq;
+
+		bool operator<(const FCandidate& Other) const { return DistSq < Other.DistSq; }
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Pushes the characters of one cell within MaxDistSq onto the candidate heap, returns the number of characters in the cell */
+	int32 GatherCell(const FIntPoint& Cell, const FVector& Origin, float MaxDistSq, TArray<FCandidate, TInlineAllocator<32>>& Heap) const;
+
+	float CellSize;
+
+	TMap<FIntPoint, TArray<AShooterCharacter*>> Cells;
+	TMap<const AShooterCharacter*, FIntPoint> CharacterCells;
+
+	/**
+	 * Cells ever occupied lie within these bounds. They never shrink, so a character that strayed far once keeps them wide;
+	 * ring searches stop as soon as they have seen every character instead.
+	 */
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+};
+
+template<typename VisitorType>
+AShooterCharacter* FShooterCharacterGrid::VisitByDistance(const FVector& Origin, float MaxDistance, VisitorType Visitor) const
+{
+	if (CharacterCells.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const float MaxDistSq = MaxDistance < MAX_FLT ? FMath::Square(MaxDistance) : MAX_FLT;
+	const FIntPoint Center = GetCell(Origin);
+	const int32 MaxRing = FMath::Max(
+		FMath::Max(FMath::Abs(MinCell.X - Center.X), FMath::Abs(MaxCell.X - Center.X)),
+		FMath::Max(FMath::Abs(MinCell.Y - Center.Y), FMath::Abs(MaxCell.Y - Center.Y)));
+
+	TArray<FCandidate, TInlineAllocator<32>> Heap;
+	int32 NumSeen = 0;
+	for (int32 Ring = 0; Ring <= MaxRing + 1; ++Ring)
+	{
+		if (Ring <= MaxRing)
+		{
+			if (Ring == 0)
+			{
+				NumSeen += GatherCell(Center, Origin, MaxDistSq, Heap);
+			}
+			else
+			{
+				for (int32 i = -Ring; i <= Ring; ++i)
+				{
+					NumSeen += GatherCell(FIntPoint(Center.X + i, Center.Y - Ring), Origin, MaxDistSq, Heap);
+					NumSeen += GatherCell(FIntPoint(Center.X + i, Center.Y + Ring), Origin, MaxDistSq, Heap);
+				}
+				for (int32 i = -Ring + 1; i <= Ring - 1; ++i)
+				{
+					NumSeen += GatherCell(FIntPoint(Center.X - Ring, Center.Y + i), Origin, MaxDistSq, Heap);
+					NumSeen += GatherCell(FIntPoint(Center.X + Ring, Center.Y + i), Origin, MaxDistSq, Heap);
+				}
+			}
+		}
+
+		// Everything not gathered yet is at least Ring cells away, so closer candidates are final.
+		// Once every character was seen, or after the last ring, the rest is flushed and the search ends.
+		const bool bLastPass = NumSeen >= CharacterCells.Num() || Ring > MaxRing;
+		const float SafeDistSq = bLastPass ? MAX_FLT : FMath::Square(Ring * CellSize);
+		while (Heap.Num() > 0 && Heap.HeapTop().DistSq <= SafeDistSq)
+		{
+			FCandidate Candidate;
+			Heap.HeapPop(Candidate, false);
+			if (Visitor(Candidate.Character, Candidate.DistSq))
+			{
+				return Candidate.Character;
+			}
+		}
+
+		if (bLastPass || (Ring * CellSize > MaxDistance && Heap.Num() == 0))
+		{
+			break;
+		}
+	}
+
+	return nullptr;
+}
@@ -29,4 +29,42 @@ class UShooterCheatManager : public UCheatManager
 
 	UFUNCTION(exec)
 	void SpawnBot();
+
+	/** Times recording and rewinding the hitbox history of NumCharacters copies of the local pawn over Seconds of 60Hz server ticks */
+	UFUNCTION(exec)
+	void BenchmarkHitboxHistory(int32 NumCharacters = 64, float Seconds = 1.0f, int32 Samples = 32);
+
+	/** Times NumBots nearest ammo pickup queries, from random points around the level pickups, against the linear LevelPickups scan */
+	UFUNCTION(exec)
+	void BenchmarkPickupQueries(int32 NumBots = 64, int32 Iterations = 100);
+
+	/** Resolves NumExplosions simultaneous zero damage explosions around the local pawn, one by one and through the explosion batcher */
+	UFUNCTION(exec)
+	void BenchmarkExplosions(int32 NumExplosions = 100, float Radius = 400.0f, float Spread = 1500.0f);
+
+	/** Adds 60 death messages a second between the players of the match to the local HUD for Seconds, read the HUD cost with "stat ShooterHUD" */
+	UFUNCTION(exec)
+	void SaturateKillFeed(float Seconds = 10.0f);
+
+	/** Logs packets, payload bytes and handler time of every RT opcode received so far */
+	UFUNCTION(exec)
+	void DumpRTPackets();
+
+	/** Clears the RT packet counters, e.g. before measuring the receive latency at another frame rate */
+	UFUNCTION(exec)
+	void ResetRTPackets();
+
+private:
+
+	/** Logs the result line of a Benchmark* cheat and echoes it to the console */
+	void ReportBenchmark(const FString& Result);
+
+	/** Adds one SaturateKillFeed message, stops after EndTime */
+	void AddKillFeedMessage(float EndTime);
+
+	/** Handle for efficient management of SaturateKillFeed timer */
+	FTimerHandle TimerHandle_SaturateKillFeed;
+
+	/** Player pair of the next SaturateKillFeed message */
+	int32 KillFeedMessageIndex;
 };
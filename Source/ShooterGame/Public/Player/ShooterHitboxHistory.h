@@ -0,0 +1,69 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USkeletalMeshComponent;
+class UCapsuleComponent;
+
+/**
+ * Server side history of a character's hitbox poses, used to validate client side hits at the time the shooter saw them.
+ *
+ * A pose is the world space capsule of every sphyl body in the mesh's physics asset (or the collision capsule if there is none).
+ * Poses are kept in a fixed size ring stored as structure of arrays, so the memory is bounded by MaxSamples x bodies and
+ * recording never allocates after Init.
+ */
+struct FShooterHitboxHistory
+{
+	FShooterHitboxHistory();
+
+	/** Reads the body capsules from the mesh and allocates the ring. HistorySeconds is spread over MaxSamples samples. */
+	void Init(const USkeletalMeshComponent* Mesh, const UCapsuleComponent* Capsule, float HistorySeconds, int32 MaxSamples);
+
+	/** Stores the current pose. Samples closer than HistorySeconds / MaxSamples to the previous one are skipped. */
+	void Record(const USkeletalMeshComponent* Mesh, const UCapsuleComponent* Capsule, float Time);
+
+	/** Returns true if Point is within Tolerance of a capsule of the pose at Time, interpolated between the closest samples. */
+	bool IsPointNearPose(float Time, const FVector& Point, float Tolerance) const;
+
+	bool HasSamples() const { return NumSamples > 0; }
+
+	/** true once Init found bodies to record, the mesh has to refresh its bones from then on */
+	bool IsEnabled() const { return NumBodies > 0; }
+
+	/** Time of the oldest sample still in the ring */
+	float GetOldestTime() const;
+
+	/** Bytes held by the ring */
+	SIZE_T GetAllocatedSize() const;
+
+	void Reset();
+
+private:
+
+	/** Index of the sample Age samples before the newest one */
+	int32 GetSampleIndex(int32 Age) const { return (Head - Age + MaxSamples) % MaxSamples; }
+
+	/** Per body, constant */
+	TArray<int32> BoneIndices;
+	TArray<FTransform> BodyTransforms;
+	TArray<float> Radii;
+	TArray<float> HalfLengths;
+
+	/** Per sample */
+	TArray<float> SampleTimes;
+
+	/** Per sample and body, indexed [Sample * NumBodies + Body] */
+	TArray<FVector> Centers;
+	TArray<FVector> HalfAxes;
+
+	int32 NumBodies;
+	int32 MaxSamples;
+	int32 NumSamples;
+
+	/** Index of the newest sample */
+	int32 Head;
+
+	float MinSampleInterval;
+};
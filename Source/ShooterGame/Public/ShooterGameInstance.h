@@ -11,6 +11,8 @@
 #include <GameSparksRT/IRTSession.hpp>
 #include "Online/RTSessionInfo.h"
 #include "Online/RTSessionListener.h"
+#include "Online/ShooterRTPacketRouter.h"
+#include "Online/ShooterRTNetworkThread.h"
 #include "Online/RTMatch.h"
 #include "Online/UserProfile.h"
 #include "ShooterGameInstance.generated.h"
@@ -232,6 +234,9 @@ public:
 	TSharedPtr<IRTSession> RTSession;
 	TSharedPtr<IRTSessionListener> RTListener;
 
+	/** Services the connection of RTSession at a fixed rate, null when Tick updates it */
+	TUniquePtr<FShooterRTNetworkThread> RTNetworkThread;
+
 	void CreateNewRTSession();
 	void OnJoinRTSession(const FString& MapPath);
 
@@ -242,12 +247,37 @@ public:
 	void OnChallengeInstanceStart(std::string ChallengeInstanceId);
 	void OnPlayerConnect(int PeerId);
 	void OnPlayerDisconnect(int PeerId);
-	TSharedPtr<RTPlayer> GetRTPlayerFromPeerId(int PeerId);
+	/** Player of the RT session with the peer id, or nullptr. Valid until the player leaves the session. */
+	const RTPlayer* GetRTPlayerFromPeerId(int PeerId) const;
 	void OnPacket(const RTPacket& packet);
+
+	/** Routes RT packets to the OnRT*Packet handlers */
+	FShooterRTPacketRouter& GetRTPacketRouter() { return RTPacketRouter; }
+
+	/** [game thread] team chat line from another player */
+	void OnRTChatPacket(const FShooterRTChatPacket& Packet);
 	
 
 private:
 
+	FShooterRTPacketRouter RTPacketRouter;
+
+	/** Names of players that connected or disconnected since the last system chat message */
+	TArray<FString> PendingConnectNames;
+	TArray<FString> PendingDisconnectNames;
+
+	/** Running while system chat messages are being gathered instead of sent */
+	FTimerHandle TimerHandle_SystemChat;
+
+	/** Adds a player to a pending system chat message, which is sent right away unless one was sent recently */
+	void QueueSystemChatMessage(TArray<FString>& PendingNames, const FString& DisplayName);
+
+	/** Sends the pending system chat messages and keeps gathering for a while if there were any */
+	void FlushSystemChatMessages();
+
+	/** Sends one system chat message naming the players, returns false if there were none */
+	bool SendSystemChatMessage(TArray<FString>& PendingNames, const FString& SingleMessage, const FString& GroupMessage);
+
 	UPROPERTY(config)
 		FString LoginScreenMap;
 
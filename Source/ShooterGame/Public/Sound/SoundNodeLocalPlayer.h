@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Sound/SoundNode.h"
+#include "Templates/Atomic.h"
 #include "SoundNodeLocalPlayer.generated.h"
 
 /**
@@ -22,13 +23,26 @@ class USoundNodeLocalPlayer : public USoundNode
 #endif
 	// End USoundNode interface.
 
-	static TMap<uint32, bool>& GetLocallyControlledActorCache()
-	{
-		check(IsInAudioThread());
-		return LocallyControlledActorCache;
-	}
+	/** [game thread] Records whether the owner of sounds is locally controlled. Call when possession or local control changes. */
+	static void SetLocallyControlled(const UObject* Owner, bool bLocallyControlled);
+
+	/** [game thread] Forgets the owner, from its BeginDestroy */
+	static void ClearLocallyControlled(const UObject* Owner);
+
+	/** [any thread] Wait free lookup by the unique id of the owner, false for owners that were never recorded */
+	static bool IsLocallyControlled(uint32 OwnerID);
 
 private:
 
-	static TMap<uint32, bool> LocallyControlledActorCache;
+	/**
+	 * Locally controlled registry, indexed by object index (the unique id sounds carry as owner id) in chunks that are
+	 * allocated on first use and never freed. Each entry packs the serial number of the object that wrote it above the
+	 * locally controlled bit, so clearing a stale owner can't wipe the entry of a new object reusing the index.
+	 * Only the game thread writes, the audio thread reads single atomics without locks or commands.
+	 */
+	enum { RegistryChunkSize = 16 * 1024, RegistryMaxChunks = 1024 };
+
+	static TAtomic<int64>* GetRegistryEntry(uint32 OwnerID, bool bCreate);
+
+	static TAtomic<TAtomic<int64>*> RegistryChunks[RegistryMaxChunks];
 };
@@ -21,13 +21,61 @@ struct FHitData
 	}
 };
 
+/** HUD text that is only formatted and measured again when the value it shows changes. */
+struct FHUDCachedText
+{
+	/** Value Text was formatted from. */
+	int32 SourceValue;
+
+	/** Formatted text. */
+	FText Text;
+
+	/** Unscaled size of Text, valid while MeasuredFont is the font it is drawn with. */
+	FVector2D Size;
+
+	/** Font Size was measured with, null until measured. */
+	const UFont* MeasuredFont;
+
+	/** Initialise defaults. */
+	FHUDCachedText()
+		: SourceValue(MIN_int32)
+		, Size(0.0f, 0.0f)
+		, MeasuredFont(nullptr)
+	{
+	}
+
+	/** Does Text have to be formatted again to show NewValue? */
+	bool NeedsUpdate(int32 NewValue) const
+	{
+		return SourceValue != NewValue;
+	}
+
+	/** Replaces the text, it is measured again the next time it is drawn. */
+	void Set(int32 NewValue, const FText& NewText)
+	{
+		SourceValue = NewValue;
+		Text = NewText;
+		MeasuredFont = nullptr;
+	}
+};
+
+/** Information string laid out below the centered kill message. */
+struct FHUDInfoItem
+{
+	/** Text item to draw, without position. */
+	FCanvasTextItem TextItem;
+
+	/** Unscaled size of the text. */
+	FVector2D TextSize;
+};
+
 struct FDeathMessage
 {
 	/** Name of player scoring kill. */
-	FString KillerDesc;
+	FHUDCachedText KillerDesc;
 
 	/** Name of killed player. */
-	FString VictimDesc;
+	FHUDCachedText VictimDesc;
 
 	/** Killer is local player. */
 	uint8 bKillerIsOwner : 1;
@@ -242,7 +290,43 @@ protected:
 	FFontRenderInfo ShadowedFont;
 
 	/** Big "KILLED [PLAYER]" message text above the crosshair. */
-	FText CenteredKillMessage;
+	FHUDCachedText CenteredKillMessage;
+
+	/** Match timer, by remaining seconds. */
+	FHUDCachedText TimerText;
+
+	/** Warmup countdown, by remaining seconds. */
+	FHUDCachedText WarmupText;
+
+	/** Player or team position, by position and number of places. */
+	FHUDCachedText PositionText;
+
+	/** Kills label. */
+	FHUDCachedText KillsLabelText;
+
+	/** Kills of the owner, by kills. */
+	FHUDCachedText KillsText;
+
+	/** Ammo in the clip of the current weapon, by ammo. */
+	FHUDCachedText PrimaryClipText;
+
+	/** Spare ammo of the current weapon, by ammo. */
+	FHUDCachedText PrimarySpareText;
+
+	/** Ammo of the secondary weapon, by ammo. */
+	FHUDCachedText SecondaryAmmoText;
+
+	/** Text between killer and victim of death messages without kill icon. */
+	FHUDCachedText KilledText;
+
+	/** Waiting for respawn message. */
+	FHUDCachedText RespawnText;
+
+	/** Out of ammo message. */
+	FHUDCachedText NoAmmoText;
+
+	/** Net mode, session and version, by net mode and whether there is a session. */
+	FHUDCachedText NetModeText;
 
 	/** last time we killed someone. */
 	float LastKillTime;
@@ -283,8 +367,17 @@ protected:
 	/** Runtime data for hit indicator. */
 	FHitData HitNotifyData[8];
 
-	/** Active death messages. */
-	TArray<FDeathMessage> DeathMessages;
+	/** Most death messages shown at once. */
+	static const int32 MaxDeathMessages = 5;
+
+	/** Active death messages, a ring starting at FirstDeathMessage. */
+	FDeathMessage DeathMessages[MaxDeathMessages];
+
+	/** Index of the oldest death message. */
+	int32 FirstDeathMessage;
+
+	/** Number of active death messages. */
+	int32 NumDeathMessages;
 
 	/** State of match. */
 	EShooterMatchState::Type MatchState;
@@ -305,7 +398,10 @@ protected:
 	TSharedPtr<class SChatWidget> ChatWidget;
 
 	/** Array of information strings to render (Waiting to respawn etc) */
-	TArray<FCanvasTextItem> InfoItems;
+	TArray<FHUDInfoItem> InfoItems;
+
+	/** Text drawn this frame, after all icons so the icons of a texture and the glyphs of a font batch together. */
+	TArray<FCanvasTextItem> QueuedTextItems;
 
 	/** Called every time game is started. */
 	virtual void PostInitializeComponents() override;
@@ -350,7 +446,16 @@ protected:
 	float DrawRecentlyKilledPlayer();
 
 	/** Temporary helper for drawing text-in-a-box. */
-	void DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor);
+	void DrawDebugInfoString(FHUDCachedText& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor);
+
+	/** Returns the unscaled size of the text in Font, measuring it only if it changed. */
+	const FVector2D& MeasureText(FHUDCachedText& CachedText, UFont* Font);
+
+	/** Queues a text item to be drawn at X, Y once all icons are drawn. */
+	void QueueTextItem(const FCanvasTextItem& TextItem, float X, float Y);
+
+	/** Draws the queued text items, grouped by font. */
+	void FlushTextItems();
 
 	/** helper for getting uv coords in normalized top,left, bottom, right format */
 	void MakeUV(FCanvasIcon& Icon, FVector2D& UV0, FVector2D& UV1, uint16 U, uint16 V, uint16 UL, uint16 VL);
@@ -365,9 +470,10 @@ protected:
 	/*
 	 * Add information string that will be displayed on the hud. They are added as required and rendered together to prevent overlaps 
 	 * 
-	 * @param InInfoString	InInfoString
+	 * @param InfoItem	Text item to draw, its text is replaced by InfoText
+	 * @param InfoText	Text to show
 	*/
-	void AddMatchInfoString(const FCanvasTextItem InfoItem);
+	void AddMatchInfoString(FCanvasTextItem InfoItem, FHUDCachedText& InfoText);
 
 	/*
 	* Render the info messages.
@@ -0,0 +1,89 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+class AController;
+class UDamageType;
+
+/** Radial damage of one detonation, queued with FShooterExplosionBatcher */
+struct FShooterExplosion
+{
+	FVector Origin;
+	float BaseDamage;
+	float MinimumDamage;
+	float InnerRadius;
+	float OuterRadius;
+	float DamageFalloff;
+	TSubclassOf<UDamageType> DamageTypeClass;
+	ECollisionChannel DamagePreventionChannel;
+
+	/** never damaged by its own explosion */
+	TWeakObjectPtr<AActor> DamageCauser;
+
+	/** actor that already took the point damage of the impact */
+	TWeakObjectPtr<AActor> IgnoreActor;
+
+	TWeakObjectPtr<AController> InstigatedBy;
+};
+
+/**
+ * Server side batcher for projectile radial damage, owned by the game mode.
+ *
+ * Explosions are queued during the frame and resolved after the actors ticked. Overlapping explosions are grouped into clusters
+ * and each cluster runs a single broad phase sphere overlap; every explosion then filters the shared overlaps by its own radius
+ * and traces visibility only to the components it can reach. Scratch containers are kept between frames, so a flush does not
+ * allocate once they warmed up. Set p.ExplosionBatching 0 to resolve explosions as soon as they are queued.
+ */
+class SHOOTERGAME_API FShooterExplosionBatcher
+{
+public:
+
+	FShooterExplosionBatcher(UWorld* InWorld);
+	~FShooterExplosionBatcher();
+
+	void Queue(const FShooterExplosion& Explosion);
+
+	/** Applies the damage of all queued explosions. Returns the number of broad phase overlap queries it took. */
+	int32 Flush();
+
+	int32 NumPending() const { return Pending.Num(); }
+
+private:
+
+	struct FCluster
+	{
+		FSphere Bounds;
+		ECollisionChannel Channel;
+		TArray<int32, TInlineAllocator<16>> Explosions;
+	};
+
+	struct FVictim
+	{
+		int32 ExplosionIdx;
+		AActor* Actor;
+		FHitResult Hit;
+	};
+
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	/** Finds the components of the cluster overlaps the explosion can see and adds one victim per actor */
+	void GatherVictims(const FShooterExplosion& Explosion, int32 ExplosionIdx);
+
+	TWeakObjectPtr<UWorld> World;
+
+	FDelegateHandle PostActorTickHandle;
+
+	TArray<FShooterExplosion> Pending;
+
+	/** explosions of the flush in progress, damage may queue new ones */
+	TArray<FShooterExplosion> Processing;
+
+	TArray<FCluster> Clusters;
+	TArray<FOverlapResult> Overlaps;
+	TArray<FVictim> Victims;
+
+	bool bIsFlushing;
+};
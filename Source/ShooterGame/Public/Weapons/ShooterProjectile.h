@@ -4,6 +4,7 @@
 
 #include "GameFramework/Actor.h"
 #include "ShooterWeapon_Projectile.h"
+#include "Effects/ShooterActorPool.h"
 #include "ShooterProjectile.generated.h"
 
 class UProjectileMovementComponent;
@@ -12,7 +13,7 @@ class UPrimitiveComponent;
 
 // 
 UCLASS(Abstract, Blueprintable)
-class AShooterProjectile : public AActor
+class AShooterProjectile : public AActor, public IShooterPoolableActor
 {
 	GENERATED_UCLASS_BODY()
 
@@ -26,8 +27,16 @@ class AShooterProjectile : public AActor
 	UFUNCTION()
 		void OnImpact(const FHitResult& HitResult);
 
-	void ApplyRadialDamage(const UObject* WorldContextObject, float BaseDamage, const FVector& Origin, float DamageRadius, TSubclassOf<UDamageType> DamageTypeClass, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser, AController* InstigatedByController, bool bDoFullDamage, ECollisionChannel DamagePreventionChannel);
-	void ApplyRadialDamageWithFalloff(const UObject* WorldContextObject, float BaseDamage, float MinimumDamage, const FVector& Origin, float DamageInnerRadius, float DamageOuterRadius, float DamageFalloff, TSubclassOf<class UDamageType> DamageTypeClass, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser, AController* InstigatedByController, ECollisionChannel DamagePreventionChannel);
+	/** back to the pool instead of destroyed, if it can be pooled */
+	virtual void LifeSpanExpired() override;
+
+	/** reset and fire again */
+	virtual void OnAcquiredFromPool() override;
+
+	virtual void OnReleasedToPool() override;
+
+	static void ApplyRadialDamage(const UObject* WorldContextObject, float BaseDamage, const FVector& Origin, float DamageRadius, TSubclassOf<UDamageType> DamageTypeClass, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser, AController* InstigatedByController, bool bDoFullDamage, ECollisionChannel DamagePreventionChannel);
+	static void ApplyRadialDamageWithFalloff(const UObject* WorldContextObject, float BaseDamage, float MinimumDamage, const FVector& Origin, float DamageInnerRadius, float DamageOuterRadius, float DamageFalloff, TSubclassOf<class UDamageType> DamageTypeClass, const TArray<AActor*>& IgnoreActors, AActor* DamageCauser, AController* InstigatedByController, ECollisionChannel DamagePreventionChannel);
 
 private:
 	/** movement component */
@@ -75,6 +84,9 @@ protected:
 	/** trigger explosion */
 	void Explode(const FHitResult& Impact);
 
+	/** setup from weapon config and instigator, on spawn and reuse */
+	void InitProjectile();
+
 	/** explode after timer */
 	UFUNCTION()
 		void ExplodeThenDie();
@@ -4,6 +4,7 @@
 
 #include "GameFramework/Actor.h"
 #include "Engine/Canvas.h" // for FCanvasIcon
+#include "Weapons/ShooterWeaponTraces.h"
 #include "ShooterWeapon.generated.h"
 
 class UAnimMontage;
@@ -542,6 +543,12 @@ protected:
 	/** find hit */
 	FHitResult WeaponTrace(const FVector& TraceFrom, const FVector& TraceTo) const;
 
+	/** find hit with an async trace within the weapon trace budget, Callback gets the hit next frame */
+	void AsyncWeaponTrace(const FVector& TraceFrom, const FVector& TraceTo, EShooterTracePriority::Type Priority, const FOnWeaponTraceDone& Callback) const;
+
+	/** query params of weapon traces */
+	FCollisionQueryParams GetWeaponTraceParams() const;
+
 protected:
 	/** Returns Mesh1P subobject **/
 	FORCEINLINE USkeletalMeshComponent* GetMesh1P() const { return Mesh1P; }
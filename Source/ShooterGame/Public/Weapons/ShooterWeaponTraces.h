@@ -0,0 +1,74 @@
+// Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+namespace EShooterTracePriority
+{
+	enum Type
+	{
+		/** decides hits and damage: always traced, never dropped */
+		Gameplay,
+		/** impact and trail effects: traced within the frame budget, deferred and eventually dropped beyond it */
+		Cosmetic,
+	};
+}
+
+DECLARE_DELEGATE_OneParam(FOnWeaponTraceDone, const FHitResult&);
+
+/**
+ * Per world queue of weapon line traces, owned by the game state.
+ *
+ * Traces run as async scene queries and their results are handed back at the start of the next frame. Every frame (from one
+ * post actor tick to the next) gameplay traces are issued right away, cosmetic ones only while fewer than p.WeaponTraceBudget
+ * traces were issued; the rest waits for the next frames and is dropped after p.WeaponTraceMaxDeferFrames.
+ * Set p.WeaponTraceAsync 0 to trace synchronously, as before.
+ */
+class SHOOTERGAME_API FShooterWeaponTraces : public TSharedFromThis<FShooterWeaponTraces>
+{
+public:
+
+	FShooterWeaponTraces(UWorld* InWorld);
+	~FShooterWeaponTraces();
+
+	/** Traces the weapon channel from Start to End. Callback may not be called at all for cosmetic traces. */
+	void RequestTrace(const FVector& Start, const FVector& End, const FCollisionQueryParams& Params, EShooterTracePriority::Type Priority, const FOnWeaponTraceDone& Callback);
+
+	int32 NumDeferred() const { return Deferred.Num(); }
+
+private:
+
+	struct FDeferredTrace
+	{
+		FVector Start;
+		FVector End;
+		FCollisionQueryParams Params;
+		FOnWeaponTraceDone Callback;
+		uint64 RequestFrame;
+	};
+
+	void IssueTrace(const FVector& Start, const FVector& End, const FCollisionQueryParams& Params, const FOnWeaponTraceDone& Callback);
+
+	void OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** starts the budget of the next frame with the deferred traces */
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	TWeakObjectPtr<UWorld> World;
+
+	FDelegateHandle PostActorTickHandle;
+
+	FTraceDelegate TraceDelegate;
+
+	/** callbacks of the async traces in flight, by user data of the trace */
+	TMap<uint32, FOnWeaponTraceDone> InFlight;
+
+	uint32 NextRequestId;
+
+	/** cosmetic traces over budget, oldest first */
+	TArray<FDeferredTrace> Deferred;
+
+	int32 NumIssuedThisFrame;
+};
@@ -63,6 +63,14 @@ struct FInstantWeaponData
 	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
 	float AllowedViewDotHitDir;
 
+	/** hit verification: distance a hit on a character may be off its rewound hitboxes */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float HitboxRewindTolerance;
+
+	/** hit verification: max seconds a character is rewound to the shooter's view, regardless of ping */
+	UPROPERTY(EditDefaultsOnly, Category=HitVerification)
+	float MaxHitboxRewindTime;
+
 	/** defaults */
 	FInstantWeaponData()
 	{
@@ -75,6 +83,8 @@ struct FInstantWeaponData
 		DamageType = UDamageType::StaticClass();
 		ClientSideHitLeeway = 200.0f;
 		AllowedViewDotHitDir = 0.8f;
+		HitboxRewindTolerance = 15.0f;
+		MaxHitboxRewindTime = 0.5f;
 	}
 };
 
@@ -126,6 +136,9 @@ protected:
 	/** process the instant hit and notify the server if necessary */
 	void ProcessInstantHit(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
 
+	/** [server] check a client side hit on a character against its hitboxes at the time the shooter saw it */
+	bool IsHitInHitboxHistory(const AShooterCharacter* HitCharacter, const FHitResult& Impact) const;
+
 	/** continue processing the instant hit, as if it has been confirmed by the server */
 	void ProcessInstantHit_Confirmed(const FHitResult& Impact, const FVector& Origin, const FVector& ShootDir, int32 RandomSeed, float ReticleSpread);
 
@@ -138,6 +151,9 @@ protected:
 	/** [local] weapon specific fire implementation */
 	virtual void FireWeapon() override;
 
+	/** [local] the trace of a shot is back */
+	void OnFireTraceDone(const FHitResult& Impact, FVector Origin, FVector ShootDir, int32 RandomSeed, float ReticleSpread);
+
 	/** [local + server] update spread on firing */
 	virtual void OnBurstFinished() override;
 
@@ -151,9 +167,15 @@ protected:
 	/** called in network play to do the cosmetic fx  */
 	void SimulateInstantHit(const FVector& Origin, int32 RandomSeed, float ReticleSpread);
 
+	/** the trace of a simulated shot is back */
+	void OnSimulatedTraceDone(const FHitResult& Impact, FVector EndTrace);
+
 	/** spawn effects for impact */
 	void SpawnImpactEffects(const FHitResult& Impact);
 
+	/** spawn the impact effect actor for the surface found at the impact */
+	void SpawnImpactEffect(const FHitResult& SurfaceHit, FHitResult Impact);
+
 	/** spawn trail effect */
 	void SpawnTrailEffect(const FVector& EndPoint);
 };